@@ -0,0 +1,216 @@
+// Times the SSA construction on large synthetic functions.
+//
+// Each function is a random nest of assignments, ifs, and while loops over a
+// fixed set of slots, lowered the way `IrBuilder` lowers them. The seed is
+// fixed, so every run measures the same functions.
+//
+// Usage: ssa_bench [<number of statements>...]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ir/IrControlFlowGraph.hpp"
+#include "ir/IrDominatorTree.hpp"
+#include "ir/IrFunction.hpp"
+#include "ir/IrSsaConstructor.hpp"
+#include "ir/IrSsaVerifier.hpp"
+
+namespace {
+constexpr int kNumParameters = 4;
+constexpr int kNumSlots = 32;
+constexpr int kMaxDepth = 6;
+constexpr unsigned kSeed = 20240521;
+
+class FunctionGenerator {
+  private:
+    IrFunction &m_function;
+    IrBasicBlock *m_block;
+    std::mt19937 m_random{kSeed};
+    int m_remaining;
+
+  public:
+    FunctionGenerator(IrFunction &p_function, const int p_num_statements)
+        : m_function(p_function), m_remaining(p_num_statements) {
+        for (int i = 0; i < kNumSlots; ++i) {
+            const IrSlot slot{"v" + std::to_string(i), IrType::kInt};
+            if (i < kNumParameters) {
+                m_function.addParameter(slot);
+            } else {
+                m_function.addSlot(slot);
+            }
+        }
+        m_block = m_function.newBlock();
+    }
+
+    void generate() {
+        while (m_remaining > 0) {
+            generateStatements(0);
+        }
+        m_block->append(IrInstruction{IrOpcode::kRet});
+    }
+
+  private:
+    int pick(const int p_bound) {
+        return std::uniform_int_distribution<int>(0, p_bound - 1)(m_random);
+    }
+
+    IrOperand appendWithResult(const IrOpcode p_opcode, const IrType p_type,
+                               std::vector<IrOperand> p_operands) {
+        IrInstruction instruction{p_opcode, p_type};
+        instruction.dst = m_function.newTemp(p_type);
+        instruction.operands = std::move(p_operands);
+        m_block->append(std::move(instruction));
+        return IrOperand::temp(m_block->getInstructions().back().dst);
+    }
+
+    IrOperand loadRandomSlot() {
+        return appendWithResult(IrOpcode::kLoad, IrType::kInt,
+                                {IrOperand::slot(pick(kNumSlots))});
+    }
+
+    void jumpTo(const IrBasicBlock &p_target) {
+        IrInstruction jump{IrOpcode::kJmp};
+        jump.targets = {p_target.getId()};
+        m_block->append(std::move(jump));
+    }
+
+    void branchOnRandomCondition(const IrBasicBlock &p_true,
+                                 const IrBasicBlock &p_false) {
+        const auto lhs = loadRandomSlot();
+        const auto condition = appendWithResult(
+            IrOpcode::kLt, IrType::kBool,
+            {lhs, IrOperand::immediate(pick(100))});
+        IrInstruction branch{IrOpcode::kBr};
+        branch.operands = {condition};
+        branch.targets = {p_true.getId(), p_false.getId()};
+        m_block->append(std::move(branch));
+    }
+
+    void generateAssignment() {
+        static const IrOpcode kOpcodes[] = {IrOpcode::kAdd, IrOpcode::kSub,
+                                            IrOpcode::kMul};
+        const auto lhs = loadRandomSlot();
+        const auto rhs =
+            pick(2) ? loadRandomSlot() : IrOperand::immediate(pick(10));
+        const auto value =
+            appendWithResult(kOpcodes[pick(3)], IrType::kInt, {lhs, rhs});
+        IrInstruction store{IrOpcode::kStore};
+        store.operands = {
+            IrOperand::slot(kNumParameters + pick(kNumSlots - kNumParameters)),
+            value};
+        m_block->append(std::move(store));
+    }
+
+    void generateIf(const int p_depth) {
+        auto *body = m_function.newBlock();
+        auto *else_body = pick(2) ? m_function.newBlock() : nullptr;
+        auto *join = m_function.newBlock();
+        branchOnRandomCondition(*body, else_body ? *else_body : *join);
+
+        m_block = body;
+        generateStatements(p_depth + 1);
+        jumpTo(*join);
+        if (else_body) {
+            m_block = else_body;
+            generateStatements(p_depth + 1);
+            jumpTo(*join);
+        }
+        m_block = join;
+    }
+
+    void generateWhile(const int p_depth) {
+        auto *condition = m_function.newBlock();
+        auto *body = m_function.newBlock();
+        auto *exit = m_function.newBlock();
+        jumpTo(*condition);
+        m_block = condition;
+        branchOnRandomCondition(*body, *exit);
+
+        m_block = body;
+        generateStatements(p_depth + 1);
+        jumpTo(*condition);
+        m_block = exit;
+    }
+
+    void generateStatements(const int p_depth) {
+        const int count = 1 + pick(8);
+        for (int i = 0; i < count && m_remaining > 0; ++i) {
+            --m_remaining;
+            const int kind = (p_depth < kMaxDepth) ? pick(10) : 9;
+            if (kind == 0) {
+                generateWhile(p_depth);
+            } else if (kind <= 2) {
+                generateIf(p_depth);
+            } else {
+                generateAssignment();
+            }
+        }
+    }
+};
+
+double getMilliseconds(const std::chrono::steady_clock::time_point p_start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - p_start)
+        .count();
+}
+
+std::size_t countInstructions(const IrFunction &p_function) {
+    std::size_t count = 0;
+    for (const auto &block : p_function.getBlocks()) {
+        count += block->getInstructions().size();
+    }
+    return count;
+}
+}  // namespace
+
+int main(int argc, const char *argv[]) {
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::atoi(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {1000, 10000, 100000};
+    }
+
+    printf("%10s %8s %10s %8s %10s %10s %10s\n", "statements", "blocks",
+           "insts", "phis", "cfg+dom ms", "ssa ms", "verify ms");
+    for (const int size : sizes) {
+        IrFunction function("bench", IrType::kVoid);
+        FunctionGenerator(function, size).generate();
+        const std::size_t num_blocks = function.getBlocks().size();
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            const IrControlFlowGraph cfg(function);
+            const IrDominatorTree dom_tree(cfg);
+        }
+        const double analysis_time = getMilliseconds(start);
+
+        IrSsaConstructor ssa_constructor;
+        start = std::chrono::steady_clock::now();
+        ssa_constructor.run(function);
+        const double ssa_time = getMilliseconds(start);
+
+        start = std::chrono::steady_clock::now();
+        const auto errors = IrSsaVerifier::verify(function);
+        const double verify_time = getMilliseconds(start);
+        for (const auto &error : errors) {
+            fprintf(stderr, "%s\n", error.c_str());
+        }
+
+        printf("%10d %8zu %10zu %8zu %10.2f %10.2f %10.2f\n", size, num_blocks,
+               countInstructions(function),
+               ssa_constructor.getStatistics().num_phis, analysis_time,
+               ssa_time, verify_time);
+        if (!errors.empty()) {
+            return 1;
+        }
+    }
+    return 0;
+}
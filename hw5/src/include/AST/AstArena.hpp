@@ -0,0 +1,101 @@
+#ifndef AST_AST_ARENA_H
+#define AST_AST_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// @brief A bump allocator that holds the storage of all AST nodes of a
+/// compilation, and of everything they own.
+///
+/// `AstNode::operator new` and `Constant::operator new` allocate from the
+/// current arena, as do the names of the nodes and the vectors of their
+/// children, through `AstAllocator`; none of them gives anything back. The
+/// tree is never destroyed: freeing the chunks with the arena is the whole
+/// teardown.
+///
+/// An arena is not thread-safe. Whatever the nodes cache is built when they
+/// are, since the functions are analyzed and generated in parallel.
+class AstArena {
+  private:
+    static constexpr std::size_t kChunkSize = 64 * 1024;
+    /// @note One per thread, so that threads can build ASTs at the same time.
+    static thread_local AstArena *s_current;
+
+    std::vector<std::unique_ptr<char[]>> m_chunks;
+    char *m_cursor = nullptr;
+    char *m_end = nullptr;
+
+    std::size_t m_num_allocations = 0;
+    std::size_t m_num_bytes_allocated = 0;
+    std::size_t m_num_bytes_reserved = 0;
+
+  public:
+    ~AstArena();
+    AstArena() = default;
+
+    AstArena(const AstArena &) = delete;
+    AstArena &operator=(const AstArena &) = delete;
+
+    /// @return Storage of `p_size` bytes aligned for any scalar type.
+    void *allocate(std::size_t p_size);
+
+    std::size_t getNumAllocations() const { return m_num_allocations; }
+    /// @brief The bytes handed out, including the alignment padding.
+    std::size_t getNumBytesAllocated() const { return m_num_bytes_allocated; }
+    /// @brief The bytes of all chunks.
+    std::size_t getNumBytesReserved() const { return m_num_bytes_reserved; }
+    std::size_t getNumChunks() const { return m_chunks.size(); }
+
+    /// @brief The arena the nodes of the calling thread are allocated from;
+    /// `nullptr` if none.
+    static AstArena *getCurrent() { return s_current; }
+    /// @return The current arena. Aborts if there is none, since the storage
+    /// taken from it is never freed on its own.
+    static AstArena &getCurrentOrAbort();
+    /// @note An arena stops being the current one when it is destroyed.
+    static void setCurrent(AstArena *p_arena) { s_current = p_arena; }
+};
+
+/// @brief Hands out storage from the arena that is current when it is made;
+/// deallocating gives nothing back.
+template <typename T>
+class AstAllocator {
+  private:
+    template <typename U>
+    friend class AstAllocator;
+
+    AstArena *m_arena;
+
+  public:
+    using value_type = T;
+
+    /// @pre An arena is current.
+    AstAllocator() : m_arena(&AstArena::getCurrentOrAbort()) {}
+    template <typename U>
+    AstAllocator(const AstAllocator<U> &p_other) : m_arena(p_other.m_arena) {}
+
+    T *allocate(const std::size_t p_num) {
+        return static_cast<T *>(m_arena->allocate(p_num * sizeof(T)));
+    }
+    void deallocate(T *, std::size_t) noexcept {}
+
+    template <typename U>
+    bool operator==(const AstAllocator<U> &p_other) const {
+        return m_arena == p_other.m_arena;
+    }
+    template <typename U>
+    bool operator!=(const AstAllocator<U> &p_other) const {
+        return m_arena != p_other.m_arena;
+    }
+};
+
+/// @brief The vectors of the children of a node.
+template <typename T>
+using AstVector = std::vector<T, AstAllocator<T>>;
+/// @brief The names of the nodes.
+using AstString =
+    std::basic_string<char, std::char_traits<char>, AstAllocator<char>>;
+
+#endif
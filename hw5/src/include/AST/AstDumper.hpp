@@ -5,14 +5,18 @@
 #include "visitor/AstNodeVisitor.hpp"
 
 #include <cstdint>
+#include <cstdio>
 
 class AstDumper final : public AstNodeVisitor {
   private:
     Indenter m_indenter{' ', 2};
+    std::FILE *m_file = stdout;
 
   public:
     ~AstDumper() = default;
     AstDumper() = default;
+    /// @param p_file Has to stay open throughout the dump.
+    explicit AstDumper(std::FILE *p_file) : m_file(p_file) {}
 
     void visit(ProgramNode &p_program) override;
     void visit(DeclNode &p_decl) override;
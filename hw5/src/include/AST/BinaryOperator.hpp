@@ -30,6 +30,14 @@ class BinaryOperatorNode final : public ExpressionNode {
     const ExpressionNode &getLeftOperand() const { return *m_left_operand.get(); }
     const ExpressionNode &getRightOperand() const { return *m_right_operand.get(); }
 
+    /// @brief For the passes that replace the operands.
+    std::unique_ptr<ExpressionNode> &getLeftOperandPtr() {
+        return m_left_operand;
+    }
+    std::unique_ptr<ExpressionNode> &getRightOperandPtr() {
+        return m_right_operand;
+    }
+
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
 };
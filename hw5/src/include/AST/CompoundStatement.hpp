@@ -1,16 +1,16 @@
 #ifndef AST_COMPOUND_STATEMENT_NODE_H
 #define AST_COMPOUND_STATEMENT_NODE_H
 
+#include "AST/AstArena.hpp"
 #include "AST/ast.hpp"
 #include "AST/decl.hpp"
 
-#include <vector>
 #include <memory>
 
 class CompoundStatementNode final : public AstNode {
   public:
-    using DeclNodes = std::vector<std::unique_ptr<DeclNode>>;
-    using StmtNodes = std::vector<std::unique_ptr<AstNode>>;
+    using DeclNodes = AstVector<std::unique_ptr<DeclNode>>;
+    using StmtNodes = AstVector<std::unique_ptr<AstNode>>;
 
   private:
     DeclNodes m_decl_nodes;
@@ -23,6 +23,11 @@ class CompoundStatementNode final : public AstNode {
         : AstNode{line, col}, m_decl_nodes(std::move(p_decl_nodes)),
           m_stmt_nodes(std::move(p_stmt_nodes)){}
 
+    const DeclNodes &getDeclNodes() const { return m_decl_nodes; }
+    DeclNodes &getDeclNodes() { return m_decl_nodes; }
+    const StmtNodes &getStmtNodes() const { return m_stmt_nodes; }
+    StmtNodes &getStmtNodes() { return m_stmt_nodes; }
+
     void accept(AstNodeVisitor &p_visitor) override {
         p_visitor.visit(*this);
     }
@@ -1,19 +1,18 @@
 #ifndef AST_FUNCTION_INVOCATION_NODE_H
 #define AST_FUNCTION_INVOCATION_NODE_H
 
+#include "AST/AstArena.hpp"
 #include "AST/expression.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
 #include <memory>
-#include <string>
-#include <vector>
 
 class FunctionInvocationNode final : public ExpressionNode {
   public:
-    using ExprNodes = std::vector<std::unique_ptr<ExpressionNode>>;
+    using ExprNodes = AstVector<std::unique_ptr<ExpressionNode>>;
 
   private:
-    std::string m_name;
+    AstString m_name;
     ExprNodes m_args;
 
   public:
@@ -22,10 +21,11 @@ class FunctionInvocationNode final : public ExpressionNode {
                            const char *const p_name, ExprNodes &p_args)
         : ExpressionNode{line, col}, m_name(p_name), m_args(std::move(p_args)){}
 
-    const std::string &getName() const { return m_name; }
+    const AstString &getName() const { return m_name; }
     const char *getNameCString() const { return m_name.c_str(); }
 
     const ExprNodes &getArguments() const { return m_args; }
+    ExprNodes &getArguments() { return m_args; }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
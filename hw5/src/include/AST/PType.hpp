@@ -1,16 +1,15 @@
 #ifndef AST_P_TYPE_H
 #define AST_P_TYPE_H
 
+#include <cstddef>
 #include <cstdint>
-#include <memory>
 #include <string>
-#include <utility>
 #include <vector>
 
-class PType;
-
-using PTypeSharedPtr = std::shared_ptr<PType>;
+class PTypeContext;
 
+/// @brief A type of P. Each distinct type exists once in its `PTypeContext`,
+/// so two types are the same if and only if their addresses are.
 class PType {
   public:
     enum class PrimitiveTypeEnum : uint8_t {
@@ -26,23 +25,30 @@ class PType {
   private:
     PrimitiveTypeEnum m_type;
     std::vector<uint64_t> m_dimensions;
-    mutable std::string m_type_string;
-    mutable bool m_type_string_is_valid = false;
+    std::string m_type_string;
+    /// @brief The type after the first n subscripts, for n from 0 to the
+    /// number of dimensions.
+    std::vector<const PType *> m_element_types;
+
+    friend class PTypeContext;
+    PType(PrimitiveTypeEnum p_type, const std::vector<uint64_t> &p_dimensions);
 
   public:
     ~PType() = default;
-    PType(const PrimitiveTypeEnum type) : m_type(type) {}
 
-    void setDimensions(std::vector<uint64_t> &p_dims) {
-        m_dimensions = std::move(p_dims);
-    }
+    PType(const PType &) = delete;
+    PType &operator=(const PType &) = delete;
 
     PrimitiveTypeEnum getPrimitiveType() const { return m_type; }
-    const char *getPTypeCString() const;
+    const char *getPTypeCString() const { return m_type_string.c_str(); }
 
     const std::vector<uint64_t> &getDimensions() const { return m_dimensions; }
 
-    PType *getStructElementType(const std::size_t nth) const;
+    /// @return The type after `nth` subscripts; `nullptr` if there are not
+    /// that many dimensions.
+    const PType *getStructElementType(const std::size_t nth) const {
+        return nth < m_element_types.size() ? m_element_types[nth] : nullptr;
+    }
 
     bool isPrimitiveInteger() const {
         return m_type == PrimitiveTypeEnum::kIntegerType;
@@ -77,7 +83,10 @@ class PType {
 
     /// @return Whether `this` type can be coerced to `p_type`.
     /// @note The other way around is not necessarily true.
-    bool canCoerceTo(const PType *p_type) const;
+    bool canCoerceTo(const PType *p_type) const {
+        // Otherwise only integer can be coerced to real.
+        return this == p_type || (isInteger() && p_type->isReal());
+    }
 };
 
 #endif
@@ -0,0 +1,49 @@
+#ifndef AST_P_TYPE_CONTEXT_H
+#define AST_P_TYPE_CONTEXT_H
+
+#include "AST/PType.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @brief Owns the types of a compilation and interns them: each distinct
+/// primitive type and dimensions pair is created once.
+///
+/// @note The types live as long as the context.
+class PTypeContext {
+  private:
+    using Key = std::pair<PType::PrimitiveTypeEnum, std::vector<uint64_t>>;
+    struct KeyHash {
+        std::size_t operator()(const Key &p_key) const;
+    };
+
+    static constexpr std::size_t kNumPrimitiveTypes =
+        static_cast<std::size_t>(PType::PrimitiveTypeEnum::kErrorType) + 1;
+
+    std::unique_ptr<PType> m_scalar_types[kNumPrimitiveTypes];
+    std::unordered_map<Key, std::unique_ptr<PType>, KeyHash> m_array_types;
+
+  public:
+    ~PTypeContext() = default;
+    PTypeContext();
+
+    PTypeContext(const PTypeContext &) = delete;
+    PTypeContext &operator=(const PTypeContext &) = delete;
+
+    /// @return The type without dimensions.
+    const PType *getType(const PType::PrimitiveTypeEnum p_type) const {
+        return m_scalar_types[static_cast<std::size_t>(p_type)].get();
+    }
+    const PType *getType(PType::PrimitiveTypeEnum p_type,
+                         const std::vector<uint64_t> &p_dimensions);
+
+    std::size_t getNumTypes() const {
+        return kNumPrimitiveTypes + m_array_types.size();
+    }
+};
+
+#endif
@@ -1,20 +1,23 @@
 #ifndef AST_VARIABLE_REFERENCE_NODE_H
 #define AST_VARIABLE_REFERENCE_NODE_H
 
+#include "AST/AstArena.hpp"
 #include "AST/expression.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
 #include <memory>
-#include <string>
-#include <vector>
+
+class SymbolEntry;
 
 class VariableReferenceNode final : public ExpressionNode {
   public:
-    using ExprNodes = std::vector<std::unique_ptr<ExpressionNode>>;
+    using ExprNodes = AstVector<std::unique_ptr<ExpressionNode>>;
 
   private:
-    std::string m_name;
+    AstString m_name;
     ExprNodes m_indices;
+    /// @brief The entry the name resolves to; set by the semantic analyzer.
+    const SymbolEntry *m_symbol_entry = nullptr;
 
   public:
     ~VariableReferenceNode() = default;
@@ -30,10 +33,17 @@ class VariableReferenceNode final : public ExpressionNode {
         : ExpressionNode{line, col}, m_name(p_name),
           m_indices(std::move(p_indices)){}
 
-    const std::string &getName() const { return m_name; }
+    const AstString &getName() const { return m_name; }
     const char *getNameCString() const { return m_name.c_str(); }
 
     const ExprNodes &getIndices() const { return m_indices; }
+    ExprNodes &getIndices() { return m_indices; }
+
+    /// @return `nullptr` if the reference is erroneous.
+    const SymbolEntry *getSymbolEntry() const { return m_symbol_entry; }
+    void setSymbolEntry(const SymbolEntry *p_entry) {
+        m_symbol_entry = p_entry;
+    }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
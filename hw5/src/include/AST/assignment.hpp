@@ -19,7 +19,10 @@ class AssignmentNode final : public AstNode {
         : AstNode{line, col}, m_lvalue(p_var_ref), m_expr(p_expr){}
 
     const VariableReferenceNode &getLvalue() const { return *m_lvalue.get(); }
+    VariableReferenceNode &getLvalue() { return *m_lvalue.get(); }
     const ExpressionNode &getExpr() const { return *m_expr.get(); }
+    /// @brief For the passes that replace the expression.
+    std::unique_ptr<ExpressionNode> &getExprPtr() { return m_expr; }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
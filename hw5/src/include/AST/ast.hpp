@@ -1,6 +1,7 @@
 #ifndef AST_AST_NODE_H
 #define AST_AST_NODE_H
 
+#include <cstddef>
 #include <cstdint>
 
 class AstNodeVisitor;
@@ -26,6 +27,12 @@ class AstNode {
     AstNode &operator=(const AstNode &) = delete;
     AstNode &operator=(AstNode &&) = delete;
 
+    /// @brief Nodes live in the current `AstArena`.
+    /// @pre An arena is current; aborts otherwise.
+    static void *operator new(std::size_t p_size);
+    /// @brief The arena owns the storage; deleting a node only destroys it.
+    static void operator delete(void *) noexcept {}
+
     const Location &getLocation() const;
 
     virtual void accept(AstNodeVisitor &p_visitor) = 0;
@@ -1,10 +1,11 @@
 #ifndef AST_CONSTANT_H
 #define AST_CONSTANT_H
 
+#include "AST/AstArena.hpp"
 #include "AST/PType.hpp"
 
+#include <cstddef>
 #include <cstdint>
-#include <cstdlib>
 
 class Constant {
   public:
@@ -16,26 +17,33 @@ class Constant {
     };
 
   private:
-    PTypeSharedPtr m_type;
+    const PType *m_type;
     ConstantValue m_value;
-    mutable std::string m_constant_value_string;
-    mutable bool m_constant_value_string_is_valid = false;
+    /// @brief Built by the constructor (see `AstArena`); holds the text of a
+    /// string constant.
+    AstString m_constant_value_string;
 
   public:
-    ~Constant() {
-        if (m_type->getPrimitiveType() ==
-            PType::PrimitiveTypeEnum::kStringType) {
-            free(m_value.string);
-        }
+    ~Constant() = default;
+    /// @param value The text of a string constant is copied; the caller
+    /// keeps it.
+    Constant(const PType *const p_type, const ConstantValue value);
+
+    /// @brief Constants live in the current `AstArena`, like the nodes that
+    /// own them.
+    /// @pre An arena is current; aborts otherwise.
+    static void *operator new(std::size_t p_size);
+    /// @brief The arena owns the storage; deleting a constant only destroys
+    /// it.
+    static void operator delete(void *) noexcept {}
+
+    const PType *getTypePtr() const { return m_type; }
+    const char *getConstantValueCString() const {
+        return m_constant_value_string.c_str();
     }
-    Constant(const PTypeSharedPtr &p_type, const ConstantValue value)
-        : m_type(p_type), m_value(value) {}
-
-    const PType *getTypePtr() const { return m_type.get(); }
-    const PTypeSharedPtr &getTypeSharedPtr() const { return m_type; }
-    const char *getConstantValueCString() const;
 
     decltype(m_value.integer) integer() const { return m_value.integer; }
+    decltype(m_value.boolean) boolean() const { return m_value.boolean; }
 };
 
 #endif
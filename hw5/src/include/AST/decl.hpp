@@ -1,6 +1,7 @@
 #ifndef AST_DECL_NODE_H
 #define AST_DECL_NODE_H
 
+#include "AST/AstArena.hpp"
 #include "AST/ast.hpp"
 #include "AST/utils.hpp"
 #include "AST/variable.hpp"
@@ -11,14 +12,14 @@
 
 class DeclNode final : public AstNode {
   public:
-    using VarNodes = std::vector<std::unique_ptr<VariableNode>>;
+    using VarNodes = AstVector<std::unique_ptr<VariableNode>>;
 
   private:
     VarNodes m_var_nodes;
 
   private:
     void init(const std::vector<IdInfo> *const p_ids,
-              const PTypeSharedPtr &p_type,
+              const PType *p_type,
               ConstantValueNode *const p_constant);
 
   public:
@@ -26,9 +27,9 @@ class DeclNode final : public AstNode {
 
     // variable declaration
     DeclNode(const uint32_t line, const uint32_t col,
-             const std::vector<IdInfo> *const p_ids, PType *p_type)
+             const std::vector<IdInfo> *const p_ids, const PType *p_type)
         : AstNode{line, col} {
-        init(p_ids, PTypeSharedPtr{p_type}, nullptr);
+        init(p_ids, p_type, nullptr);
     }
 
     // constant variable declaration
@@ -36,10 +37,11 @@ class DeclNode final : public AstNode {
              const std::vector<IdInfo> *const p_ids,
              ConstantValueNode *const p_constant)
         : AstNode{line, col} {
-        init(p_ids, p_constant->getTypeSharedPtr(), p_constant);
+        init(p_ids, p_constant->getTypePtr(), p_constant);
     }
 
-    const VarNodes &getVariables() { return m_var_nodes; }
+    const VarNodes &getVariables() const { return m_var_nodes; }
+    VarNodes &getVariables() { return m_var_nodes; }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
@@ -4,20 +4,18 @@
 #include "AST/ast.hpp"
 #include "AST/PType.hpp"
 
-#include <memory>
-
 class ExpressionNode : public AstNode {
   protected:
     // for carrying type of result of an expression
-      std::unique_ptr<PType> m_type;
+      const PType *m_type = nullptr;
 
   public:
     ~ExpressionNode() = default;
     ExpressionNode(const uint32_t line, const uint32_t col)
         : AstNode{line, col} {}
 
-    const PType *getInferredType() const { return m_type.get(); }
-    void setInferredType(PType *p_type) { m_type.reset(p_type); }
+    const PType *getInferredType() const { return m_type; }
+    void setInferredType(const PType *p_type) { m_type = p_type; }
 };
 
 #endif
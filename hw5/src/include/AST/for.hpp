@@ -34,6 +34,7 @@ class ForNode final : public AstNode {
         return *m_end_condition.get();
     }
     const CompoundStatementNode &getBody() const { return *m_body.get(); }
+    CompoundStatementNode &getBody() { return *m_body.get(); }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
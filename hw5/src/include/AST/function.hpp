@@ -1,46 +1,54 @@
 #ifndef AST_FUNCTION_NODE_H
 #define AST_FUNCTION_NODE_H
 
+#include "AST/AstArena.hpp"
 #include "AST/CompoundStatement.hpp"
 #include "AST/ast.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
 #include <memory>
 #include <string>
-#include <vector>
 
 class FunctionNode final : public AstNode {
   public:
-    using DeclNodes = std::vector<std::unique_ptr<DeclNode>>;
+    using DeclNodes = AstVector<std::unique_ptr<DeclNode>>;
 
   private:
-    std::string m_name;
+    AstString m_name;
     DeclNodes m_parameters;
-    std::unique_ptr<PType> m_ret_type;
+    const PType *m_ret_type;
     std::unique_ptr<CompoundStatementNode> m_body;
 
-    mutable std::string m_prototype_string;
-    mutable bool m_prototype_string_is_valid = false;
+    /// @brief Built by the constructor (see `AstArena`).
+    AstString m_prototype_string;
 
   public:
     ~FunctionNode() = default;
     FunctionNode(const uint32_t line, const uint32_t col,
                  const char *const p_name, DeclNodes &p_decl_nodes,
-                 PType *const p_ret_type, CompoundStatementNode *const p_body)
+                 const PType *const p_ret_type,
+                 CompoundStatementNode *const p_body)
         : AstNode{line, col}, m_name(p_name),
           m_parameters(std::move(p_decl_nodes)), m_ret_type(p_ret_type),
-          m_body(p_body) {}
+          m_body(p_body) {
+        m_prototype_string.append(m_ret_type->getPTypeCString())
+            .append(" (")
+            .append(getParametersTypeString(m_parameters).c_str())
+            .append(")");
+    }
 
     static std::string getParametersTypeString(const DeclNodes &p_parameters);
     static DeclNodes::size_type getParametersNum(const DeclNodes &p_parameters);
 
-    const std::string &getName() const { return m_name; }
+    const AstString &getName() const { return m_name; }
     const char *getNameCString() const { return m_name.c_str(); }
     const char *getPrototypeCString() const;
 
     const DeclNodes &getParameters() const { return m_parameters; }
+    /// @return `nullptr` if the function is only declared.
+    CompoundStatementNode *getBody() { return m_body.get(); }
 
-    const PType *getTypePtr() const { return m_ret_type.get(); }
+    const PType *getTypePtr() const { return m_ret_type; }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
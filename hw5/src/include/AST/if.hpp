@@ -23,10 +23,20 @@ class IfNode final : public AstNode {
           m_else_body(p_else_body) {}
 
     const ExpressionNode &getCondition() const { return *m_condition.get(); }
+    /// @brief For the passes that replace the condition.
+    std::unique_ptr<ExpressionNode> &getConditionPtr() { return m_condition; }
     const CompoundStatementNode &getBody() const { return *m_body.get(); }
+    CompoundStatementNode &getBody() { return *m_body.get(); }
+    bool hasElseBody() const { return m_else_body != nullptr; }
     const CompoundStatementNode &getElseBody() const {
         return *m_else_body.get();
     }
+    CompoundStatementNode &getElseBody() { return *m_else_body.get(); }
+    /// @brief For the passes that take the bodies out.
+    std::unique_ptr<CompoundStatementNode> &getBodyPtr() { return m_body; }
+    std::unique_ptr<CompoundStatementNode> &getElseBodyPtr() {
+        return m_else_body;
+    }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
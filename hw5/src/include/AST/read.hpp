@@ -17,6 +17,7 @@ class ReadNode final : public AstNode {
         : AstNode{line, col}, m_target(p_target){}
 
     const VariableReferenceNode &getTarget() const { return *m_target.get(); }
+    VariableReferenceNode &getTarget() { return *m_target.get(); }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
@@ -18,6 +18,8 @@ class ReturnNode final : public AstNode {
         : AstNode{line, col}, m_ret_val(p_ret_val){}
 
     const ExpressionNode &getReturnValue() const { return *m_ret_val.get(); }
+    /// @brief For the passes that replace the value.
+    std::unique_ptr<ExpressionNode> &getReturnValuePtr() { return m_ret_val; }
 
     void accept(AstNodeVisitor &p_visitor) override { p_visitor.visit(*this); }
     void visitChildNodes(AstNodeVisitor &p_visitor) override;
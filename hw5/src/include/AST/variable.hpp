@@ -1,33 +1,37 @@
 #ifndef AST_VARIABLE_NODE_H
 #define AST_VARIABLE_NODE_H
 
+#include "AST/AstArena.hpp"
 #include "AST/PType.hpp"
 #include "AST/ast.hpp"
 #include "AST/ConstantValue.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
-#include <memory>
-#include <string>
+class SymbolEntry;
 
 class VariableNode final : public AstNode {
   private:
-    std::string m_name;
-    PTypeSharedPtr m_type;
-    std::shared_ptr<ConstantValueNode> m_constant_value_node_ptr;
+    AstString m_name;
+    const PType *m_type;
+    /// @brief Shared by the variables of a declaration. It lives in the arena
+    /// and owns nothing outside it, so it needs no owner.
+    ConstantValueNode *m_constant_value_node_ptr;
+    /// @brief The entry this node declares; set by the semantic analyzer.
+    const SymbolEntry *m_symbol_entry = nullptr;
 
   public:
     ~VariableNode() = default;
     VariableNode(const uint32_t line, const uint32_t col,
-                 const std::string &p_name, const PTypeSharedPtr &p_type,
-                 const std::shared_ptr<ConstantValueNode> &p_constant_value_node)
+                 const char *const p_name, const PType *const p_type,
+                 ConstantValueNode *const p_constant_value_node)
         : AstNode{line, col}, m_name(p_name), m_type(p_type),
           m_constant_value_node_ptr(p_constant_value_node) {}
 
-    const std::string &getName() const { return m_name; }
+    const AstString &getName() const { return m_name; }
     const char *getNameCString() const { return m_name.c_str(); }
     const char *getTypeCString() const { return m_type->getPTypeCString(); }
 
-    const PType *getTypePtr() const { return m_type.get(); }
+    const PType *getTypePtr() const { return m_type; }
 
     const Constant *getConstantPtr() const {
         if (!m_constant_value_node_ptr) {
@@ -36,6 +40,12 @@ class VariableNode final : public AstNode {
         return m_constant_value_node_ptr->getConstantPtr();
     }
 
+    /// @return `nullptr` if the declaration is erroneous.
+    const SymbolEntry *getSymbolEntry() const { return m_symbol_entry; }
+    void setSymbolEntry(const SymbolEntry *p_entry) {
+        m_symbol_entry = p_entry;
+    }
+
     void accept(AstNodeVisitor &p_visitor) override {
         p_visitor.visit(*this);
     }
@@ -0,0 +1,34 @@
+#ifndef CODEGEN_ASM_WRITER_H
+#define CODEGEN_ASM_WRITER_H
+
+#include <cstddef>
+#include <string>
+
+class InstructionStream;
+struct MachineInstruction;
+
+/// @brief Formats the instructions of a stream as assembly text.
+///
+/// The text is appended to a string, so that a whole program can be written
+/// to its file at once instead of an instruction at a time.
+class AsmWriter {
+  private:
+    std::string &m_output;
+
+  public:
+    ~AsmWriter() = default;
+    explicit AsmWriter(std::string &p_output) : m_output(p_output) {}
+
+    void write(const InstructionStream &p_stream);
+
+  private:
+    void writeInstruction(const InstructionStream &p_stream,
+                          const MachineInstruction &p_inst);
+    void writeLabel(const InstructionStream &p_stream, int p_label);
+    void writeRegister(int p_reg);
+    void writeInt(int p_value);
+    void writeComment(const MachineInstruction &p_inst,
+                      std::size_t p_line_start);
+};
+
+#endif
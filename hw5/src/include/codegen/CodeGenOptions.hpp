@@ -0,0 +1,82 @@
+#ifndef CODEGEN_CODE_GEN_OPTIONS_H
+#define CODEGEN_CODE_GEN_OPTIONS_H
+
+#include <cstddef>
+
+/// @brief The optimizations of the code generator. All of them are on by
+/// default (`-O1`); `-O0` turns all of them off.
+struct CodeGenOptions {
+    /// @brief Evaluates the constant subexpressions and substitutes the
+    /// constants before any code is generated. (`--no-fold`)
+    bool fold_constants = true;
+    /// @brief Substitutes the bodies of small functions for the invocations
+    /// of them before any code is generated. (`--no-inline`)
+    bool inline_functions = true;
+    /// @brief The most AST nodes that inlining an invocation outside loops
+    /// may add beyond what the call costs. (`--inline-threshold <n>`)
+    std::size_t inline_threshold = 16;
+    /// @brief Removes the unreachable statements, the dead stores, and the
+    /// unused locals before any code is generated. (`--no-dce`)
+    bool eliminate_dead_code = true;
+    /// @brief Keeps the scalar locals, parameters, and loop variables in the
+    /// callee-saved registers instead of their stack slots.
+    /// (`--no-regalloc`)
+    bool allocate_registers = true;
+    /// @brief Lowers a `for` loop to a counted loop: the loop variable starts
+    /// in its home, and a single compare-and-branch at the bottom repeats the
+    /// body. (`--no-counted-loops`)
+    bool count_loops = true;
+    /// @brief Unrolls the counted loops, as long as each grows by at most
+    /// `unroll_budget` instructions. (`--no-unroll`)
+    bool unroll_loops = true;
+    /// @brief A loop that runs at most this many times is unrolled fully.
+    /// (`--unroll-full <n>`)
+    std::size_t unroll_full_limit = 8;
+    /// @brief The most copies of the body that an iteration of a partially
+    /// unrolled loop runs; the iterations left over run before the loop.
+    /// (`--unroll-factor <n>`)
+    std::size_t unroll_factor = 4;
+    /// @brief The most instructions that unrolling may add to a loop.
+    /// (`--unroll-budget <n>`)
+    std::size_t unroll_budget = 64;
+    /// @brief Tests the condition of a `while` loop once before it and again
+    /// at the bottom, instead of only at the top. (`--no-loop-rotation`)
+    bool rotate_loops = true;
+    /// @brief Evaluates the expressions that are invariant in a loop once
+    /// before it, into the callee-saved registers left over. (`--no-licm`)
+    bool hoist_invariants = true;
+    /// @brief Turns a call in tail position into a jump: back to the top of
+    /// the function if it calls itself, and to the callee in place of the
+    /// return otherwise, so that the frame is reused. (`--no-tail-calls`)
+    bool eliminate_tail_calls = true;
+    /// @brief Promotes the slots of the IR to temps in SSA form before
+    /// generating code from it. (`--no-ssa`)
+    bool build_ssa = true;
+    /// @brief Rewrites short sequences of the generated instructions, such as
+    /// a push right before a pop. (`--no-peephole`)
+    bool peephole = true;
+    /// @brief The threads that generate the functions of a program. The
+    /// output is the same for any number of them. (`-j` with a single file)
+    std::size_t num_threads = 1;
+
+    /// @return The options of the optimization level `p_level` (0 or 1).
+    static CodeGenOptions fromLevel(const int p_level) {
+        CodeGenOptions options;
+        if (p_level == 0) {
+            options.fold_constants = false;
+            options.inline_functions = false;
+            options.eliminate_dead_code = false;
+            options.allocate_registers = false;
+            options.count_loops = false;
+            options.unroll_loops = false;
+            options.rotate_loops = false;
+            options.hoist_invariants = false;
+            options.eliminate_tail_calls = false;
+            options.build_ssa = false;
+            options.peephole = false;
+        }
+        return options;
+    }
+};
+
+#endif
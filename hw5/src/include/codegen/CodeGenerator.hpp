@@ -1,33 +1,109 @@
 #ifndef CODEGEN_CODE_GENERATOR_H
 #define CODEGEN_CODE_GENERATOR_H
 
+#include <cstdint>
 #include <cstdio>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
-#include "sema/SemanticAnalyzer.hpp"
+#include "codegen/CodeGenOptions.hpp"
+#include "codegen/FrameLayoutBuilder.hpp"
+#include "codegen/InstructionStream.hpp"
+#include "codegen/LinearScanRegisterAllocator.hpp"
+#include "codegen/LoopInvariantHoister.hpp"
+#include "codegen/PeepholeOptimizer.hpp"
+#include "codegen/RegisterPool.hpp"
+#include "codegen/SethiUllmanLabeler.hpp"
+#include "codegen/SideEffectAnalyzer.hpp"
 #include "sema/SymbolTable.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
 class CodeGenerator final : public AstNodeVisitor {
+   public:
+    /// @brief The number of instructions of each function, in the order they
+    /// are emitted; the main program is named `main`.
+    using InstructionCounts = std::vector<std::pair<std::string, std::size_t>>;
+
    private:
-    SymbolManager m_symbol_manager;
     std::string m_source_file_path;
-    std::unordered_map<SemanticAnalyzer::AstNodeAddr, SymbolManager::Table>
-        m_symbol_table_of_scoping_nodes;
     /// NOTE: `FILE` cannot be simply deleted by `delete`, so we need a custom
     /// deleter.
     std::unique_ptr<FILE, decltype(&fclose)> m_output_file{nullptr, &fclose};
-    bool isAssignment = false;
-    void setIsAssignment(bool p_value) { isAssignment = p_value; }
+    CodeGenOptions m_options;
+
+    /// @brief Expressions are evaluated in registers. Each visit of an
+    /// expression node leaves its value in `m_result_reg`; the stack is only
+    /// used when the registers run out or have to be saved across a call.
+    RegisterPool m_registers;
+    RegisterPool::Reg m_result_reg = RegisterPool::kNoReg;
+    SethiUllmanLabeler m_labeler;
+    /// @brief The nesting depth of `evaluate()`; a function invocation at depth
+    /// 0 is a call statement whose return value is discarded.
+    int m_expression_depth = 0;
+
+    /// @brief The variables of the current function that live in the
+    /// callee-saved registers.
+    LinearScanRegisterAllocator::Allocation m_allocation;
+    /// @brief The globals each function may write; shared by the threads.
+    std::shared_ptr<const SideEffectAnalyzer::Summary> m_side_effects;
+    /// @brief The invariants of the loops of the current function.
+    LoopInvariantHoister::Plan m_hoists;
+    /// @brief The invariants of the loops being generated, which are read
+    /// from their registers instead of evaluated.
+    std::unordered_map<const ExpressionNode *, RegisterPool::Reg>
+        m_hoisted_values;
+    /// @brief The stack frame of the current function.
+    FrameLayoutBuilder::Layout m_frame;
+    /// @brief The label of the epilogue of the current function.
+    int m_return_label = 0;
+    /// @brief The invocations in tail position in the current function, which
+    /// are generated as jumps, and whether each is a call to the function
+    /// itself.
+    std::unordered_map<const FunctionInvocationNode *, bool> m_tail_calls;
+    /// @brief The size of a copy of each counted loop body of the current
+    /// function, with the increment of its variable.
+    std::unordered_map<const CompoundStatementNode *, int64_t> m_copy_sizes;
+    /// @brief The label before the parameters are moved to their homes, which
+    /// a call of the current function to itself jumps to; -1 if none does.
+    int m_entry_label = -1;
+    /// @brief The instructions of the current function. The labels are
+    /// numbered per function, so that the functions can be generated
+    /// independently.
+    InstructionStream m_stream;
+    /// @brief The assembly of the streams so far; written to the file at once
+    /// when the program is done.
+    std::string m_output;
+    PeepholeOptimizer m_peephole;
+    /// @brief The rules applied to all functions so far, including the ones
+    /// generated by other threads.
+    PeepholeOptimizer::Stats m_peephole_stats;
+    InstructionCounts m_instruction_counts;
 
    public:
     ~CodeGenerator() = default;
-    CodeGenerator(
-        const std::string &source_file_name, const std::string &save_path,
-        std::unordered_map<SemanticAnalyzer::AstNodeAddr, SymbolManager::Table>
-            &&p_symbol_table_of_scoping_nodes);
+    CodeGenerator(const std::string &source_file_name,
+                  const std::string &save_path,
+                  const CodeGenOptions &p_options = CodeGenOptions{});
+
+    /// @return `<save_path>/<basename of the source without .p>.S`; the
+    /// current directory if `save_path` is empty.
+    static std::string getOutputFilePath(const std::string &source_file_name,
+                                         const std::string &save_path);
+
+    /// @brief Generates the code of the program `p_root` without writing it.
+    static InstructionCounts countInstructions(
+        const std::string &source_file_name, AstNode &p_root,
+        const CodeGenOptions &p_options);
+
+    const PeepholeOptimizer::Stats &getPeepholeStats() const {
+        return m_peephole_stats;
+    }
+    const InstructionCounts &getInstructionCounts() const {
+        return m_instruction_counts;
+    }
 
     void visit(ProgramNode &p_program) override;
     void visit(DeclNode &p_decl) override;
@@ -46,6 +122,101 @@ class CodeGenerator final : public AstNodeVisitor {
     void visit(WhileNode &p_while) override;
     void visit(ForNode &p_for) override;
     void visit(ReturnNode &p_return) override;
+
+   private:
+    /// @brief Generates the code to `m_output` only.
+    CodeGenerator(const std::string &p_source_file_path,
+                  const CodeGenOptions &p_options);
+
+    /// @brief Emits the functions in order, generating them on
+    /// `m_options.num_threads` threads.
+    void emitFunctions(ProgramNode &p_program);
+    /// @brief Starts the stream of the function `p_name`, whose labels are
+    /// printed as `.L<function>.<n>`; not a valid P identifier, so they never
+    /// clash with a function or a global.
+    void beginStream(const std::string &p_name);
+    /// @brief Optimizes the current stream and formats it to `m_output`.
+    void flushStream();
+    /// @return The register that holds the value of `p_expr`. The caller owns
+    /// the register and has to release it; `kNoReg` if the expression is a
+    /// call to a procedure. A variable or a hoisted invariant in a
+    /// callee-saved register is returned as is, so the register must not be
+    /// written.
+    RegisterPool::Reg evaluate(const ExpressionNode &p_expr);
+    /// @brief Evaluates both operands in the order that needs fewer registers.
+    /// @return The registers of the left and right operands. Both are owned by
+    /// the caller.
+    std::pair<RegisterPool::Reg, RegisterPool::Reg> evaluateOperands(
+        const BinaryOperatorNode &p_bin_op);
+    /// @brief Evaluates the invariants of `p_loop` into their registers.
+    void emitPreheader(const AstNode &p_loop);
+    /// @brief Forgets the invariants of `p_loop` once it ends.
+    void retireInvariants(const AstNode &p_loop);
+    /// @brief Emits a branch to `p_label` that is taken when `p_condition` is
+    /// `p_value`.
+    void emitBranchIf(const ExpressionNode &p_condition, bool p_value,
+                      int p_label);
+    /// @brief Emits `p_for` as a counted loop. Since the bounds are constants
+    /// and the loop runs at least once, the test at the head is left out; the
+    /// upper bound stays in a register if nothing in the body may overwrite
+    /// it.
+    void emitCountedLoop(ForNode &p_for);
+    /// @brief Adds one to the loop variable `p_entry`.
+    /// @return The register that holds the new value, which the caller has
+    /// to release.
+    RegisterPool::Reg emitIncrement(const SymbolEntry &p_entry);
+    /// @return How many copies of `p_body` an iteration of the unrolled loop
+    /// runs: `p_trip_count` to unroll it fully, and 1 to keep it as is.
+    int64_t getUnrollFactor(int64_t p_trip_count, CompoundStatementNode &p_body);
+    /// @return The callee-saved register that holds the variable; `kNoReg` if
+    /// it lives in memory.
+    RegisterPool::Reg getVariableRegister(const SymbolEntry &p_entry) const;
+    /// @return The offset of the slot of a variable that lives in memory.
+    int getSlotOffset(const SymbolEntry &p_entry) const;
+    /// @brief Loads the slot at `p_offset` from the frame pointer.
+    /// @note `p_rd` holds the address first if the offset does not fit in an
+    /// immediate.
+    void emitLoadSlot(RegisterPool::Reg p_rd, int p_offset,
+                      const char *p_comment = nullptr,
+                      const char *p_symbol = nullptr);
+    /// @brief Stores to the slot at `p_offset` from the frame pointer.
+    /// @note `ra` holds the address if the offset does not fit in an
+    /// immediate; it is free while the frame is set up, since it is saved in
+    /// the frame and reloaded from there.
+    void emitStoreSlot(RegisterPool::Reg p_src, int p_offset,
+                       const char *p_comment = nullptr,
+                       const char *p_symbol = nullptr);
+    /// @brief Allocates the frame and saves `ra` and the caller's `s0`.
+    void emitFrameSetup(const char *p_comment);
+    /// @brief Restores `ra` and `s0`, frees the frame, and returns.
+    void emitFrameTeardown(const char *p_comment);
+    /// @brief Restores `ra` and `s0` and frees the frame.
+    void emitFrameRestore(const char *p_comment);
+    /// @brief Saves the used callee-saved registers and moves the parameters
+    /// to their homes, right after the fixed part of the prologue.
+    /// @param p_function `nullptr` for the main program.
+    void emitPrologue(const FunctionNode *p_function);
+    /// @brief Restores the used callee-saved registers; returns jump here.
+    void emitEpilogue();
+    /// @brief Restores the used callee-saved registers.
+    void emitRestoreSavedRegisters();
+    /// @brief Finds the invocations in tail position in `p_function`, and
+    /// whether it invokes itself in any of them.
+    void findTailCalls(FunctionNode &p_function);
+    /// @brief Evaluates the arguments of `p_call` into the registers that
+    /// carry them, which the caller has to release.
+    void emitArguments(const FunctionInvocationNode &p_call);
+    /// @brief Emits `p_call` as the last thing the function does: the
+    /// arguments replace the parameters and the body runs again if it is a
+    /// call to the function itself; otherwise the frame is torn down and the
+    /// callee returns to the caller of the function.
+    void emitTailCall(const FunctionInvocationNode &p_call);
+    /// @return A free register. Never fails, since every expression node is
+    /// visited with at least one free register.
+    RegisterPool::Reg allocateRegister();
+    void emitPush(RegisterPool::Reg p_reg);
+    void emitPop(RegisterPool::Reg p_reg);
+    void emitStore(const SymbolEntry &p_entry, RegisterPool::Reg p_reg);
 };
 
 #endif
@@ -0,0 +1,94 @@
+#ifndef CODEGEN_FRAME_LAYOUT_BUILDER_H
+#define CODEGEN_FRAME_LAYOUT_BUILDER_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "codegen/LinearScanRegisterAllocator.hpp"
+#include "codegen/RegisterPool.hpp"
+#include "sema/SymbolTable.hpp"
+#include "visitor/AstNodeVisitor.hpp"
+
+class PType;
+
+/// @brief Lays out the stack frame of a function from the types of its
+/// locals.
+///
+/// Right below the frame pointer are `ra` and the caller's `s0`, then the
+/// callee-saved registers the function uses, then a slot for each parameter
+/// and local that is not kept in a register. A slot is as large as its type:
+/// an array takes a word for each of its elements, while an array parameter
+/// is only the address of the caller's array. The scalars come before the
+/// arrays, so that their offsets stay small enough for a `lw` or `sw`. The
+/// frame is padded to a multiple of 16 bytes, as the calling convention
+/// requires of the stack pointer.
+///
+/// A local is only live in its scope, so the slots are handed out like a
+/// stack: the slots of a compound statement or a for loop are freed when it
+/// ends, and the next scope reuses them. The scalars and the arrays are
+/// stacked separately, so sibling scopes share the space of both.
+class FrameLayoutBuilder final : public AstNodeVisitor {
+  public:
+    struct Layout {
+        /// @brief The offsets from the frame pointer to the slots.
+        std::unordered_map<const SymbolEntry *, int> offsets;
+        /// @brief The used callee-saved registers, each with the offset of
+        /// the slot to save it in.
+        std::vector<std::pair<RegisterPool::Reg, int>> saved_registers;
+        /// @brief A multiple of `kStackAlignment`.
+        int size = 0;
+    };
+
+    static constexpr int kWordSize = 4;
+    static constexpr int kStackAlignment = 16;
+    /// @brief The offset of the saved `ra`; the caller's `s0` is right below.
+    static constexpr int kReturnAddressOffset = -kWordSize;
+    static constexpr int kFramePointerOffset = -2 * kWordSize;
+
+  private:
+    /// @brief The slots of the scalars or of the arrays.
+    struct Region {
+        /// @brief The end of each slot, counted from the start of the region.
+        std::vector<std::pair<const SymbolEntry *, std::uint64_t>> slots;
+        /// @brief The end of the slots of the scopes that are open.
+        std::uint64_t top = 0;
+        std::uint64_t size = 0;
+    };
+
+    const LinearScanRegisterAllocator::Allocation *m_allocation = nullptr;
+    Region m_scalars;
+    Region m_arrays;
+
+  public:
+    ~FrameLayoutBuilder() = default;
+    FrameLayoutBuilder() = default;
+
+    /// @param p_allocation The variables in it get no slot.
+    Layout build(FunctionNode &p_function,
+                 const LinearScanRegisterAllocator::Allocation &p_allocation);
+    /// @brief Lays out the frame of the main program.
+    Layout build(CompoundStatementNode &p_body,
+                 const LinearScanRegisterAllocator::Allocation &p_allocation);
+
+    /// @return The bytes of a local of type `p_type`.
+    static std::uint64_t getSize(const PType &p_type);
+
+    void visit(DeclNode &p_decl) override;
+    void visit(VariableNode &p_variable) override;
+    void visit(CompoundStatementNode &p_compound_statement) override;
+    void visit(IfNode &p_if) override;
+    void visit(WhileNode &p_while) override;
+    void visit(ForNode &p_for) override;
+
+  private:
+    void reset(const LinearScanRegisterAllocator::Allocation &p_allocation);
+    void addSlot(const SymbolEntry &p_entry, std::uint64_t p_size);
+    /// @brief Visits the children of a scope, and frees the slots of its
+    /// locals afterwards.
+    void visitScope(AstNode &p_node);
+    Layout layOut() const;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef CODEGEN_INSTRUCTION_STREAM_H
+#define CODEGEN_INSTRUCTION_STREAM_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "codegen/MachineInstruction.hpp"
+#include "codegen/RegisterPool.hpp"
+
+/// @brief The instructions of one function (or of the globals) in order,
+/// along with the numbering of its local labels.
+///
+/// The labels are numbered per stream and printed as `.L<scope>.<n>`, so the
+/// streams of different functions can be built independently.
+class InstructionStream {
+  public:
+    using Opcode = MachineInstruction::Opcode;
+    using Reg = RegisterPool::Reg;
+
+    /// @brief A point of the stream that it can be rolled back to.
+    struct Mark {
+        std::size_t num_instructions;
+        std::size_t num_directives;
+        int num_labels;
+    };
+
+  private:
+    std::string m_label_scope;
+    int m_num_labels = 0;
+    std::vector<MachineInstruction> m_instructions;
+    std::vector<std::string> m_directives;
+
+  public:
+    ~InstructionStream() = default;
+    InstructionStream() = default;
+
+    /// @brief Drops all instructions and starts numbering the labels of
+    /// `p_label_scope` anew.
+    void reset(const std::string &p_label_scope);
+
+    const std::string &getLabelScope() const { return m_label_scope; }
+    /// @return A label that is not used yet in this stream.
+    int createLabel() { return ++m_num_labels; }
+
+    Mark getMark() const {
+        return {m_instructions.size(), m_directives.size(), m_num_labels};
+    }
+    /// @brief Drops what was emitted after `p_mark`, labels included.
+    void rollBack(const Mark &p_mark);
+    /// @return The number of instructions emitted after `p_mark`, not
+    /// counting the labels and the directives.
+    std::size_t countInstructionsSince(const Mark &p_mark) const;
+
+    std::vector<MachineInstruction> &getInstructions() {
+        return m_instructions;
+    }
+    const std::vector<MachineInstruction> &getInstructions() const {
+        return m_instructions;
+    }
+    const std::string &getDirective(const MachineInstruction &p_inst) const {
+        return m_directives[p_inst.imm];
+    }
+
+    /// @brief `add`, `sub`, `mul`, `div`, `rem`, `and`, `or`, and `slt`.
+    void emitBinary(Opcode p_opcode, Reg p_rd, Reg p_rs1, Reg p_rs2,
+                    const char *p_comment = nullptr);
+    /// @brief `addi` and `xori`.
+    void emitImmediate(Opcode p_opcode, Reg p_rd, Reg p_rs1, int p_imm,
+                       const char *p_comment = nullptr);
+    void emitLoadImmediate(Reg p_rd, int p_imm);
+    /// @brief `mv`, `neg`, `seqz`, and `snez`.
+    void emitUnary(Opcode p_opcode, Reg p_rd, Reg p_rs1,
+                   const char *p_comment = nullptr,
+                   const char *p_symbol = nullptr);
+    void emitLoad(Reg p_rd, int p_offset, Reg p_base,
+                  const char *p_comment = nullptr,
+                  const char *p_symbol = nullptr);
+    void emitStore(Reg p_src, int p_offset, Reg p_base,
+                   const char *p_comment = nullptr,
+                   const char *p_symbol = nullptr);
+    void emitLoadAddress(Reg p_rd, const char *p_symbol);
+    /// @brief `beq`, `bne`, `blt`, `bge`, `ble`, and `bgt`.
+    void emitBranch(Opcode p_opcode, Reg p_rs1, Reg p_rs2, int p_label);
+    void emitBranchIfZero(Reg p_rs1, int p_label);
+    void emitBranchIfNonZero(Reg p_rs1, int p_label);
+    void emitJump(int p_label);
+    /// @param p_num_arguments The arguments in the argument registers, which
+    /// the callee reads.
+    void emitCall(const char *p_symbol, int p_num_arguments,
+                  const char *p_comment = nullptr);
+    /// @brief Jumps to `p_symbol` without linking, so that the callee returns
+    /// to the caller of the current function.
+    void emitTailCall(const char *p_symbol, int p_num_arguments,
+                      const char *p_comment = nullptr);
+    void emitJumpRegister(Reg p_rs1);
+    void emitLabel(int p_label);
+    /// @brief A line of its own, such as a directive or a global label.
+    void emitDirective(std::string p_text);
+
+  private:
+    MachineInstruction &append(Opcode p_opcode);
+};
+
+#endif
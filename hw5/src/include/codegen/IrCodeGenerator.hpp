@@ -0,0 +1,76 @@
+#ifndef CODEGEN_IR_CODE_GENERATOR_H
+#define CODEGEN_IR_CODE_GENERATOR_H
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ir/IrFunction.hpp"
+#include "ir/IrInstruction.hpp"
+#include "ir/IrModule.hpp"
+
+/// @brief Emits RISC-V assembly from the three-address IR.
+///
+/// Slots and temps live in the stack frame, which is sized per function;
+/// each instruction loads its operands into t0/t1. A temp that is used only
+/// in the block defining it shares its frame location with other such temps
+/// once dead. A comparison that only feeds the branch right after it is
+/// fused into the branch.
+///
+/// A phi gets a shadow location besides its own: each predecessor writes its
+/// incoming value to the shadow before leaving, and the phi copies it at the
+/// start of its block, so phis that read each other never see a value of the
+/// current iteration.
+class IrCodeGenerator {
+  private:
+    /// NOTE: `FILE` cannot be simply deleted by `delete`, so we need a custom
+    /// deleter.
+    std::unique_ptr<FILE, decltype(&fclose)> m_output_file{nullptr, &fclose};
+
+    const IrModule *m_module = nullptr;
+    const IrFunction *m_function = nullptr;
+    /// @brief The s0-relative offset of each temp; 0 if it needs none.
+    std::vector<int> m_temp_offsets;
+    std::vector<bool> m_is_fused;
+    /// @brief The s0-relative offset of the shadow of each phi; 0 if the temp
+    /// is not a phi.
+    std::vector<int> m_phi_shadow_offsets;
+    int m_frame_size = 0;
+
+  public:
+    ~IrCodeGenerator() = default;
+    IrCodeGenerator(const std::string &source_file_name,
+                    const std::string &save_path);
+
+    void generate(const IrModule &p_module);
+
+  private:
+    void generateFunction(const IrFunction &p_function);
+    void layoutFrame();
+    int getSlotOffset(int p_slot) const;
+
+    void emitPrologue();
+    void emitEpilogue();
+    void emitBlock(const IrBasicBlock &p_block, int p_next_block_id);
+    void emitInstruction(const IrInstruction &p_instruction);
+    /// @return Whether the comparison is fused into the branch after it.
+    bool isFused(const IrInstruction &p_instruction) const;
+    /// @brief Writes the incoming values of the phis of the successors.
+    void emitPhiCopies(const IrBasicBlock &p_block);
+    void emitBranch(const IrBasicBlock &p_block, int p_next_block_id);
+    void emitJump(int p_target, int p_next_block_id);
+
+    /// @brief Loads a temp or an immediate into `p_reg`.
+    void emitLoadOperand(const IrOperand &p_operand, const char *p_reg);
+    /// @brief Stores `p_reg` to the location of the temp `p_dst`.
+    void emitStoreResult(int p_dst, const char *p_reg);
+    /// @note `p_reg` is used as the address if the offset is out of range.
+    void emitLoadFrame(const char *p_reg, int p_offset);
+    /// @param p_scratch Holds the address if the offset is out of range.
+    void emitStoreFrame(const char *p_reg, int p_offset, const char *p_scratch);
+
+    void dumpInstructions(const char *p_format, ...);
+};
+
+#endif
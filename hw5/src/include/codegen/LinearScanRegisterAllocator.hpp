@@ -0,0 +1,82 @@
+#ifndef CODEGEN_LINEAR_SCAN_REGISTER_ALLOCATOR_H
+#define CODEGEN_LINEAR_SCAN_REGISTER_ALLOCATOR_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "codegen/RegisterPool.hpp"
+#include "sema/SymbolTable.hpp"
+#include "visitor/AstNodeVisitor.hpp"
+
+/// @brief Assigns the scalar locals, parameters, and loop variables of a
+/// function to the callee-saved registers s1-s11 by linear scan.
+///
+/// The body is numbered in program order and each variable gets the interval
+/// between its first and last reference. A variable declared outside a loop
+/// and referenced inside it is live around the back edge, so its interval is
+/// stretched over the whole loop. When no register is free, the variable with
+/// the fewest references (weighted by loop depth) stays in its stack slot, as
+/// does a variable referenced too few times to pay for saving the register.
+class LinearScanRegisterAllocator final : public AstNodeVisitor {
+  public:
+    struct Allocation {
+        std::unordered_map<const SymbolEntry *, RegisterPool::Reg> registers;
+        /// @brief The used callee-saved registers in ascending order.
+        std::vector<RegisterPool::Reg> saved_registers;
+    };
+
+  private:
+    struct LiveInterval {
+        const SymbolEntry *entry;
+        int declared;
+        int start;
+        int end;
+        double weight;
+    };
+
+    struct LoopRange {
+        int start;
+        int end;
+    };
+
+    std::vector<LiveInterval> m_intervals;
+    std::unordered_map<const SymbolEntry *, std::size_t> m_interval_indices;
+    std::vector<LoopRange> m_loops;
+    int m_position = 0;
+    int m_loop_depth = 0;
+
+  public:
+    ~LinearScanRegisterAllocator() = default;
+    LinearScanRegisterAllocator() = default;
+
+    Allocation allocate(FunctionNode &p_function);
+    /// @brief Allocates for the body of the main program.
+    Allocation allocate(CompoundStatementNode &p_body);
+
+    void visit(DeclNode &p_decl) override;
+    void visit(VariableNode &p_variable) override;
+    void visit(CompoundStatementNode &p_compound_statement) override;
+    void visit(PrintNode &p_print) override;
+    void visit(BinaryOperatorNode &p_bin_op) override;
+    void visit(UnaryOperatorNode &p_un_op) override;
+    void visit(FunctionInvocationNode &p_func_invocation) override;
+    void visit(VariableReferenceNode &p_variable_ref) override;
+    void visit(AssignmentNode &p_assignment) override;
+    void visit(ReadNode &p_read) override;
+    void visit(IfNode &p_if) override;
+    void visit(WhileNode &p_while) override;
+    void visit(ForNode &p_for) override;
+    void visit(ReturnNode &p_return) override;
+
+  private:
+    void reset();
+    /// @return `nullptr` if the symbol is not a candidate.
+    const SymbolEntry *getCandidate(const SymbolEntry *p_entry) const;
+    void declare(const SymbolEntry &p_entry);
+    /// @brief Records a reference at the next position.
+    void touch(const SymbolEntry &p_entry);
+    void extendOverLoops();
+    Allocation scan();
+};
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef CODEGEN_LOOP_INVARIANT_HOISTER_H
+#define CODEGEN_LOOP_INVARIANT_HOISTER_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "codegen/LinearScanRegisterAllocator.hpp"
+#include "codegen/RegisterPool.hpp"
+#include "codegen/SideEffectAnalyzer.hpp"
+#include "visitor/AstNodeVisitor.hpp"
+
+class AstNode;
+class ExpressionNode;
+class SymbolEntry;
+
+/// @brief Picks the expressions in the loops of a function that have the
+/// same value on every iteration, to be evaluated once before the loop (in
+/// its preheader) into a callee-saved register left over by the allocator.
+///
+/// An expression is invariant in a loop if it invokes no function and none
+/// of the variables it reads is written in the loop: assigned, read into,
+/// declared, or used as a loop variable there. A call writes the globals the
+/// callee may write. Only the largest invariant subexpressions are hoisted,
+/// each to the outermost loop it is invariant in, and only if evaluating
+/// them takes at least `kMinCost` instructions, such as loading a global.
+/// A `for` loop that runs once is no loop.
+class LoopInvariantHoister final : public AstNodeVisitor {
+  public:
+    struct Hoist {
+        const ExpressionNode *expr;
+        RegisterPool::Reg reg;
+    };
+    /// @brief The expressions to evaluate before each loop, in order.
+    using Plan = std::unordered_map<const AstNode *, std::vector<Hoist>>;
+
+    static constexpr int kMinCost = 2;
+
+  private:
+    using Entries = std::unordered_set<const SymbolEntry *>;
+
+    struct Loop {
+        const AstNode *node;
+        /// @brief The index of the enclosing loop; -1 if none.
+        int parent;
+        Entries written;
+        std::vector<const ExpressionNode *> invariants;
+    };
+
+    const SideEffectAnalyzer::Summary *m_side_effects = nullptr;
+    const LinearScanRegisterAllocator::Allocation *m_allocation = nullptr;
+    /// @brief The loops of the function in the order they start.
+    std::vector<Loop> m_loops;
+    /// @brief The loops started so far in the current pass.
+    std::size_t m_num_visited_loops = 0;
+    /// @brief The loops around the node being visited, outermost first.
+    std::vector<std::size_t> m_open_loops;
+    /// @brief The first pass finds what each loop writes, and the second
+    /// one picks the invariants.
+    bool m_is_picking = false;
+    /// @brief The number of the open loops, from the outermost, that each
+    /// visited expression is not invariant in.
+    std::unordered_map<const ExpressionNode *, std::size_t> m_depths;
+
+  public:
+    ~LoopInvariantHoister() = default;
+    LoopInvariantHoister() = default;
+
+    /// @param p_allocation The registers it leaves free are handed out to
+    /// the hoisted expressions, and the ones used are added to it.
+    Plan plan(FunctionNode &p_function,
+              const SideEffectAnalyzer::Summary &p_side_effects,
+              LinearScanRegisterAllocator::Allocation &p_allocation);
+    /// @brief Plans for the body of the main program.
+    Plan plan(CompoundStatementNode &p_body,
+              const SideEffectAnalyzer::Summary &p_side_effects,
+              LinearScanRegisterAllocator::Allocation &p_allocation);
+
+    void visit(VariableNode &p_variable) override;
+    void visit(DeclNode &p_decl) override;
+    void visit(CompoundStatementNode &p_compound_statement) override;
+    void visit(PrintNode &p_print) override;
+    void visit(AssignmentNode &p_assignment) override;
+    void visit(ReadNode &p_read) override;
+    void visit(IfNode &p_if) override;
+    void visit(WhileNode &p_while) override;
+    void visit(ForNode &p_for) override;
+    void visit(ReturnNode &p_return) override;
+    void visit(FunctionInvocationNode &p_func_invocation) override;
+
+  private:
+    void reset(const SideEffectAnalyzer::Summary &p_side_effects,
+               const LinearScanRegisterAllocator::Allocation &p_allocation);
+    /// @brief Starts a pass over the function.
+    void beginPass(bool p_is_picking);
+    /// @brief Records a write to `p_entry` in the open loops.
+    void write(const SymbolEntry *p_entry);
+    /// @brief Records the writes of the functions invoked in `p_expr`.
+    void writeCallees(const ExpressionNode &p_expr);
+    /// @param p_condition `nullptr` for a `for` loop.
+    /// @param p_loop_var_decl `nullptr` for a `while` loop.
+    void visitLoop(const AstNode &p_loop, const ExpressionNode *p_condition,
+                   DeclNode *p_loop_var_decl, CompoundStatementNode &p_body);
+    /// @brief Visits `p_expr`, the root of an expression in a statement.
+    void visitExpression(const ExpressionNode &p_expr);
+    /// @return The number of the open loops that `p_expr` is not invariant
+    /// in, which is recorded for it and its subexpressions.
+    std::size_t measure(const ExpressionNode &p_expr);
+    /// @param p_depth The open loops the enclosing expression is not
+    /// invariant in; `p_expr` is only hoisted if it is invariant in more.
+    void pick(const ExpressionNode &p_expr, std::size_t p_depth);
+    /// @return The estimated number of instructions that evaluate `p_expr`.
+    int getCost(const ExpressionNode &p_expr) const;
+    /// @brief Hands out the registers to the invariants.
+    Plan assignRegisters(
+        LinearScanRegisterAllocator::Allocation &p_allocation) const;
+};
+
+#endif
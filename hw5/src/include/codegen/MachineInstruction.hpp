@@ -0,0 +1,108 @@
+#ifndef CODEGEN_MACHINE_INSTRUCTION_H
+#define CODEGEN_MACHINE_INSTRUCTION_H
+
+#include <cstdint>
+#include <string>
+
+#include "codegen/RegisterPool.hpp"
+
+/// @brief A RISC-V instruction, a label, or an assembler directive, as
+/// recorded by the code generator before it is formatted.
+///
+/// Which operands are used depends on the opcode:
+///
+/// | opcode                            | assembly                   |
+/// |-----------------------------------|----------------------------|
+/// | `add` ... `slt`                   | `op rd, rs1, rs2`          |
+/// | `addi`, `xori`                    | `op rd, rs1, imm`          |
+/// | `li`                              | `li rd, imm`               |
+/// | `mv`, `neg`, `seqz`, `snez`       | `op rd, rs1`               |
+/// | `lw`                              | `lw rd, imm(rs1)`          |
+/// | `sw`                              | `sw rs2, imm(rs1)`         |
+/// | `la`                              | `la rd, symbol`            |
+/// | `beq` ... `bgt`                   | `op rs1, rs2, label`       |
+/// | `beqz`, `bnez`                    | `op rs1, label`            |
+/// | `j`                               | `j label`                  |
+/// | `jal`                             | `jal ra, symbol`           |
+/// | tail                              | `j symbol`                 |
+/// | `jr`                              | `jr rs1`                   |
+/// | label                             | `label:`                   |
+/// | directive                         | the `imm`th directive text |
+struct MachineInstruction {
+    enum class Opcode : std::uint8_t {
+        kAdd,
+        kSub,
+        kMul,
+        kDiv,
+        kRem,
+        kAnd,
+        kOr,
+        kSlt,
+        kAddi,
+        kXori,
+        kLi,
+        kMv,
+        kNeg,
+        kSeqz,
+        kSnez,
+        kLw,
+        kSw,
+        kLa,
+        kBeq,
+        kBne,
+        kBlt,
+        kBge,
+        kBle,
+        kBgt,
+        kBeqz,
+        kBnez,
+        kJ,
+        kJal,
+        kTail,
+        kJr,
+        kLabel,
+        kDirective
+    };
+
+    Opcode opcode;
+    RegisterPool::Reg rd = RegisterPool::kNoReg;
+    RegisterPool::Reg rs1 = RegisterPool::kNoReg;
+    RegisterPool::Reg rs2 = RegisterPool::kNoReg;
+    /// @brief The immediate, the offset of a memory access, the number of
+    /// arguments of a call, or the index of a directive.
+    int imm = 0;
+    /// @brief The number of the local label that is defined or jumped to.
+    int label = 0;
+    /// @brief The global that is addressed or called; owned by the AST or by
+    /// the symbol tables.
+    const char *symbol = nullptr;
+    /// @brief Printed after the instruction; a `%s` in it stands for
+    /// `symbol`.
+    const char *comment = nullptr;
+
+    explicit MachineInstruction(const Opcode p_opcode) : opcode(p_opcode) {}
+
+    static const char *getMnemonic(Opcode p_opcode);
+
+    bool isBranch() const {
+        return opcode >= Opcode::kBeq && opcode <= Opcode::kBnez;
+    }
+    /// @return Whether control may enter or leave the code at this point;
+    /// true for labels and directives as well.
+    bool isControlFlow() const { return opcode >= Opcode::kBeq; }
+    /// @return The register that is written; `kNoReg` if none. A call only
+    /// counts as writing `ra`.
+    RegisterPool::Reg getDefinedRegister() const { return rd; }
+    bool reads(const RegisterPool::Reg p_reg) const {
+        return p_reg != RegisterPool::kNoReg && (rs1 == p_reg || rs2 == p_reg);
+    }
+    bool refersTo(const RegisterPool::Reg p_reg) const {
+        return rd == p_reg || reads(p_reg);
+    }
+    /// @return Whether the instruction refers to `label`.
+    bool hasLabel() const {
+        return isBranch() || opcode == Opcode::kJ || opcode == Opcode::kLabel;
+    }
+};
+
+#endif
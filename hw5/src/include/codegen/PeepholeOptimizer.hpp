@@ -0,0 +1,79 @@
+#ifndef CODEGEN_PEEPHOLE_OPTIMIZER_H
+#define CODEGEN_PEEPHOLE_OPTIMIZER_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "codegen/MachineInstruction.hpp"
+#include "codegen/RegisterPool.hpp"
+
+class InstructionStream;
+
+/// @brief Rewrites short sequences of the instructions of a stream.
+///
+/// The instructions are copied to the output one by one, and each rule is
+/// matched against the last few of the output, so that what one rule leaves
+/// behind is seen by the others. A rule only looks past instructions in a
+/// window of `kWindowSize`, and never past a label, a branch, or a call.
+class PeepholeOptimizer {
+  public:
+    enum Rule : std::size_t {
+        /// @brief `addi sp, sp, n; sw a, 0(sp); ...; lw b, 0(sp);
+        /// addi sp, sp, 4` to `addi sp, sp, n+4; ...; mv b, a`.
+        kPushPop,
+        /// @brief `sw a, n(r); ...; lw b, n(r)` to `sw a, n(r); ...; mv b, a`.
+        kStoreLoad,
+        /// @brief `sw a, n(r)` right after `lw a, n(r)`, which stores the
+        /// value that is already there.
+        kRedundantStore,
+        /// @brief `mv a, a`, and `mv b, a` right after `mv a, b`.
+        kRedundantMove,
+        /// @brief `op t, ...; mv a, t` to `op a, ...` if `t` is dead after.
+        kMoveFolding,
+        /// @brief `addi sp, sp, n; addi sp, sp, m` to `addi sp, sp, n+m`.
+        kStackAdjustment,
+        kNumRules
+    };
+
+    /// @brief The number of times each rule was applied.
+    struct Stats {
+        std::array<std::size_t, kNumRules> hits{};
+
+        void merge(const Stats &p_other);
+    };
+
+    static constexpr std::size_t kWindowSize = 8;
+
+  private:
+    Stats *m_stats = nullptr;
+    std::vector<MachineInstruction> m_output;
+
+  public:
+    ~PeepholeOptimizer() = default;
+    PeepholeOptimizer() = default;
+
+    static const char *getRuleName(Rule p_rule);
+
+    /// @brief Rewrites `p_stream`, adding the rules applied to `p_stats`.
+    void run(InstructionStream &p_stream, Stats &p_stats);
+
+  private:
+    using Reg = RegisterPool::Reg;
+    using Iterator = std::vector<MachineInstruction>::const_iterator;
+
+    /// @brief Applies the rules to the end of `m_output` until none matches.
+    void simplifyTail(Iterator p_next, Iterator p_end);
+    bool cancelPushPop();
+    bool forwardStore();
+    bool removeRedundantStore();
+    bool removeRedundantMove();
+    bool foldMove(Iterator p_next, Iterator p_end);
+    bool mergeStackAdjustments();
+
+    /// @return Whether the value of `p_reg` may be read by the instructions
+    /// in [`p_next`, `p_end`) before it is overwritten.
+    static bool isLiveAfter(Reg p_reg, Iterator p_next, Iterator p_end);
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef CODEGEN_REGISTER_POOL_H
+#define CODEGEN_REGISTER_POOL_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/// @brief Tracks which of the caller-saved registers (t0-t6, a0-a7) hold a
+/// live temporary while an expression is being evaluated.
+///
+/// The callee-saved registers s1-s11 have indices as well, but they hold
+/// variables for a whole function and are never handed out by the pool.
+class RegisterPool {
+  public:
+    /// @brief Index into the table of registers.
+    using Reg = int;
+    static constexpr Reg kNoReg = -1;
+    /// @brief The number of registers managed by the pool.
+    static constexpr std::size_t kNumRegisters = 15;
+    static constexpr std::size_t kNumSavedRegisters = 11;
+    /// @brief The registers with a fixed role, which only have names.
+    static constexpr Reg kReturnAddress =
+        static_cast<Reg>(kNumRegisters + kNumSavedRegisters);
+    static constexpr Reg kStackPointer = kReturnAddress + 1;
+    static constexpr Reg kFramePointer = kReturnAddress + 2;
+
+  private:
+    std::array<bool, kNumRegisters> m_is_live{};
+
+  public:
+    ~RegisterPool() = default;
+    RegisterPool() = default;
+
+    static const char *getName(Reg p_reg);
+
+    /// @return The register that carries the `p_nth` (0-based) argument of a
+    /// function call: a0-a7, then t0-t6 for the spilled ones.
+    static Reg getArgumentRegister(std::size_t p_nth);
+    /// @return The callee-saved register s`p_number` (1-11).
+    static Reg getSavedRegister(std::size_t p_number);
+    /// @return `false` for the callee-saved registers.
+    static bool isTemporary(Reg p_reg) {
+        return p_reg >= 0 && static_cast<std::size_t>(p_reg) < kNumRegisters;
+    }
+
+    /// @return `kNoReg` if all registers are live.
+    /// @note t0-t6 are preferred; a-registers are handed out from a7 down so
+    /// that the low argument registers stay free as long as possible.
+    Reg allocate();
+    /// @brief Marks the specific register as live.
+    /// @return `false` if the register is already live.
+    bool allocate(Reg p_reg);
+    /// @note Does nothing to a callee-saved register, so that a variable
+    /// operand can be released like a temporary one.
+    void release(Reg p_reg);
+
+    bool isLive(Reg p_reg) const { return m_is_live[p_reg]; }
+    std::size_t getNumFree() const;
+    /// @return The live registers in the order of their indices.
+    std::vector<Reg> getLiveRegisters() const;
+};
+
+#endif
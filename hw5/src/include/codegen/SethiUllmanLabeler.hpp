@@ -0,0 +1,45 @@
+#ifndef CODEGEN_SETHI_ULLMAN_LABELER_H
+#define CODEGEN_SETHI_ULLMAN_LABELER_H
+
+#include <unordered_map>
+
+#include "visitor/AstNodeVisitor.hpp"
+
+class ExpressionNode;
+
+/// @brief Numbers each expression subtree with the count of registers needed
+/// to evaluate it without spilling (Sethi-Ullman numbering).
+///
+/// A function invocation saves every live register before the call, so it
+/// only needs the register that receives its result. Whether a subtree
+/// contains a call is recorded as well: such subtrees may have side effects,
+/// so the operands around them must not be reordered.
+class SethiUllmanLabeler final : public AstNodeVisitor {
+  private:
+    struct Label {
+        int need;
+        bool has_call;
+    };
+
+    std::unordered_map<const ExpressionNode *, Label> m_labels;
+
+  public:
+    ~SethiUllmanLabeler() = default;
+    SethiUllmanLabeler() = default;
+
+    /// @brief Labels `p_expr` and all its subtrees if not yet labeled.
+    void label(const ExpressionNode &p_expr);
+
+    /// @pre `p_expr` is labeled.
+    int getNeed(const ExpressionNode &p_expr) const;
+    /// @pre `p_expr` is labeled.
+    bool containsCall(const ExpressionNode &p_expr) const;
+
+    void visit(ConstantValueNode &p_constant_value) override;
+    void visit(BinaryOperatorNode &p_bin_op) override;
+    void visit(UnaryOperatorNode &p_un_op) override;
+    void visit(FunctionInvocationNode &p_func_invocation) override;
+    void visit(VariableReferenceNode &p_variable_ref) override;
+};
+
+#endif
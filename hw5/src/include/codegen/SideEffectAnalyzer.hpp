@@ -0,0 +1,54 @@
+#ifndef CODEGEN_SIDE_EFFECT_ANALYZER_H
+#define CODEGEN_SIDE_EFFECT_ANALYZER_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "visitor/AstNodeVisitor.hpp"
+
+class SymbolEntry;
+
+/// @brief Finds the global variables that each function may write, either
+/// itself or through the functions it calls.
+///
+/// A function can only change the globals: the parameters are copies, and
+/// P has no pointers. `printInt` and `readInt` write none of them.
+class SideEffectAnalyzer final : public AstNodeVisitor {
+  public:
+    using Globals = std::unordered_set<const SymbolEntry *>;
+    /// @brief The globals written by each function, by its name.
+    using Summary = std::unordered_map<std::string, Globals>;
+
+  private:
+    Summary m_summary;
+    /// @brief The functions each function calls directly.
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_callees;
+    Globals *m_writes = nullptr;
+    std::unordered_set<std::string> *m_calls = nullptr;
+
+  public:
+    ~SideEffectAnalyzer() = default;
+    SideEffectAnalyzer() = default;
+
+    Summary analyze(ProgramNode &p_program);
+
+    void visit(FunctionNode &p_function) override;
+    void visit(CompoundStatementNode &p_compound_statement) override;
+    void visit(PrintNode &p_print) override;
+    void visit(BinaryOperatorNode &p_bin_op) override;
+    void visit(UnaryOperatorNode &p_un_op) override;
+    void visit(FunctionInvocationNode &p_func_invocation) override;
+    void visit(VariableReferenceNode &p_variable_ref) override;
+    void visit(AssignmentNode &p_assignment) override;
+    void visit(ReadNode &p_read) override;
+    void visit(IfNode &p_if) override;
+    void visit(WhileNode &p_while) override;
+    void visit(ForNode &p_for) override;
+    void visit(ReturnNode &p_return) override;
+
+  private:
+    void write(const VariableReferenceNode &p_target);
+};
+
+#endif
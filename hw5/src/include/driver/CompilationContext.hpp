@@ -0,0 +1,86 @@
+#ifndef DRIVER_COMPILATION_CONTEXT_H
+#define DRIVER_COMPILATION_CONTEXT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "AST/AstArena.hpp"
+#include "AST/PTypeContext.hpp"
+#include "util/SourceBuffer.hpp"
+
+class AstNode;
+
+/// @brief Everything the compilation of one source file owns: the source,
+/// the reentrant scanner and parser state, the AST, and the types.
+///
+/// No two contexts share any state, so independent files can be compiled at
+/// the same time, one context per thread.
+class CompilationContext {
+  public:
+    /// @brief What the scanner carries from one token to the next.
+    struct ScannerState {
+        uint32_t line_num = 1;
+        uint32_t col_num = 1;
+        /// Turned on or off by the pseudocomments `//&S`, `//&T`, and `//&D`.
+        bool list_source = true;
+        bool list_tokens = true;
+        bool dump_symbols = true;
+        /// A bad character ends the scan; it is reported by the scanner.
+        bool has_lexical_error = false;
+    };
+
+  private:
+    std::string m_source_path;
+    /// @brief Where the listing, the dumps, and the verdict are printed.
+    std::FILE *m_listing_file;
+    /// @brief Where the errors are printed.
+    std::FILE *m_diagnostic_file;
+    SourceBuffer m_source;
+    PTypeContext m_type_context;
+    AstArena m_ast_arena;
+    /// @brief The flex scanner (`yyscan_t`); `nullptr` until opened.
+    void *m_scanner = nullptr;
+    ScannerState m_scanner_state;
+    /// @brief Lives in `m_ast_arena`, along with all it owns.
+    AstNode *m_root = nullptr;
+
+  public:
+    ~CompilationContext();
+    /// @note The files are not owned and have to stay open as long as the
+    /// context.
+    explicit CompilationContext(const std::string &p_source_path,
+                                std::FILE *p_listing_file = stdout,
+                                std::FILE *p_diagnostic_file = stderr)
+        : m_source_path(p_source_path), m_listing_file(p_listing_file),
+          m_diagnostic_file(p_diagnostic_file) {}
+
+    CompilationContext(const CompilationContext &) = delete;
+    CompilationContext &operator=(const CompilationContext &) = delete;
+
+    /// @return `false` with `errno` set if the source cannot be read.
+    bool open();
+    /// @brief Builds the AST from the opened source, printing the listing
+    /// and the first lexical or syntax error.
+    /// @return `false` on an error.
+    /// @note The nodes are allocated from the arena of this context, whatever
+    /// the current arena of the thread is.
+    bool parse();
+
+    const std::string &getSourcePath() const { return m_source_path; }
+    std::FILE *getListingFile() const { return m_listing_file; }
+    std::FILE *getDiagnosticFile() const { return m_diagnostic_file; }
+    const SourceBuffer &getSource() const { return m_source; }
+    SourceBuffer &getSource() { return m_source; }
+    PTypeContext &getTypeContext() { return m_type_context; }
+    const AstArena &getAstArena() const { return m_ast_arena; }
+    AstArena &getAstArena() { return m_ast_arena; }
+    ScannerState &getScannerState() { return m_scanner_state; }
+    const ScannerState &getScannerState() const { return m_scanner_state; }
+
+    /// @return `nullptr` until parsed.
+    AstNode *getRoot() const { return m_root; }
+    void setRoot(AstNode *p_root) { m_root = p_root; }
+};
+
+#endif
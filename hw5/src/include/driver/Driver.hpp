@@ -0,0 +1,65 @@
+#ifndef DRIVER_DRIVER_H
+#define DRIVER_DRIVER_H
+
+#include "codegen/CodeGenOptions.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @brief Runs the whole pipeline, from the source to the assembly, on one
+/// file or on a batch of them.
+class Driver {
+  public:
+    /// @brief What to do with each file, as given on the command line.
+    struct Options {
+        /// @brief The directory of the `.S` files; the current one if empty.
+        std::string save_path;
+        bool dump_ast = false;
+        bool dump_ir = false;
+        bool ir_codegen = false;
+        bool ast_stats = false;
+        bool peephole_stats = false;
+        /// @brief Prints what the dead code elimination removed from each
+        /// function.
+        bool dce_report = false;
+        /// @brief Prints what the inliner did with each invocation, and why.
+        bool inline_report = false;
+        /// @brief The threads that work on the functions of a file.
+        std::size_t num_threads = 1;
+        CodeGenOptions codegen;
+    };
+
+  private:
+    Options m_options;
+
+  public:
+    ~Driver() = default;
+    explicit Driver(const Options &p_options) : m_options(p_options) {}
+
+    /// @brief Compiles a file, printing what `stdout` and `stderr` would get
+    /// to `p_listing_file` and `p_diagnostic_file`.
+    /// @return The exit status: `0` unless the file cannot be read or parsed,
+    /// or the IR is broken. Semantic errors alone still count as `0`.
+    int compile(const std::string &p_source_path, std::FILE *p_listing_file,
+                std::FILE *p_diagnostic_file) const;
+
+    /// @brief Compiles the files on `p_num_jobs` threads.
+    ///
+    /// The output of each file is buffered and written to `stdout` and
+    /// `stderr` in the order of `p_source_paths` once the file is done, so it
+    /// is the same as compiling them one after another.
+    /// @return The first nonzero exit status, or `0`.
+    int compileAll(const std::vector<std::string> &p_source_paths,
+                   std::size_t p_num_jobs) const;
+
+  private:
+    /// @return The first pair of files that would overwrite each other's
+    /// output, as indices; both are equal if there is none.
+    std::pair<std::size_t, std::size_t> findOutputCollision(
+        const std::vector<std::string> &p_source_paths) const;
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef IR_IR_BASIC_BLOCK_H
+#define IR_IR_BASIC_BLOCK_H
+
+#include <vector>
+
+#include "ir/IrInstruction.hpp"
+
+/// @brief A straight-line sequence of instructions; only the last one may be
+/// a terminator.
+class IrBasicBlock {
+  private:
+    int m_id;
+    std::vector<IrInstruction> m_instructions;
+
+  public:
+    ~IrBasicBlock() = default;
+    IrBasicBlock(const int p_id) : m_id(p_id) {}
+
+    int getId() const { return m_id; }
+
+    std::vector<IrInstruction> &getInstructions() { return m_instructions; }
+    const std::vector<IrInstruction> &getInstructions() const {
+        return m_instructions;
+    }
+
+    /// @pre The block is not terminated.
+    void append(IrInstruction p_instruction);
+
+    bool isTerminated() const {
+        return !m_instructions.empty() && m_instructions.back().isTerminator();
+    }
+    /// @return The ids of the blocks the terminator may branch to; empty if
+    /// the block returns or is not terminated.
+    std::vector<int> getSuccessors() const;
+};
+
+#endif
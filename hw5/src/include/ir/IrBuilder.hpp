@@ -0,0 +1,84 @@
+#ifndef IR_IR_BUILDER_H
+#define IR_IR_BUILDER_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ir/IrModule.hpp"
+#include "sema/SymbolTable.hpp"
+#include "visitor/AstNodeVisitor.hpp"
+
+class ExpressionNode;
+class VariableReferenceNode;
+
+/// @brief Lowers a semantically checked AST into three-address IR.
+///
+/// Variables are found by the symbol entries that the semantic analyzer
+/// recorded on the declarations and the references.
+///
+/// Every local variable and parameter gets a slot, which is read by `load`
+/// and written by `store`; the temps only carry the values of expressions.
+/// Statements after a `return` go into a new block without predecessors.
+class IrBuilder final : public AstNodeVisitor {
+  private:
+    std::unique_ptr<IrModule> m_module;
+    /// @brief The slot or global of each variable.
+    std::unordered_map<const SymbolEntry *, IrOperand> m_homes;
+    IrFunction *m_function = nullptr;
+    IrBasicBlock *m_block = nullptr;
+
+    /// @brief The value of the last lowered expression.
+    IrOperand m_result;
+    /// @brief The nesting depth of `lower()`; a function invocation at depth
+    /// 0 is a call statement whose return value is discarded.
+    int m_expression_depth = 0;
+
+  public:
+    ~IrBuilder() = default;
+    IrBuilder() = default;
+
+    /// @param p_program The root `ProgramNode`.
+    std::unique_ptr<IrModule> build(const std::string &p_source_file_path,
+                                    AstNode &p_program);
+
+    void visit(ProgramNode &p_program) override;
+    void visit(DeclNode &p_decl) override;
+    void visit(VariableNode &p_variable) override;
+    void visit(ConstantValueNode &p_constant_value) override;
+    void visit(FunctionNode &p_function) override;
+    void visit(CompoundStatementNode &p_compound_statement) override;
+    void visit(PrintNode &p_print) override;
+    void visit(BinaryOperatorNode &p_bin_op) override;
+    void visit(UnaryOperatorNode &p_un_op) override;
+    void visit(FunctionInvocationNode &p_func_invocation) override;
+    void visit(VariableReferenceNode &p_variable_ref) override;
+    void visit(AssignmentNode &p_assignment) override;
+    void visit(ReadNode &p_read) override;
+    void visit(IfNode &p_if) override;
+    void visit(WhileNode &p_while) override;
+    void visit(ForNode &p_for) override;
+    void visit(ReturnNode &p_return) override;
+
+  private:
+    IrOperand lower(const ExpressionNode &p_expr);
+    /// @return The slot or global that holds the variable.
+    IrOperand getHome(const VariableReferenceNode &p_variable_ref) const;
+
+    /// @brief Appends to the current block; starts a new one if the current
+    /// block is already terminated.
+    void append(IrInstruction p_instruction);
+    /// @return The temp that holds the result.
+    IrOperand appendWithResult(IrOpcode p_opcode, IrType p_type,
+                               std::vector<IrOperand> p_operands);
+    void appendJump(const IrBasicBlock &p_target);
+    void appendBranch(IrOperand p_condition, const IrBasicBlock &p_true,
+                      const IrBasicBlock &p_false);
+    /// @brief Falls through into `p_block` if the current block is open.
+    void startBlock(IrBasicBlock *p_block);
+    /// @brief Returns from the end of the function if it is still open.
+    void finishFunction();
+};
+
+#endif
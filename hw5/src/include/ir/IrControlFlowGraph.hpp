@@ -0,0 +1,49 @@
+#ifndef IR_IR_CONTROL_FLOW_GRAPH_H
+#define IR_IR_CONTROL_FLOW_GRAPH_H
+
+#include <vector>
+
+#include "ir/IrFunction.hpp"
+
+/// @brief The predecessors and successors of the blocks of a function, and
+/// the reverse postorder of the blocks reachable from the entry.
+///
+/// @note A snapshot; rebuild it after changing the branches of the function.
+class IrControlFlowGraph {
+  private:
+    std::vector<std::vector<int>> m_predecessors;
+    std::vector<std::vector<int>> m_successors;
+    std::vector<int> m_reverse_postorder;
+    /// @brief The index of each block in the reverse postorder; -1 if the
+    /// block is unreachable.
+    std::vector<int> m_rpo_numbers;
+
+  public:
+    ~IrControlFlowGraph() = default;
+    IrControlFlowGraph(const IrFunction &p_function);
+
+    std::size_t getNumBlocks() const { return m_successors.size(); }
+    /// @note Each block appears once, even if reached by both arms of a
+    /// branch.
+    const std::vector<int> &getPredecessors(const int p_block) const {
+        return m_predecessors[p_block];
+    }
+    const std::vector<int> &getSuccessors(const int p_block) const {
+        return m_successors[p_block];
+    }
+
+    const std::vector<int> &getReversePostorder() const {
+        return m_reverse_postorder;
+    }
+    int getRpoNumber(const int p_block) const { return m_rpo_numbers[p_block]; }
+    bool isReachable(const int p_block) const {
+        return m_rpo_numbers[p_block] != -1;
+    }
+
+    /// @brief Removes the blocks unreachable from the entry and renumbers the
+    /// rest, keeping their order.
+    /// @return The number of removed blocks.
+    static int removeUnreachableBlocks(IrFunction &p_function);
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef IR_IR_DOMINATOR_TREE_H
+#define IR_IR_DOMINATOR_TREE_H
+
+#include <vector>
+
+#include "ir/IrControlFlowGraph.hpp"
+
+/// @brief The dominator tree and the dominance frontiers of the reachable
+/// blocks, by the iterative algorithm of Cooper, Harvey, and Kennedy.
+class IrDominatorTree {
+  public:
+    static constexpr int kNoBlock = -1;
+
+  private:
+    std::vector<int> m_idoms;
+    std::vector<std::vector<int>> m_children;
+    std::vector<std::vector<int>> m_frontiers;
+    /// @brief The preorder and postorder numbers in the tree, which answer
+    /// `dominates()` in constant time.
+    std::vector<int> m_preorder_numbers;
+    std::vector<int> m_postorder_numbers;
+
+  public:
+    ~IrDominatorTree() = default;
+    IrDominatorTree(const IrControlFlowGraph &p_cfg);
+
+    /// @return `kNoBlock` for the entry and the unreachable blocks.
+    int getImmediateDominator(const int p_block) const {
+        return m_idoms[p_block];
+    }
+    /// @note In the order of the block ids.
+    const std::vector<int> &getChildren(const int p_block) const {
+        return m_children[p_block];
+    }
+    const std::vector<int> &getFrontier(const int p_block) const {
+        return m_frontiers[p_block];
+    }
+    /// @return Whether every path from the entry to `p_block` goes through
+    /// `p_dominator`. A block dominates itself.
+    /// @pre Both blocks are reachable.
+    bool dominates(int p_dominator, int p_block) const;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef IR_IR_FUNCTION_H
+#define IR_IR_FUNCTION_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ir/IrBasicBlock.hpp"
+#include "ir/IrInstruction.hpp"
+
+/// @brief A local variable, parameter, or loop variable that lives in the
+/// stack frame.
+struct IrSlot {
+    std::string name;
+    IrType type;
+};
+
+/// @brief A function in three-address form. The first block is the entry;
+/// the first `getNumParameters()` slots hold the parameters on entry.
+class IrFunction {
+  private:
+    std::string m_name;
+    IrType m_return_type;
+    std::size_t m_num_parameters = 0;
+    std::vector<IrSlot> m_slots;
+    std::vector<IrType> m_temp_types;
+    std::vector<std::unique_ptr<IrBasicBlock>> m_blocks;
+
+  public:
+    ~IrFunction() = default;
+    IrFunction(const std::string &p_name, const IrType p_return_type)
+        : m_name(p_name), m_return_type(p_return_type) {}
+
+    const std::string &getName() const { return m_name; }
+    const char *getNameCString() const { return m_name.c_str(); }
+    IrType getReturnType() const { return m_return_type; }
+
+    /// @pre No local slot is added yet.
+    int addParameter(const IrSlot &p_slot);
+    int addSlot(const IrSlot &p_slot);
+    std::size_t getNumParameters() const { return m_num_parameters; }
+    const std::vector<IrSlot> &getSlots() const { return m_slots; }
+
+    /// @return The id of the new temp.
+    int newTemp(IrType p_type);
+    std::size_t getNumTemps() const { return m_temp_types.size(); }
+    IrType getTempType(const int p_id) const { return m_temp_types[p_id]; }
+
+    /// @note Block ids are the indices in `getBlocks()`.
+    IrBasicBlock *newBlock();
+    std::vector<std::unique_ptr<IrBasicBlock>> &getBlocks() { return m_blocks; }
+    const std::vector<std::unique_ptr<IrBasicBlock>> &getBlocks() const {
+        return m_blocks;
+    }
+    IrBasicBlock &getBlock(const int p_id) { return *m_blocks[p_id]; }
+    const IrBasicBlock &getBlock(const int p_id) const {
+        return *m_blocks[p_id];
+    }
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef IR_IR_INSTRUCTION_H
+#define IR_IR_INSTRUCTION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief The type of an IR value. Every value fits in a word.
+enum class IrType : uint8_t { kVoid, kInt, kBool };
+
+/// @brief An operand of a three-address instruction.
+struct IrOperand {
+    enum class Kind : uint8_t {
+        kNone,
+        /// A virtual register (`%n`), defined by exactly one instruction.
+        kTemp,
+        kImmediate,
+        /// A stack slot of a local variable or parameter (`$n`).
+        kSlot,
+        /// A global variable or constant (`@n`).
+        kGlobal
+    };
+
+    Kind kind = Kind::kNone;
+    /// The temp, slot, or global index; or the immediate value.
+    int value = 0;
+
+    static IrOperand temp(const int p_id) { return {Kind::kTemp, p_id}; }
+    static IrOperand immediate(const int p_value) {
+        return {Kind::kImmediate, p_value};
+    }
+    static IrOperand slot(const int p_index) { return {Kind::kSlot, p_index}; }
+    static IrOperand global(const int p_index) {
+        return {Kind::kGlobal, p_index};
+    }
+
+    bool isTemp() const { return kind == Kind::kTemp; }
+    bool isImmediate() const { return kind == Kind::kImmediate; }
+    bool isSlot() const { return kind == Kind::kSlot; }
+    bool isGlobal() const { return kind == Kind::kGlobal; }
+
+    bool operator==(const IrOperand &p_other) const {
+        return kind == p_other.kind && value == p_other.value;
+    }
+    bool operator!=(const IrOperand &p_other) const {
+        return !(*this == p_other);
+    }
+};
+
+enum class IrOpcode : uint8_t {
+    // dst = operands[0] op operands[1]
+    kAdd,
+    kSub,
+    kMul,
+    kDiv,
+    kRem,
+    kAnd,
+    kOr,
+    kEq,
+    kNe,
+    kLt,
+    kLe,
+    kGt,
+    kGe,
+    // dst = op operands[0]
+    kNeg,
+    kNot,
+    kCopy,
+    /// dst = the content of the slot or global operands[0]
+    kLoad,
+    /// The slot or global operands[0] = operands[1]
+    kStore,
+    /// [dst =] callee(operands...)
+    kCall,
+    kPrint,
+    /// dst = the integer read from the standard input
+    kRead,
+    /// dst = the value of the parameter operands[0] (an immediate) on entry
+    kParam,
+    /// dst = operands[i] if control comes from targets[i]; only at the start
+    /// of a block
+    kPhi,
+    // Terminators
+    /// if operands[0] goto targets[0] else goto targets[1]
+    kBr,
+    /// goto targets[0]
+    kJmp,
+    /// return [operands[0]]
+    kRet
+};
+
+/// @brief A three-address instruction. Its result, if any, is a new temp.
+struct IrInstruction {
+    static constexpr int kNoTemp = -1;
+
+    IrOpcode opcode;
+    IrType type = IrType::kVoid;
+    int dst = kNoTemp;
+    std::vector<IrOperand> operands;
+    /// The block ids a terminator branches to; the incoming blocks of a phi.
+    std::vector<int> targets;
+    std::string callee;
+
+    bool hasResult() const { return dst != kNoTemp; }
+    bool isTerminator() const {
+        return opcode == IrOpcode::kBr || opcode == IrOpcode::kJmp ||
+               opcode == IrOpcode::kRet;
+    }
+    bool isBinary() const { return opcode <= IrOpcode::kGe; }
+    bool isComparison() const {
+        return opcode >= IrOpcode::kEq && opcode <= IrOpcode::kGe;
+    }
+    bool isUnary() const {
+        return opcode == IrOpcode::kNeg || opcode == IrOpcode::kNot ||
+               opcode == IrOpcode::kCopy;
+    }
+    /// @brief Whether removing the instruction could change the behavior
+    /// of the program, even if its result is unused.
+    bool hasSideEffects() const {
+        return opcode == IrOpcode::kStore || opcode == IrOpcode::kCall ||
+               opcode == IrOpcode::kPrint || opcode == IrOpcode::kRead ||
+               isTerminator();
+    }
+
+    static const char *getOpcodeCString(IrOpcode p_opcode);
+};
+
+const char *getIrTypeCString(IrType p_type);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef IR_IR_MODULE_H
+#define IR_IR_MODULE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ir/IrFunction.hpp"
+#include "ir/IrInstruction.hpp"
+
+struct IrGlobal {
+    std::string name;
+    IrType type;
+    bool is_constant;
+    /// The value of a constant; 0 for a variable.
+    int initial_value;
+};
+
+/// @brief The IR of a whole program. The body of the program is lowered into
+/// the function `main`, which comes last.
+class IrModule {
+  private:
+    std::string m_source_file_path;
+    std::vector<IrGlobal> m_globals;
+    std::vector<std::unique_ptr<IrFunction>> m_functions;
+
+  public:
+    ~IrModule() = default;
+    IrModule(const std::string &p_source_file_path)
+        : m_source_file_path(p_source_file_path) {}
+
+    const std::string &getSourceFilePath() const { return m_source_file_path; }
+
+    int addGlobal(const IrGlobal &p_global);
+    const std::vector<IrGlobal> &getGlobals() const { return m_globals; }
+
+    IrFunction *addFunction(std::unique_ptr<IrFunction> p_function);
+    std::vector<std::unique_ptr<IrFunction>> &getFunctions() {
+        return m_functions;
+    }
+    const std::vector<std::unique_ptr<IrFunction>> &getFunctions() const {
+        return m_functions;
+    }
+};
+
+#endif
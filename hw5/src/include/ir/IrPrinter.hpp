@@ -0,0 +1,38 @@
+#ifndef IR_IR_PRINTER_H
+#define IR_IR_PRINTER_H
+
+#include <cstdio>
+
+#include "ir/IrFunction.hpp"
+#include "ir/IrInstruction.hpp"
+#include "ir/IrModule.hpp"
+
+/// @brief Dumps the IR in a human-readable form, e.g.,
+///
+///     define int @sum($0 a: int, $1 b: int) {
+///     bb0:
+///       %0:int = load $0
+///       %1:int = load $1
+///       %2:int = add %0, %1
+///       ret %2
+///     }
+///
+/// `%n` is a temp, `$n` a slot, and `@name` a global or function.
+class IrPrinter {
+  private:
+    FILE *m_out;
+    const IrModule *m_module = nullptr;
+
+  public:
+    ~IrPrinter() = default;
+    IrPrinter(FILE *p_out) : m_out(p_out) {}
+
+    void print(const IrModule &p_module);
+    void print(const IrFunction &p_function);
+
+  private:
+    void printOperand(const IrOperand &p_operand);
+    void printInstruction(const IrInstruction &p_instruction);
+};
+
+#endif
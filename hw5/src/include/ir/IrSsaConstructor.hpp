@@ -0,0 +1,61 @@
+#ifndef IR_IR_SSA_CONSTRUCTOR_H
+#define IR_IR_SSA_CONSTRUCTOR_H
+
+#include <cstddef>
+#include <vector>
+
+#include "ir/IrControlFlowGraph.hpp"
+#include "ir/IrDominatorTree.hpp"
+#include "ir/IrFunction.hpp"
+#include "ir/IrInstruction.hpp"
+
+/// @brief Puts a function into SSA form by promoting its slots to temps
+/// (mem2reg).
+///
+/// No slot has its address taken, so all of them are promoted: phis are
+/// placed on the iterated dominance frontiers of the stores of a slot that
+/// is live across blocks, then the loads and stores are replaced by the
+/// reaching values in a walk of the dominator tree. A parameter enters as a
+/// `param`; a local that is read before written reads 0. Phis that turn out
+/// dead or trivial are removed at the end.
+///
+/// @pre The entry block has no predecessors.
+class IrSsaConstructor {
+  public:
+    struct Statistics {
+        std::size_t num_removed_blocks = 0;
+        std::size_t num_promoted_slots = 0;
+        std::size_t num_removed_loads = 0;
+        std::size_t num_removed_stores = 0;
+        std::size_t num_phis = 0;
+    };
+
+  private:
+    IrFunction *m_function = nullptr;
+    Statistics m_statistics;
+
+    /// @brief The slot of each phi inserted, by its temp; -1 for the other
+    /// temps.
+    std::vector<int> m_phi_slots;
+    /// @brief What each removed load or phi is replaced by, by its temp;
+    /// `kNone` if it is kept.
+    std::vector<IrOperand> m_replacements;
+
+  public:
+    ~IrSsaConstructor() = default;
+    IrSsaConstructor() = default;
+
+    void run(IrFunction &p_function);
+
+    /// @brief The statistics of all functions run so far.
+    const Statistics &getStatistics() const { return m_statistics; }
+
+  private:
+    void insertPhis(const IrControlFlowGraph &p_cfg,
+                    const IrDominatorTree &p_dom_tree);
+    void rename(const IrControlFlowGraph &p_cfg,
+                const IrDominatorTree &p_dom_tree);
+    void removeUselessPhis();
+};
+
+#endif
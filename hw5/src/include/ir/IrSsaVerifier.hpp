@@ -0,0 +1,20 @@
+#ifndef IR_IR_SSA_VERIFIER_H
+#define IR_IR_SSA_VERIFIER_H
+
+#include <string>
+#include <vector>
+
+#include "ir/IrFunction.hpp"
+
+/// @brief Checks that a function is well-formed and in SSA form.
+///
+/// Every block ends with its only terminator and is reachable; every temp is
+/// defined once, before any use on every path; phis lead their blocks and
+/// have one operand per predecessor; no slot is left.
+class IrSsaVerifier {
+  public:
+    /// @return The violations found; empty if the function is valid.
+    static std::vector<std::string> verify(const IrFunction &p_function);
+};
+
+#endif
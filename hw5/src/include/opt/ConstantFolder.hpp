@@ -0,0 +1,61 @@
+#ifndef OPT_CONSTANT_FOLDER_H
+#define OPT_CONSTANT_FOLDER_H
+
+#include <memory>
+
+#include "visitor/AstNodeVisitor.hpp"
+
+class AstNode;
+class ExpressionNode;
+
+/// @brief Evaluates the constant subexpressions of a checked AST, so that
+/// the code generators only see their values.
+///
+/// A reference to a scalar constant, global or local, is replaced by the
+/// value of the constant. An operator whose operands are all constants is
+/// replaced by its result, computed as the 32-bit instruction would at run
+/// time; a division by zero is left to the run time. Where only one operand
+/// is known, the identities `x + 0`, `x - 0`, `x * 1`, `x / 1`,
+/// `x and true`, `x or false`, `- - x`, and `not not x` are replaced by `x`,
+/// and `x * 0`, `x mod 1`, `x and false`, and `x or true` by the constant,
+/// as long as `x` contains no function invocation.
+class ConstantFolder final : public AstNodeVisitor {
+  private:
+    /// @brief What the expression just visited is replaced with; `nullptr`
+    /// to keep it.
+    std::unique_ptr<ExpressionNode> m_replacement;
+    /// @brief Whether the expression just visited invokes a function.
+    bool m_has_call = false;
+
+  public:
+    ~ConstantFolder() = default;
+    ConstantFolder() = default;
+
+    /// @pre `p_root` is free of semantic errors, and an `AstArena` is
+    /// current, which the new nodes are allocated from.
+    void run(AstNode &p_root);
+
+    void visit(ProgramNode &p_program) override;
+    void visit(FunctionNode &p_function) override;
+    void visit(CompoundStatementNode &p_compound_statement) override;
+    void visit(PrintNode &p_print) override;
+    void visit(BinaryOperatorNode &p_bin_op) override;
+    void visit(UnaryOperatorNode &p_un_op) override;
+    void visit(FunctionInvocationNode &p_func_invocation) override;
+    void visit(VariableReferenceNode &p_variable_ref) override;
+    void visit(AssignmentNode &p_assignment) override;
+    void visit(ReadNode &p_read) override;
+    void visit(IfNode &p_if) override;
+    void visit(WhileNode &p_while) override;
+    void visit(ForNode &p_for) override;
+    void visit(ReturnNode &p_return) override;
+
+  private:
+    /// @brief Folds `p_expr` and its subexpressions, replacing it if needed.
+    /// @return Whether `p_expr` invokes a function.
+    bool fold(std::unique_ptr<ExpressionNode> &p_expr);
+    /// @brief Replaces the visited expression `p_expr` with a constant.
+    void replaceWithConstant(const ExpressionNode &p_expr, int p_value);
+};
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef OPT_DEAD_CODE_ELIMINATOR_H
+#define OPT_DEAD_CODE_ELIMINATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "visitor/AstNodeVisitor.hpp"
+
+class AstNode;
+class ExpressionNode;
+class SymbolEntry;
+
+/// @brief Removes the statements and locals of a checked AST that cannot
+/// affect the output.
+///
+/// Three kinds of code go away:
+/// - unreachable statements: the ones after a `return` (or after anything
+///   that never completes, such as an `if` whose branches all return), the
+///   branch an `if` with a constant condition never takes, and a `while`
+///   whose condition is `false`;
+/// - dead stores: assignments to a scalar local or parameter whose value is
+///   never read afterwards. A call in the value is kept for its side
+///   effects: the assignment becomes a call statement if the value is a
+///   call, and stays as it is otherwise;
+/// - unused locals: the declarations of the locals (constants included) that
+///   are no longer referenced, which frees their slots.
+///
+/// Which locals are live is computed backwards over the structured body; the
+/// body of a loop is visited until the locals live at its head stop
+/// changing.
+class DeadCodeEliminator final : public AstNodeVisitor {
+  public:
+    /// @brief What was removed from one function, or from the main program.
+    struct Report {
+        std::string function;
+        std::size_t unreachable_statements = 0;
+        std::size_t dead_stores = 0;
+        std::size_t unused_locals = 0;
+    };
+
+  private:
+    using Entries = std::unordered_set<const SymbolEntry *>;
+
+    std::vector<Report> m_reports;
+    /// @brief The locals that may be read after the statement being visited.
+    Entries m_live;
+    /// @brief The symbols referenced by the code that is kept.
+    Entries m_referenced;
+    /// @brief The compound statements that are kept, whose declarations are
+    /// pruned once the whole function is done.
+    std::vector<CompoundStatementNode *> m_scopes;
+    /// @brief The locals found live at the head of each loop of the function
+    /// so far, by the body of the loop.
+    std::unordered_map<const CompoundStatementNode *, Entries>
+        m_live_at_loop_heads;
+    /// @brief The number of loop bodies being visited only to find the live
+    /// locals at their heads; nothing is removed while positive.
+    int m_num_dry_runs = 0;
+    /// @brief Whether the statement just visited is removed.
+    bool m_is_dead = false;
+    /// @brief What the statement just visited is replaced with; `nullptr` to
+    /// keep it.
+    std::unique_ptr<AstNode> m_replacement;
+
+  public:
+    ~DeadCodeEliminator() = default;
+    DeadCodeEliminator() = default;
+
+    /// @pre `p_root` is free of semantic errors.
+    void run(AstNode &p_root);
+
+    /// @return A report for each function in order, then the main program,
+    /// which is named `main`.
+    const std::vector<Report> &getReports() const { return m_reports; }
+
+    void visit(ProgramNode &p_program) override;
+    void visit(FunctionNode &p_function) override;
+    void visit(CompoundStatementNode &p_compound_statement) override;
+    void visit(PrintNode &p_print) override;
+    void visit(BinaryOperatorNode &p_bin_op) override;
+    void visit(UnaryOperatorNode &p_un_op) override;
+    void visit(FunctionInvocationNode &p_func_invocation) override;
+    void visit(VariableReferenceNode &p_variable_ref) override;
+    void visit(AssignmentNode &p_assignment) override;
+    void visit(ReadNode &p_read) override;
+    void visit(IfNode &p_if) override;
+    void visit(WhileNode &p_while) override;
+    void visit(ForNode &p_for) override;
+    void visit(ReturnNode &p_return) override;
+
+  private:
+    bool isDryRun() const { return m_num_dry_runs > 0; }
+    /// @return Whether the value of the symbol is tracked: the scalar locals
+    /// and parameters of the function.
+    static bool isTracked(const SymbolEntry *p_entry);
+    /// @return Whether control may reach the statement after `p_statement`.
+    static bool canFallThrough(const AstNode &p_statement);
+
+    void eliminate(CompoundStatementNode &p_body, const std::string &p_name);
+    /// @brief Marks the locals read by `p_expr` live.
+    void use(ExpressionNode &p_expr);
+    /// @brief Visits a loop body until the locals live at the head are
+    /// found, then once more to remove its dead code.
+    /// @param p_live_at_head What is live at the head besides the body: the
+    /// locals live after the loop and the ones its condition reads.
+    void visitLoop(CompoundStatementNode &p_body, Entries p_live_at_head);
+    void removeUnusedLocals(Report &p_report);
+};
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef OPT_FUNCTION_INLINER_H
+#define OPT_FUNCTION_INLINER_H
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "AST/ast.hpp"
+#include "codegen/SideEffectAnalyzer.hpp"
+#include "sema/SymbolTable.hpp"
+#include "visitor/AstNodeVisitor.hpp"
+
+class ExpressionNode;
+
+/// @brief Substitutes the bodies of small, non-recursive functions for the
+/// invocations of them in a checked AST.
+///
+/// The statement that invokes the function is replaced by a block that
+/// declares a copy of each parameter, a variable named after the function
+/// for the result, and the locals of the function; assigns the arguments to
+/// the parameters; runs a copy of the body whose `return` assigns the
+/// result; and then runs the statement with the invocation replaced by the
+/// result. The new blocks are inlined into in turn.
+///
+/// A statement may invoke several functions, so only the first one it
+/// invokes is inlined, and only if the globals the function may write are
+/// not read by the statement before the invocation; the next one is inlined
+/// from the new block. A function is inlined if:
+/// - it has a body and is not recursive, even through other functions;
+/// - its parameters, locals, and values are all integers or booleans;
+/// - it only returns at the end, which includes the ends of the branches of
+///   an `if` at the end;
+/// - the invocation is not the condition of a `while` loop, which would
+///   have to be evaluated on every iteration;
+/// - the body, in AST nodes, is larger than what the call costs by at most
+///   the threshold, or `kLoopThresholdFactor` times the threshold in a
+///   loop; and
+/// - the caller has grown by less than `kMaxCallerGrowth` nodes.
+class FunctionInliner final : public AstNodeVisitor {
+  public:
+    enum class Reason {
+        kInlined,
+        kNoBody,
+        kRecursive,
+        kUnsupportedType,
+        kEarlyReturn,
+        kLoopCondition,
+        kGlobalConflict,
+        kTooLarge,
+        kCallerBudget,
+        kAfterCall
+    };
+
+    /// @brief What was done with one invocation.
+    struct Report {
+        /// @brief The function the invocation ends up in, or `main`.
+        std::string caller;
+        std::string callee;
+        Location location;
+        Reason reason;
+        /// @brief The AST nodes of the body of the callee, and the nodes'
+        /// worth of instructions the call costs; both `0` if not measured.
+        int size;
+        int call_cost;
+    };
+
+    /// @brief The cost of a call without its arguments: the jump and the
+    /// return, and setting up and tearing down the frame of the callee.
+    static constexpr int kCallCost = 8;
+    /// @brief The cost of passing an argument: moving it to its register and
+    /// storing it in the frame of the callee.
+    static constexpr int kArgumentCost = 2;
+    static constexpr int kLoopThresholdFactor = 4;
+    static constexpr int kMaxCallerGrowth = 256;
+
+  private:
+    /// @brief The most nodes an invocation outside loops may add.
+    const int m_threshold;
+    /// @brief The functions with a body, by their names.
+    std::unordered_map<std::string, FunctionNode *> m_functions;
+    std::unordered_set<std::string> m_recursive_functions;
+    SideEffectAnalyzer::Summary m_side_effects;
+    /// @brief The entries of the variables declared by the new blocks.
+    std::deque<SymbolEntry> m_entries;
+    std::vector<Report> m_reports;
+
+    std::string m_caller;
+    /// @brief The nodes added to the caller so far.
+    int m_growth = 0;
+    int m_loop_depth = 0;
+    /// @brief The statement being visited, which is replaced by the block if
+    /// it is inlined into.
+    std::unique_ptr<AstNode> *m_statement = nullptr;
+
+  public:
+    ~FunctionInliner() = default;
+    /// @param p_threshold The most AST nodes that inlining an invocation
+    /// outside loops may add, beyond the cost of the call.
+    explicit FunctionInliner(int p_threshold) : m_threshold(p_threshold) {}
+
+    /// @pre `p_root` is free of semantic errors, and an `AstArena` is
+    /// current, which the new nodes are allocated from.
+    /// @note The inliner owns the entries of the new variables, which the
+    /// nodes refer to, so it has to be declared before whatever owns the AST
+    /// (see `Driver::compile()`).
+    void run(AstNode &p_root);
+
+    /// @return A report for each invocation, in the order they are visited.
+    const std::vector<Report> &getReports() const { return m_reports; }
+    static const char *getReasonText(Reason p_reason);
+
+    void visit(ProgramNode &p_program) override;
+    void visit(CompoundStatementNode &p_compound_statement) override;
+    void visit(PrintNode &p_print) override;
+    void visit(FunctionInvocationNode &p_func_invocation) override;
+    void visit(AssignmentNode &p_assignment) override;
+    void visit(ReadNode &p_read) override;
+    void visit(IfNode &p_if) override;
+    void visit(WhileNode &p_while) override;
+    void visit(ForNode &p_for) override;
+    void visit(ReturnNode &p_return) override;
+
+  private:
+    using Roots = std::vector<std::unique_ptr<ExpressionNode> *>;
+
+    void findRecursiveFunctions();
+    void inlineInto(CompoundStatementNode &p_body, const std::string &p_name);
+    /// @brief Inlines the first function that the statement being visited
+    /// invokes, and visits the block that replaces the statement.
+    /// @param p_roots The expressions of the statement, in the order they
+    /// are evaluated.
+    /// @param p_statement_call The statement if it is an invocation, which
+    /// is invoked after all of `p_roots`; `nullptr` otherwise.
+    /// @return Whether it is inlined.
+    bool inlineFirstCall(const Roots &p_roots,
+                         FunctionInvocationNode *p_statement_call);
+    Reason decide(const FunctionInvocationNode &p_call,
+                  const std::vector<const SymbolEntry *> &p_reads_before,
+                  Report &p_report) const;
+    /// @param p_slot Where the invocation is; `nullptr` if it is the
+    /// statement.
+    void substitute(FunctionInvocationNode &p_call,
+                    std::unique_ptr<ExpressionNode> *p_slot);
+    void report(const FunctionInvocationNode &p_call, Reason p_reason);
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define SEMA_ERROR_PRINTER_HPP
 
 #include "sema/Error.hpp"
+#include "util/SourceBuffer.hpp"
 #include <cstdio>
 
 class ErrorPrinter {
@@ -10,12 +11,17 @@ public:
   /// the source line that causes the error.
   void print(const Error &) const;
 
+  /// @param p_source The source the errors are in; has to outlive the printer.
   /// @param p_file The file to print the error to. The caller is responsible
   /// for ensuring the `p_file` is valid throughout the print and closing the
   /// `p_file` after use.
-  explicit ErrorPrinter(std::FILE *p_file);
+  ErrorPrinter(const SourceBuffer &p_source, std::FILE *p_file);
+
+  const SourceBuffer &getSource() const { return m_source; }
+  std::FILE *getFile() const { return m_file; }
 
 private:
+  const SourceBuffer &m_source;
   std::FILE *m_file;
 };
 
@@ -0,0 +1,34 @@
+#ifndef SEMA_NAME_POOL_H
+#define SEMA_NAME_POOL_H
+
+#include <string>
+#include <unordered_set>
+
+/// @brief Keeps one copy of each symbol name, so that names can be compared
+/// and hashed by address.
+class NamePool {
+  private:
+    /// NOTE: The elements of an unordered set never move.
+    std::unordered_set<std::string> m_names;
+
+  public:
+    ~NamePool() = default;
+    NamePool() = default;
+
+    NamePool(const NamePool &) = delete;
+    NamePool &operator=(const NamePool &) = delete;
+
+    /// @return The pooled copy of `p_name`, added if it is new.
+    const std::string *intern(const std::string &p_name) {
+        return &*m_names.insert(p_name).first;
+    }
+
+    /// @return The pooled copy of `p_name`; `nullptr` if it was never
+    /// interned, in which case no symbol has the name.
+    const std::string *find(const std::string &p_name) const {
+        const auto it = m_names.find(p_name);
+        return (it != m_names.end()) ? &*it : nullptr;
+    }
+};
+
+#endif
@@ -1,22 +1,23 @@
 #ifndef SEMA_SEMANTIC_ANALYZER_H
 #define SEMA_SEMANTIC_ANALYZER_H
 
+#include "AST/PTypeContext.hpp"
 #include "sema/ErrorPrinter.hpp"
 #include "sema/SymbolTable.hpp"
 #include "visitor/AstNodeInclude.hpp"
 #include "visitor/AstNodeVisitor.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <set>
 #include <stack>
-#include <unordered_map>
+#include <vector>
 
 class SemanticAnalyzer final : public AstNodeVisitor {
-  public:
-    using AstNodeAddr = const AstNode *;
-
   private:
+    static constexpr std::size_t kNumRunsPerThread = 4;
+
     enum class SemanticContext : uint8_t {
         kGlobal,
         kFunction,
@@ -25,13 +26,11 @@ class SemanticAnalyzer final : public AstNodeVisitor {
     };
 
   private:
+    const PTypeContext &m_type_context;
     SymbolManager m_symbol_manager;
-    /// @brief Four kinds of AST nodes opens a scope: program, function, loop, and
-    /// compound statement. The symbol table of the scope they opened is stored
-    /// and mapped back to the AST node. This is for the scope structure to be
-    /// reconstructed while generating code.
-    std::unordered_map<AstNodeAddr, SymbolManager::Table>
-        m_symbol_table_of_scoping_nodes;
+    /// @brief The tables of the closed scopes. They are kept alive since the
+    /// variable and reference nodes point to their entries.
+    std::vector<SymbolManager::Table> m_closed_scopes;
     std::stack<SemanticContext> m_context_stack;
     std::stack<const PType *> m_returned_type_stack;
 
@@ -39,21 +38,22 @@ class SemanticAnalyzer final : public AstNodeVisitor {
 
     bool m_has_error = false;
     ErrorPrinter m_error_printer;
+    std::FILE *m_dump_stream;
+    /// @brief The threads that analyze the bodies of the functions.
+    std::size_t m_num_threads = 1;
 
   public:
-    /// @return The symbol table of the AST nodes that open a scope: program,
-    /// function, loop, and compound statement. This is for the scope structure
-    /// to be reconstructed while generating code.
-    /// @note This function is called after the semantic analysis is done and can
-    /// only be called once.
-    std::unordered_map<AstNodeAddr, SymbolManager::Table> &&
-    acquireSymbolTableOfScopingNodes() {
-        return std::move(m_symbol_table_of_scoping_nodes);
-    }
-
     ~SemanticAnalyzer() = default;
-    SemanticAnalyzer(const bool p_opt_dmp, std::FILE *p_error_stream = stderr)
-        : m_symbol_manager(p_opt_dmp), m_error_printer(p_error_stream) {}
+    /// @param p_dump_stream Where the symbol tables are dumped if
+    /// `p_opt_dmp`.
+    SemanticAnalyzer(const PTypeContext &p_type_context,
+                     const SourceBuffer &p_source, const bool p_opt_dmp,
+                     std::FILE *p_error_stream = stderr,
+                     std::FILE *p_dump_stream = stdout)
+        : m_type_context(p_type_context),
+          m_symbol_manager(p_opt_dmp, p_dump_stream),
+          m_error_printer(p_source, p_error_stream),
+          m_dump_stream(p_dump_stream) {}
 
     void visit(ProgramNode &p_program) override;
     void visit(DeclNode &p_decl) override;
@@ -75,7 +75,29 @@ class SemanticAnalyzer final : public AstNodeVisitor {
 
     bool hasError() const { return m_has_error; }
 
+    /// @note The diagnostics and the dumps are the same for any number of
+    /// threads.
+    void setNumThreads(const std::size_t p_num_threads) {
+        m_num_threads = p_num_threads;
+    }
+
   private:
+    /// @brief Analyzes function bodies on top of the global table of
+    /// `p_parent`, which is only read.
+    SemanticAnalyzer(const SemanticAnalyzer &p_parent,
+                     std::FILE *p_error_stream, std::FILE *p_dump_stream);
+
+    /// @brief Declares the functions in order, then analyzes their bodies on
+    /// `m_num_threads` threads, each into buffers of its own that are
+    /// printed in order afterwards.
+    void analyzeFunctions(ProgramNode &p_program);
+    /// @return `false` if the name is already taken.
+    bool declareFunction(const FunctionNode &p_function);
+    /// @brief Analyzes the parameters and the body in a new scope.
+    void analyzeFunctionBody(FunctionNode &p_function);
+
+    /// @brief Pops the current scope and keeps its table alive.
+    void closeScope();
     /// @brief Prints the error and sets the error flag to `true`.
     /// @note Call this function instead of using the error printer directly.
     void printError(const Error&);
@@ -98,8 +120,7 @@ class SemanticAnalyzer final : public AstNodeVisitor {
         const FunctionInvocationNode::ExprNodes &p_arguments);
     /// @note Since there are multiple kinds of errors that can be reported on
     /// the lvalue, we report errors inside this function.
-    bool analyzeAssignmentLvalue(const AssignmentNode &p_assignment,
-                                  const SymbolManager &p_symbol_manager);
+    bool analyzeAssignmentLvalue(const AssignmentNode &p_assignment);
     /// @note Since there are multiple kinds of errors that can be reported on
     /// the expression, we report errors inside this function.
     bool analyzeAssignmentExpr(const AssignmentNode &p_assignment);
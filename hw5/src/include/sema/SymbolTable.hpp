@@ -3,13 +3,17 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <deque>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "AST/PType.hpp"
 #include "AST/constant.hpp"
 #include "AST/function.hpp"
+#include "sema/NamePool.hpp"
 
 /*
  * Conform to C++ Core Guidelines C.182
@@ -55,31 +59,27 @@ class SymbolEntry {
     size_t m_level;
     const PType *m_p_type;
     Attribute m_attribute;
-    int m_offset;
 
   public:
     ~SymbolEntry() = default;
 
     SymbolEntry(const std::string &p_name, const KindEnum p_kind,
                 const size_t p_level, const PType *const p_p_type,
-                const Constant *const p_constant, const int p_offset)
+                const Constant *const p_constant)
         : m_name(p_name),
           m_kind(p_kind),
           m_level(p_level),
           m_p_type(p_p_type),
-          m_attribute(p_constant),
-          m_offset(p_offset) {}
+          m_attribute(p_constant) {}
 
     SymbolEntry(const std::string &p_name, const KindEnum p_kind,
                 const size_t p_level, const PType *const p_p_type,
-                const FunctionNode::DeclNodes *const p_parameters,
-                const int p_offset)
+                const FunctionNode::DeclNodes *const p_parameters)
         : m_name(p_name),
           m_kind(p_kind),
           m_level(p_level),
           m_p_type(p_p_type),
-          m_attribute(p_parameters),
-          m_offset(p_offset) {}
+          m_attribute(p_parameters) {}
 
     const std::string &getName() const { return m_name; }
     const char *getNameCString() const { return m_name.c_str(); }
@@ -91,36 +91,54 @@ class SymbolEntry {
     const PType *getTypePtr() const { return m_p_type; }
 
     const Attribute &getAttribute() const { return m_attribute; }
-
-    const int getOffset() const { return m_offset; }
 };
 
+/// @brief The symbols of a scope, hashed by their interned names.
+///
+/// The entries are stored in the order of declaration, and none of them
+/// moves once added. The index is an open-addressing hash table with linear
+/// probing on the address of the name in the `NamePool`.
 class SymbolTable {
   private:
-    std::vector<std::unique_ptr<SymbolEntry>> m_entries;
+    static constexpr int kEmptySlot = -1;
+
+    std::shared_ptr<NamePool> m_names;
+    std::deque<SymbolEntry> m_entries;
+    /// @brief The indices in `m_entries`; the size is a power of two and at
+    /// least twice the number of entries.
+    std::vector<int> m_slots;
 
   public:
     ~SymbolTable() = default;
-    SymbolTable() = default;
+    SymbolTable(std::shared_ptr<NamePool> p_names)
+        : m_names(std::move(p_names)) {}
 
     /// @return `nullptr` if not found.
     const SymbolEntry *lookup(const std::string &p_name) const;
+    /// @param p_name A name from the `NamePool` of the table.
+    const SymbolEntry *lookup(const std::string *p_name) const;
+    /// @brief Looks up among the first `p_num_visible` entries only.
+    const SymbolEntry *lookup(const std::string *p_name,
+                              std::size_t p_num_visible) const;
 
     SymbolEntry *addSymbol(const std::string &p_name,
                            const SymbolEntry::KindEnum p_kind,
                            const size_t p_level, const PType *const p_p_type,
-                           const Constant *const p_constant,
-                           const int p_offset);
+                           const Constant *const p_constant);
     SymbolEntry *addSymbol(const std::string &p_name,
                            const SymbolEntry::KindEnum p_kind,
                            const size_t p_level, const PType *const p_p_type,
-                           const FunctionNode::DeclNodes *const p_parameters,
-                           const int p_offset);
-    void dump() const;
+                           const FunctionNode::DeclNodes *const p_parameters);
+    void dump(std::FILE *p_file) const;
 
-    const std::vector<std::unique_ptr<SymbolEntry>> &getEntries() const {
-        return m_entries;
-    }
+    const std::deque<SymbolEntry> &getEntries() const { return m_entries; }
+    const NamePool &getNamePool() const { return *m_names; }
+
+  private:
+    /// @brief Adds the last entry to the index.
+    void index();
+    /// @return The slot holding `p_name`, or the empty slot it would take.
+    std::size_t findSlot(const std::string *p_name) const;
 };
 
 class SymbolManager {
@@ -128,21 +146,36 @@ class SymbolManager {
     using Table = std::unique_ptr<SymbolTable>;
 
   private:
+    std::shared_ptr<NamePool> m_names = std::make_shared<NamePool>();
     std::vector<Table> m_tables;
-    int m_global_offset = -12;
-    int m_label_index = 1;
+    /// @brief The global table of another manager, read but never written,
+    /// which stands in as level 0; `nullptr` if the manager has its own.
+    const SymbolTable *m_outer_table = nullptr;
+    /// @brief The entries of `m_outer_table` in scope.
+    std::size_t m_num_visible_outer_entries = 0;
 
     const bool m_opt_dmp;
+    std::FILE *m_dump_file;
 
   public:
     ~SymbolManager() = default;
-    SymbolManager(const bool p_opt_dmp) : m_opt_dmp(p_opt_dmp) {}
+    /// @param p_dump_file Where the tables are dumped if `p_opt_dmp`.
+    SymbolManager(const bool p_opt_dmp, std::FILE *p_dump_file = stdout)
+        : m_opt_dmp(p_opt_dmp), m_dump_file(p_dump_file) {}
+    /// @brief A manager whose level 0 is `p_outer_table`, so that several of
+    /// them can work on top of one global table at the same time.
+    /// @note The scopes pushed start at level 1 and have their own name pool.
+    /// All the entries of the outer table are in scope until
+    /// `setNumVisibleOuterEntries()`.
+    SymbolManager(const SymbolTable &p_outer_table, const bool p_opt_dmp,
+                  std::FILE *p_dump_file)
+        : m_outer_table(&p_outer_table),
+          m_num_visible_outer_entries(p_outer_table.getEntries().size()),
+          m_opt_dmp(p_opt_dmp), m_dump_file(p_dump_file) {}
 
     // initial construction
     void pushScope();
     Table popScope();
-    /// @brief Pushes the given table as the new scope.
-    void pushScope(Table p_table);
 
     /// @tparam AttributeType `Constant` or `FunctionNode::DeclNodes`
     /// @return The entry of the added symbol; `nullptr` if already exists in
@@ -166,11 +199,13 @@ class SymbolManager {
     /// @note Overflows if no scope is pushed.
     size_t getCurrentLevel() const;
 
-    int getGlobalOffset() const { return m_global_offset; }
-
-    void setGlobalOffset(int p_offset) { m_global_offset = p_offset; }
+    bool isDumping() const { return m_opt_dmp; }
 
-    int getNewLabel() { return m_label_index++; }
+    /// @brief Puts only the first `p_num_visible` entries of the outer table
+    /// in scope, such as the ones declared before a function.
+    void setNumVisibleOuterEntries(const std::size_t p_num_visible) {
+        m_num_visible_outer_entries = p_num_visible;
+    }
 };
 
 #endif
@@ -0,0 +1,69 @@
+#ifndef UTIL_SOURCE_BUFFER_H
+#define UTIL_SOURCE_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief The content of a source file, mapped into memory and scanned in
+/// place by the lexer.
+///
+/// The content is followed by the two NUL bytes that `yy_scan_buffer()`
+/// expects. The lexer records where each line starts as it goes, so a line is
+/// handed out as a slice of the buffer instead of a copy.
+class SourceBuffer {
+  public:
+    /// @brief A range of the buffer; not NUL-terminated.
+    struct Slice {
+        const char *data;
+        std::size_t length;
+    };
+
+    ~SourceBuffer();
+    SourceBuffer() = default;
+
+    SourceBuffer(const SourceBuffer &) = delete;
+    SourceBuffer &operator=(const SourceBuffer &) = delete;
+
+    /// @return `false` with `errno` set if the file cannot be read.
+    bool open(const char *p_path);
+
+    /// @brief The buffer to pass to `yy_scan_buffer()`, which modifies it while
+    /// scanning but restores the source bytes.
+    char *getScanBuffer() { return m_data; }
+    /// @note Includes the two NUL bytes.
+    std::size_t getScanBufferSize() const { return m_size + kNumSentinels; }
+
+    /// @brief Records the start of the next line.
+    /// @param p_start Right after a newline in the buffer.
+    void addLineStart(const char *p_start) {
+        m_line_starts.push_back(static_cast<std::size_t>(p_start - m_data));
+    }
+    /// @return The number of lines seen so far.
+    std::size_t getNumLines() const { return m_line_starts.size(); }
+
+    /// @param p_line 1-based; has to be seen already.
+    /// @return The line without the newline.
+    Slice getLine(uint32_t p_line) const;
+    /// @return The last line seen up to `p_end`, which is in that line.
+    Slice getLastLineUpTo(const char *p_end) const;
+
+  private:
+    static constexpr std::size_t kNumSentinels = 2;
+
+    /// @brief The mapping, or `m_copy` if the file cannot be mapped.
+    char *m_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_mapped_size = 0;
+    std::vector<char> m_copy;
+    /// @brief The offset of each line, in order; line 1 starts at 0.
+    std::vector<std::size_t> m_line_starts{0};
+
+    /// @brief Maps a regular file of `m_size` bytes.
+    bool map(int p_fd);
+    /// @brief Copies what is left of a file that cannot be mapped, such as a
+    /// pipe.
+    bool copy(int p_fd);
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef UTIL_WORK_STEALING_POOL_H
+#define UTIL_WORK_STEALING_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief A fixed set of threads, each with its own queue of tasks.
+///
+/// The tasks are dealt to the queues in turn. A thread runs the tasks of its
+/// own queue from the front, in the order they were submitted, and once it
+/// runs out, steals from the back of the others, so a few long tasks do not
+/// hold up the short ones queued behind them.
+class WorkStealingPool {
+  public:
+    using Task = std::function<void()>;
+
+    /// @brief Runs the tasks left and joins the threads.
+    ~WorkStealingPool();
+    /// @param p_num_threads At least one thread is started.
+    explicit WorkStealingPool(std::size_t p_num_threads);
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    /// @note Tasks can only be submitted from outside the pool.
+    void submit(Task p_task);
+    /// @brief Blocks until every task submitted so far has run.
+    void wait();
+
+    std::size_t getNumThreads() const { return m_threads.size(); }
+
+  private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+    /// @brief The queue the next task is dealt to.
+    std::size_t m_next_queue = 0;
+
+    /// @brief Guards the counts below and the stop flag.
+    std::mutex m_mutex;
+    /// @brief Signaled when a task is queued or the pool stops.
+    std::condition_variable m_task_queued;
+    /// @brief Signaled when the last pending task has run.
+    std::condition_variable m_all_done;
+    /// @brief The tasks in the queues.
+    std::size_t m_num_queued = 0;
+    /// @brief The tasks in the queues or running.
+    std::size_t m_num_pending = 0;
+    bool m_is_stopping = false;
+
+    void run(std::size_t p_index);
+    /// @brief Takes a task from the front of queue `p_index`, or else from the
+    /// back of another one.
+    bool take(std::size_t p_index, Task &p_task);
+};
+
+#endif
@@ -0,0 +1,53 @@
+#include "AST/AstArena.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+constexpr std::size_t kAlignment = alignof(std::max_align_t);
+
+std::size_t alignUp(const std::size_t p_size) {
+    return (p_size + kAlignment - 1) / kAlignment * kAlignment;
+}
+}  // namespace
+
+thread_local AstArena *AstArena::s_current = nullptr;
+
+AstArena::~AstArena() {
+    if (s_current == this) {
+        s_current = nullptr;
+    }
+}
+
+AstArena &AstArena::getCurrentOrAbort() {
+    if (!s_current) {
+        std::fputs("AST storage is allocated with no arena current\n", stderr);
+        std::abort();
+    }
+    return *s_current;
+}
+
+void *AstArena::allocate(const std::size_t p_size) {
+    const std::size_t size = alignUp(p_size > 0 ? p_size : 1);
+    ++m_num_allocations;
+    m_num_bytes_allocated += size;
+
+    if (static_cast<std::size_t>(m_end - m_cursor) < size) {
+        // Storage larger than a quarter of a chunk gets a chunk of its own,
+        // which leaves the current chunk in use.
+        if (size > kChunkSize / 4) {
+            m_chunks.emplace_back(new char[size]);
+            m_num_bytes_reserved += size;
+            return m_chunks.back().get();
+        }
+        m_chunks.emplace_back(new char[kChunkSize]);
+        m_num_bytes_reserved += kChunkSize;
+        m_cursor = m_chunks.back().get();
+        m_end = m_cursor + kChunkSize;
+    }
+
+    void *const storage = m_cursor;
+    m_cursor += size;
+    return storage;
+}
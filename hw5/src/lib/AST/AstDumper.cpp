@@ -4,15 +4,15 @@
 #include <cstdio>
 
 void AstDumper::printIndent() const {
-    std::printf("%s", m_indenter.indent().c_str());
+    std::fprintf(m_file, "%s", m_indenter.indent().c_str());
 }
 
 void AstDumper::visit(ProgramNode &p_program) {
     printIndent();
 
-    std::printf("program <line: %u, col: %u> %s %s\n",
-                p_program.getLocation().line, p_program.getLocation().col,
-                p_program.getNameCString(), "void");
+    std::fprintf(m_file, "program <line: %u, col: %u> %s %s\n",
+                 p_program.getLocation().line, p_program.getLocation().col,
+                 p_program.getNameCString(), "void");
 
     m_indenter.increaseLevel();
     p_program.visitChildNodes(*this);
@@ -22,8 +22,8 @@ void AstDumper::visit(ProgramNode &p_program) {
 void AstDumper::visit(DeclNode &p_decl) {
     printIndent();
 
-    std::printf("declaration <line: %u, col: %u>\n", p_decl.getLocation().line,
-                p_decl.getLocation().col);
+    std::fprintf(m_file, "declaration <line: %u, col: %u>\n",
+                 p_decl.getLocation().line, p_decl.getLocation().col);
 
     m_indenter.increaseLevel();
     p_decl.visitChildNodes(*this);
@@ -33,9 +33,9 @@ void AstDumper::visit(DeclNode &p_decl) {
 void AstDumper::visit(VariableNode &p_variable) {
     printIndent();
 
-    std::printf("variable <line: %u, col: %u> %s %s\n",
-                p_variable.getLocation().line, p_variable.getLocation().col,
-                p_variable.getNameCString(), p_variable.getTypeCString());
+    std::fprintf(m_file, "variable <line: %u, col: %u> %s %s\n",
+                 p_variable.getLocation().line, p_variable.getLocation().col,
+                 p_variable.getNameCString(), p_variable.getTypeCString());
 
     m_indenter.increaseLevel();
     p_variable.visitChildNodes(*this);
@@ -45,18 +45,18 @@ void AstDumper::visit(VariableNode &p_variable) {
 void AstDumper::visit(ConstantValueNode &p_constant_value) {
     printIndent();
 
-    std::printf("constant <line: %u, col: %u> %s\n",
-                p_constant_value.getLocation().line,
-                p_constant_value.getLocation().col,
-                p_constant_value.getConstantValueCString());
+    std::fprintf(m_file, "constant <line: %u, col: %u> %s\n",
+                 p_constant_value.getLocation().line,
+                 p_constant_value.getLocation().col,
+                 p_constant_value.getConstantValueCString());
 }
 
 void AstDumper::visit(FunctionNode &p_function) {
     printIndent();
 
-    std::printf("function declaration <line: %u, col: %u> %s %s\n",
-                p_function.getLocation().line, p_function.getLocation().col,
-                p_function.getNameCString(), p_function.getPrototypeCString());
+    std::fprintf(m_file, "function declaration <line: %u, col: %u> %s %s\n",
+                 p_function.getLocation().line, p_function.getLocation().col,
+                 p_function.getNameCString(), p_function.getPrototypeCString());
 
     m_indenter.increaseLevel();
     p_function.visitChildNodes(*this);
@@ -66,9 +66,9 @@ void AstDumper::visit(FunctionNode &p_function) {
 void AstDumper::visit(CompoundStatementNode &p_compound_statement) {
     printIndent();
 
-    std::printf("compound statement <line: %u, col: %u>\n",
-                p_compound_statement.getLocation().line,
-                p_compound_statement.getLocation().col);
+    std::fprintf(m_file, "compound statement <line: %u, col: %u>\n",
+                 p_compound_statement.getLocation().line,
+                 p_compound_statement.getLocation().col);
 
     m_indenter.increaseLevel();
     p_compound_statement.visitChildNodes(*this);
@@ -78,8 +78,8 @@ void AstDumper::visit(CompoundStatementNode &p_compound_statement) {
 void AstDumper::visit(PrintNode &p_print) {
     printIndent();
 
-    std::printf("print statement <line: %u, col: %u>\n",
-                p_print.getLocation().line, p_print.getLocation().col);
+    std::fprintf(m_file, "print statement <line: %u, col: %u>\n",
+                 p_print.getLocation().line, p_print.getLocation().col);
 
     m_indenter.increaseLevel();
     p_print.visitChildNodes(*this);
@@ -89,9 +89,9 @@ void AstDumper::visit(PrintNode &p_print) {
 void AstDumper::visit(BinaryOperatorNode &p_bin_op) {
     printIndent();
 
-    std::printf("binary operator <line: %u, col: %u> %s\n",
-                p_bin_op.getLocation().line, p_bin_op.getLocation().col,
-                p_bin_op.getOpCString());
+    std::fprintf(m_file, "binary operator <line: %u, col: %u> %s\n",
+                 p_bin_op.getLocation().line, p_bin_op.getLocation().col,
+                 p_bin_op.getOpCString());
 
     m_indenter.increaseLevel();
     p_bin_op.visitChildNodes(*this);
@@ -101,9 +101,9 @@ void AstDumper::visit(BinaryOperatorNode &p_bin_op) {
 void AstDumper::visit(UnaryOperatorNode &p_un_op) {
     printIndent();
 
-    std::printf("unary operator <line: %u, col: %u> %s\n",
-                p_un_op.getLocation().line, p_un_op.getLocation().col,
-                p_un_op.getOpCString());
+    std::fprintf(m_file, "unary operator <line: %u, col: %u> %s\n",
+                 p_un_op.getLocation().line, p_un_op.getLocation().col,
+                 p_un_op.getOpCString());
 
     m_indenter.increaseLevel();
     p_un_op.visitChildNodes(*this);
@@ -113,10 +113,10 @@ void AstDumper::visit(UnaryOperatorNode &p_un_op) {
 void AstDumper::visit(FunctionInvocationNode &p_func_invocation) {
     printIndent();
 
-    std::printf("function invocation <line: %u, col: %u> %s\n",
-                p_func_invocation.getLocation().line,
-                p_func_invocation.getLocation().col,
-                p_func_invocation.getNameCString());
+    std::fprintf(m_file, "function invocation <line: %u, col: %u> %s\n",
+                 p_func_invocation.getLocation().line,
+                 p_func_invocation.getLocation().col,
+                 p_func_invocation.getNameCString());
 
     m_indenter.increaseLevel();
     p_func_invocation.visitChildNodes(*this);
@@ -126,10 +126,10 @@ void AstDumper::visit(FunctionInvocationNode &p_func_invocation) {
 void AstDumper::visit(VariableReferenceNode &p_variable_ref) {
     printIndent();
 
-    std::printf("variable reference <line: %u, col: %u> %s\n",
-                p_variable_ref.getLocation().line,
-                p_variable_ref.getLocation().col,
-                p_variable_ref.getNameCString());
+    std::fprintf(m_file, "variable reference <line: %u, col: %u> %s\n",
+                 p_variable_ref.getLocation().line,
+                 p_variable_ref.getLocation().col,
+                 p_variable_ref.getNameCString());
 
     m_indenter.increaseLevel();
     p_variable_ref.visitChildNodes(*this);
@@ -139,9 +139,9 @@ void AstDumper::visit(VariableReferenceNode &p_variable_ref) {
 void AstDumper::visit(AssignmentNode &p_assignment) {
     printIndent();
 
-    std::printf("assignment statement <line: %u, col: %u>\n",
-                p_assignment.getLocation().line,
-                p_assignment.getLocation().col);
+    std::fprintf(m_file, "assignment statement <line: %u, col: %u>\n",
+                 p_assignment.getLocation().line,
+                 p_assignment.getLocation().col);
 
     m_indenter.increaseLevel();
     p_assignment.visitChildNodes(*this);
@@ -151,8 +151,8 @@ void AstDumper::visit(AssignmentNode &p_assignment) {
 void AstDumper::visit(ReadNode &p_read) {
     printIndent();
 
-    std::printf("read statement <line: %u, col: %u>\n",
-                p_read.getLocation().line, p_read.getLocation().col);
+    std::fprintf(m_file, "read statement <line: %u, col: %u>\n",
+                 p_read.getLocation().line, p_read.getLocation().col);
 
     m_indenter.increaseLevel();
     p_read.visitChildNodes(*this);
@@ -162,8 +162,8 @@ void AstDumper::visit(ReadNode &p_read) {
 void AstDumper::visit(IfNode &p_if) {
     printIndent();
 
-    std::printf("if statement <line: %u, col: %u>\n", p_if.getLocation().line,
-                p_if.getLocation().col);
+    std::fprintf(m_file, "if statement <line: %u, col: %u>\n",
+                 p_if.getLocation().line, p_if.getLocation().col);
 
     m_indenter.increaseLevel();
     p_if.visitChildNodes(*this);
@@ -173,8 +173,8 @@ void AstDumper::visit(IfNode &p_if) {
 void AstDumper::visit(WhileNode &p_while) {
     printIndent();
 
-    std::printf("while statement <line: %u, col: %u>\n",
-                p_while.getLocation().line, p_while.getLocation().col);
+    std::fprintf(m_file, "while statement <line: %u, col: %u>\n",
+                 p_while.getLocation().line, p_while.getLocation().col);
 
     m_indenter.increaseLevel();
     p_while.visitChildNodes(*this);
@@ -184,8 +184,8 @@ void AstDumper::visit(WhileNode &p_while) {
 void AstDumper::visit(ForNode &p_for) {
     printIndent();
 
-    std::printf("for statement <line: %u, col: %u>\n", p_for.getLocation().line,
-                p_for.getLocation().col);
+    std::fprintf(m_file, "for statement <line: %u, col: %u>\n",
+                 p_for.getLocation().line, p_for.getLocation().col);
 
     m_indenter.increaseLevel();
     p_for.visitChildNodes(*this);
@@ -195,8 +195,8 @@ void AstDumper::visit(ForNode &p_for) {
 void AstDumper::visit(ReturnNode &p_return) {
     printIndent();
 
-    std::printf("return statement <line: %u, col: %u>\n",
-                p_return.getLocation().line, p_return.getLocation().col);
+    std::fprintf(m_file, "return statement <line: %u, col: %u>\n",
+                 p_return.getLocation().line, p_return.getLocation().col);
 
     m_indenter.increaseLevel();
     p_return.visitChildNodes(*this);
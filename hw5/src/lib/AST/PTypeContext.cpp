@@ -0,0 +1,44 @@
+#include "AST/PTypeContext.hpp"
+
+#include <cstddef>
+#include <functional>
+
+std::size_t PTypeContext::KeyHash::operator()(const Key &p_key) const {
+    std::size_t hash = static_cast<std::size_t>(p_key.first);
+    for (const auto dim : p_key.second) {
+        hash = hash * 31 + std::hash<uint64_t>()(dim);
+    }
+    return hash;
+}
+
+PTypeContext::PTypeContext() {
+    for (std::size_t i = 0; i < kNumPrimitiveTypes; ++i) {
+        auto &type = m_scalar_types[i];
+        type.reset(new PType(static_cast<PType::PrimitiveTypeEnum>(i), {}));
+        type->m_element_types = {type.get()};
+    }
+}
+
+const PType *PTypeContext::getType(const PType::PrimitiveTypeEnum p_type,
+                                   const std::vector<uint64_t> &p_dimensions) {
+    if (p_dimensions.empty()) {
+        return getType(p_type);
+    }
+
+    auto &type = m_array_types[Key{p_type, p_dimensions}];
+    if (type) {
+        return type.get();
+    }
+    type.reset(new PType(p_type, p_dimensions));
+
+    // The element types are interned along, so that subscripting looks
+    // nothing up.
+    PType *const array_type = type.get();
+    array_type->m_element_types.push_back(array_type);
+    for (std::size_t n = 1; n <= p_dimensions.size(); ++n) {
+        array_type->m_element_types.push_back(getType(
+            p_type, std::vector<uint64_t>(p_dimensions.begin() + n,
+                                          p_dimensions.end())));
+    }
+    return array_type;
+}
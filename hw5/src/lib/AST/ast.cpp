@@ -1,9 +1,15 @@
 #include <AST/ast.hpp>
 
+#include "AST/AstArena.hpp"
+
 // prevent the linker from complaining
 AstNode::~AstNode() {}
 
 AstNode::AstNode(const uint32_t line, const uint32_t col)
     : location(line, col) {}
 
+void *AstNode::operator new(const std::size_t p_size) {
+    return AstArena::getCurrentOrAbort().allocate(p_size);
+}
+
 const Location &AstNode::getLocation() const { return location; }
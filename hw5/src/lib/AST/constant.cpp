@@ -1,28 +1,32 @@
 #include "AST/constant.hpp"
 
+#include <string>
+
 static const char *kTFString[] = {"false", "true"};
 
-// logical constness
-const char *Constant::getConstantValueCString() const {
-    if (!m_constant_value_string_is_valid) {
-        switch (m_type->getPrimitiveType()) {
-        case PType::PrimitiveTypeEnum::kIntegerType:
-            m_constant_value_string = std::to_string(m_value.integer);
-            break;
-        case PType::PrimitiveTypeEnum::kRealType:
-            m_constant_value_string = std::to_string(m_value.real);
-            break;
-        case PType::PrimitiveTypeEnum::kBoolType:
-            m_constant_value_string = kTFString[m_value.boolean];
-            break;
-        case PType::PrimitiveTypeEnum::kStringType:
-            m_constant_value_string = m_value.string;
-            break;
-        case PType::PrimitiveTypeEnum::kVoidType:
-        default:
-            break;
-        }
-        m_constant_value_string_is_valid = true;
+Constant::Constant(const PType *const p_type, const ConstantValue value)
+    : m_type(p_type), m_value(value) {
+    switch (m_type->getPrimitiveType()) {
+    case PType::PrimitiveTypeEnum::kIntegerType:
+        m_constant_value_string = std::to_string(m_value.integer).c_str();
+        break;
+    case PType::PrimitiveTypeEnum::kRealType:
+        m_constant_value_string = std::to_string(m_value.real).c_str();
+        break;
+    case PType::PrimitiveTypeEnum::kBoolType:
+        m_constant_value_string = kTFString[m_value.boolean];
+        break;
+    case PType::PrimitiveTypeEnum::kStringType:
+        m_constant_value_string = m_value.string;
+        // Not kept, since the caller owns it.
+        m_value.string = nullptr;
+        break;
+    case PType::PrimitiveTypeEnum::kVoidType:
+    default:
+        break;
     }
-    return m_constant_value_string.c_str();
+}
+
+void *Constant::operator new(const std::size_t p_size) {
+    return AstArena::getCurrentOrAbort().allocate(p_size);
 }
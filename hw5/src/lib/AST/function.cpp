@@ -33,16 +33,6 @@ FunctionNode::getParametersTypeString(const DeclNodes &p_parameters) {
 }
 
 const char *FunctionNode::getPrototypeCString() const {
-    if (!m_prototype_string_is_valid) {
-        m_prototype_string = m_ret_type->getPTypeCString();
-
-        m_prototype_string += " (";
-        m_prototype_string += getParametersTypeString(m_parameters);
-        m_prototype_string += ")";
-
-        m_prototype_string_is_valid = true;
-    }
-
     return m_prototype_string.c_str();
 }
 
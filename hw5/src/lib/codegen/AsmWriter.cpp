@@ -0,0 +1,181 @@
+#include "codegen/AsmWriter.hpp"
+
+#include <cassert>
+#include <cstring>
+
+#include "codegen/InstructionStream.hpp"
+#include "codegen/MachineInstruction.hpp"
+#include "codegen/RegisterPool.hpp"
+
+namespace {
+constexpr const char *const kIndent = "    ";
+/// @brief The comments line up at this column unless the instruction is
+/// longer.
+constexpr std::size_t kCommentColumn = 28;
+}  // namespace
+
+void AsmWriter::write(const InstructionStream &p_stream) {
+    for (const auto &inst : p_stream.getInstructions()) {
+        writeInstruction(p_stream, inst);
+    }
+}
+
+void AsmWriter::writeInstruction(const InstructionStream &p_stream,
+                                 const MachineInstruction &p_inst) {
+    using Opcode = MachineInstruction::Opcode;
+
+    const std::size_t line_start = m_output.size();
+    switch (p_inst.opcode) {
+        case Opcode::kLabel:
+            writeLabel(p_stream, p_inst.label);
+            m_output += ":\n";
+            return;
+        case Opcode::kDirective:
+            m_output += p_stream.getDirective(p_inst);
+            m_output += '\n';
+            return;
+        default:
+            break;
+    }
+
+    m_output += kIndent;
+    m_output += MachineInstruction::getMnemonic(p_inst.opcode);
+    m_output += ' ';
+    switch (p_inst.opcode) {
+        case Opcode::kAdd:
+        case Opcode::kSub:
+        case Opcode::kMul:
+        case Opcode::kDiv:
+        case Opcode::kRem:
+        case Opcode::kAnd:
+        case Opcode::kOr:
+        case Opcode::kSlt:
+            writeRegister(p_inst.rd);
+            m_output += ", ";
+            writeRegister(p_inst.rs1);
+            m_output += ", ";
+            writeRegister(p_inst.rs2);
+            break;
+        case Opcode::kAddi:
+        case Opcode::kXori:
+            writeRegister(p_inst.rd);
+            m_output += ", ";
+            writeRegister(p_inst.rs1);
+            m_output += ", ";
+            writeInt(p_inst.imm);
+            break;
+        case Opcode::kLi:
+            writeRegister(p_inst.rd);
+            m_output += ", ";
+            writeInt(p_inst.imm);
+            break;
+        case Opcode::kMv:
+        case Opcode::kNeg:
+        case Opcode::kSeqz:
+        case Opcode::kSnez:
+            writeRegister(p_inst.rd);
+            m_output += ", ";
+            writeRegister(p_inst.rs1);
+            break;
+        case Opcode::kLw:
+        case Opcode::kSw:
+            writeRegister(p_inst.opcode == Opcode::kLw ? p_inst.rd
+                                                       : p_inst.rs2);
+            m_output += ", ";
+            writeInt(p_inst.imm);
+            m_output += '(';
+            writeRegister(p_inst.rs1);
+            m_output += ')';
+            break;
+        case Opcode::kLa:
+            writeRegister(p_inst.rd);
+            m_output += ", ";
+            m_output += p_inst.symbol;
+            break;
+        case Opcode::kBeq:
+        case Opcode::kBne:
+        case Opcode::kBlt:
+        case Opcode::kBge:
+        case Opcode::kBle:
+        case Opcode::kBgt:
+            writeRegister(p_inst.rs1);
+            m_output += ", ";
+            writeRegister(p_inst.rs2);
+            m_output += ", ";
+            writeLabel(p_stream, p_inst.label);
+            break;
+        case Opcode::kBeqz:
+        case Opcode::kBnez:
+            writeRegister(p_inst.rs1);
+            m_output += ", ";
+            writeLabel(p_stream, p_inst.label);
+            break;
+        case Opcode::kJ:
+            writeLabel(p_stream, p_inst.label);
+            break;
+        case Opcode::kJal:
+            writeRegister(p_inst.rd);
+            m_output += ", ";
+            m_output += p_inst.symbol;
+            break;
+        case Opcode::kTail:
+            m_output += p_inst.symbol;
+            break;
+        case Opcode::kJr:
+            writeRegister(p_inst.rs1);
+            break;
+        default:
+            assert(false && "unknown opcode");
+    }
+    if (p_inst.comment) {
+        writeComment(p_inst, line_start);
+    }
+    m_output += '\n';
+}
+
+void AsmWriter::writeLabel(const InstructionStream &p_stream,
+                           const int p_label) {
+    m_output += ".L";
+    m_output += p_stream.getLabelScope();
+    m_output += '.';
+    writeInt(p_label);
+}
+
+void AsmWriter::writeRegister(const int p_reg) {
+    m_output += RegisterPool::getName(p_reg);
+}
+
+void AsmWriter::writeInt(const int p_value) {
+    // Digits are produced backwards; unsigned so that INT_MIN negates.
+    char digits[12];
+    char *end = digits + sizeof(digits);
+    char *begin = end;
+    unsigned magnitude = p_value < 0 ? 0u - static_cast<unsigned>(p_value)
+                                     : static_cast<unsigned>(p_value);
+    do {
+        *--begin = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (p_value < 0) {
+        *--begin = '-';
+    }
+    m_output.append(begin, end);
+}
+
+void AsmWriter::writeComment(const MachineInstruction &p_inst,
+                             const std::size_t p_line_start) {
+    const std::size_t column = m_output.size() - p_line_start;
+    m_output.append(column < kCommentColumn ? kCommentColumn - column : 1,
+                    ' ');
+    m_output += "# ";
+    const char *const comment = p_inst.comment;
+    const char *const placeholder = std::strstr(comment, "%s");
+    if (!placeholder) {
+        m_output += comment;
+        return;
+    }
+    assert(p_inst.symbol && "The comment names a missing symbol");
+    m_output.append(comment, placeholder);
+    m_output += p_inst.symbol;
+    m_output += placeholder + 2;
+}
@@ -2,29 +2,48 @@
 
 #include <algorithm>
 #include <cassert>
-#include <cstdarg>
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "AST/CompoundStatement.hpp"
 #include "AST/for.hpp"
 #include "AST/function.hpp"
 #include "AST/program.hpp"
-#include "sema/SemanticAnalyzer.hpp"
+#include "codegen/AsmWriter.hpp"
+#include "codegen/RegisterPool.hpp"
 #include "sema/SymbolTable.hpp"
+#include "util/WorkStealingPool.hpp"
 #include "visitor/AstNodeInclude.hpp"
 
-CodeGenerator::CodeGenerator(
-    const std::string &source_file_name, const std::string &save_path,
-    std::unordered_map<SemanticAnalyzer::AstNodeAddr, SymbolManager::Table>
-        &&p_symbol_table_of_scoping_nodes)
-    : m_symbol_manager(false /* no dump */),
-      m_source_file_path(source_file_name),
-      m_symbol_table_of_scoping_nodes(
-          std::move(p_symbol_table_of_scoping_nodes)) {
+CodeGenerator::CodeGenerator(const std::string &source_file_name,
+                             const std::string &save_path,
+                             const CodeGenOptions &p_options)
+    : CodeGenerator(source_file_name, p_options) {
+    m_output_file.reset(
+        fopen(getOutputFilePath(source_file_name, save_path).c_str(), "w"));
+    assert(m_output_file.get() && "Failed to open output file");
+}
+
+CodeGenerator::CodeGenerator(const std::string &p_source_file_path,
+                             const CodeGenOptions &p_options)
+    : m_source_file_path(p_source_file_path), m_options(p_options) {}
+
+CodeGenerator::InstructionCounts CodeGenerator::countInstructions(
+    const std::string &source_file_name, AstNode &p_root,
+    const CodeGenOptions &p_options) {
+    CodeGenerator generator(source_file_name, p_options);
+    p_root.accept(generator);
+    return std::move(generator.m_instruction_counts);
+}
+
+std::string CodeGenerator::getOutputFilePath(
+    const std::string &source_file_name, const std::string &save_path) {
     // FIXME: assume that the source file is always xxxx.p
     const auto &real_path = save_path.empty() ? std::string{"."} : save_path;
     auto slash_pos = source_file_name.rfind('/');
@@ -35,422 +54,1069 @@ CodeGenerator::CodeGenerator(
     } else {
         slash_pos = 0;
     }
-    auto output_file_path{
-        real_path + "/" +
-        source_file_name.substr(slash_pos, dot_pos - slash_pos) + ".S"};
-    m_output_file.reset(fopen(output_file_path.c_str(), "w"));
-    assert(m_output_file.get() && "Failed to open output file");
+    return real_path + "/" +
+           source_file_name.substr(slash_pos, dot_pos - slash_pos) + ".S";
+}
+
+namespace {
+using Opcode = MachineInstruction::Opcode;
+
+constexpr RegisterPool::Reg kRa = RegisterPool::kReturnAddress;
+constexpr RegisterPool::Reg kSp = RegisterPool::kStackPointer;
+constexpr RegisterPool::Reg kS0 = RegisterPool::kFramePointer;
+
+const std::string kMainName{"main"};
+constexpr const char *kPrintIntName = "printInt";
+constexpr const char *kReadIntName = "readInt";
+
+// The bound of a loop is held in a register over the body only if this many
+// are left for the expressions in it.
+constexpr std::size_t kMinFreeRegistersInLoop = 8;
+
+bool isImmediate12(const int p_value) {
+    return p_value >= -2048 && p_value <= 2047;
 }
 
-static void dumpInstructions(FILE *p_out_file, const char *format, ...) {
-    va_list args;
-    va_start(args, format);
-    vfprintf(p_out_file, format, args);
-    va_end(args);
+/// @brief Finds whether a statement calls a function, including `printInt`
+/// and `readInt`, which may overwrite any caller-saved register.
+class CallFinder final : public AstNodeVisitor {
+  private:
+    bool m_has_call = false;
+
+  public:
+    static bool hasCall(AstNode &p_node) {
+        CallFinder finder;
+        p_node.accept(finder);
+        return finder.m_has_call;
+    }
+
+    void visit(CompoundStatementNode &p_compound_statement) override {
+        p_compound_statement.visitChildNodes(*this);
+    }
+    void visit(PrintNode &p_print) override { m_has_call = true; }
+    void visit(BinaryOperatorNode &p_bin_op) override {
+        p_bin_op.visitChildNodes(*this);
+    }
+    void visit(UnaryOperatorNode &p_un_op) override {
+        p_un_op.visitChildNodes(*this);
+    }
+    void visit(FunctionInvocationNode &p_func_invocation) override {
+        m_has_call = true;
+    }
+    void visit(VariableReferenceNode &p_variable_ref) override {
+        p_variable_ref.visitChildNodes(*this);
+    }
+    void visit(AssignmentNode &p_assignment) override {
+        p_assignment.visitChildNodes(*this);
+    }
+    void visit(ReadNode &p_read) override { m_has_call = true; }
+    void visit(IfNode &p_if) override { p_if.visitChildNodes(*this); }
+    void visit(WhileNode &p_while) override {
+        p_while.visitChildNodes(*this);
+    }
+    void visit(ForNode &p_for) override { p_for.visitChildNodes(*this); }
+    void visit(ReturnNode &p_return) override {
+        p_return.visitChildNodes(*this);
+    }
+};
+
+/// @brief Finds the invocations in tail position in a function: the value
+/// of a `return`, and a call statement that only the end of a procedure
+/// follows.
+class TailCallFinder final : public AstNodeVisitor {
+  public:
+    using TailCalls = std::unordered_map<const FunctionInvocationNode *, bool>;
+
+  private:
+    const AstString &m_name;
+    TailCalls &m_calls;
+    /// @brief Whether the function returns right after the statement being
+    /// visited, without a value.
+    bool m_is_last;
+
+    TailCallFinder(FunctionNode &p_function, TailCalls &p_calls)
+        : m_name(p_function.getName()), m_calls(p_calls),
+          m_is_last(p_function.getTypePtr()->isVoid()) {}
+
+    void add(const FunctionInvocationNode &p_call) {
+        m_calls.emplace(&p_call, p_call.getName() == m_name);
+    }
+
+  public:
+    /// @return Each invocation with whether it calls `p_function` itself.
+    static TailCalls find(FunctionNode &p_function) {
+        TailCalls calls;
+        TailCallFinder finder(p_function, calls);
+        p_function.getBody()->accept(finder);
+        return calls;
+    }
+
+    void visit(CompoundStatementNode &p_compound_statement) override {
+        const bool is_last = m_is_last;
+        auto &statements = p_compound_statement.getStmtNodes();
+        for (std::size_t i = 0; i < statements.size(); ++i) {
+            m_is_last = is_last && i + 1 == statements.size();
+            statements[i]->accept(*this);
+        }
+        m_is_last = is_last;
+    }
+    void visit(FunctionInvocationNode &p_func_invocation) override {
+        // Only reached as a statement, since no expression is visited.
+        if (m_is_last) {
+            add(p_func_invocation);
+        }
+    }
+    void visit(IfNode &p_if) override {
+        p_if.getBody().accept(*this);
+        if (p_if.hasElseBody()) {
+            p_if.getElseBody().accept(*this);
+        }
+    }
+    void visit(WhileNode &p_while) override {
+        visitLoopBody(p_while.getBody());
+    }
+    void visit(ForNode &p_for) override { visitLoopBody(p_for.getBody()); }
+    void visit(ReturnNode &p_return) override {
+        const auto *call = dynamic_cast<const FunctionInvocationNode *>(
+            &p_return.getReturnValue());
+        if (call) {
+            add(*call);
+        }
+    }
+
+  private:
+    void visitLoopBody(CompoundStatementNode &p_body) {
+        const bool is_last = m_is_last;
+        m_is_last = false;
+        p_body.accept(*this);
+        m_is_last = is_last;
+    }
+};
+}  // namespace
+
+// Booleans share the storage of the integer, so only read the active member.
+static int getConstantWord(const Constant &p_constant) {
+    if (p_constant.getTypePtr()->isBool()) {
+        return p_constant.boolean();
+    }
+    return static_cast<int>(p_constant.integer());
+}
+
+RegisterPool::Reg CodeGenerator::allocateRegister() {
+    const auto reg = m_registers.allocate();
+    assert(reg != RegisterPool::kNoReg && "Run out of registers");
+    return reg;
+}
+
+void CodeGenerator::emitPush(const RegisterPool::Reg p_reg) {
+    m_stream.emitImmediate(Opcode::kAddi, kSp, kSp, -4);
+    m_stream.emitStore(p_reg, 0, kSp, "push the value to the stack");
+}
+
+void CodeGenerator::emitPop(const RegisterPool::Reg p_reg) {
+    m_stream.emitLoad(p_reg, 0, kSp, "pop the value from the stack");
+    m_stream.emitImmediate(Opcode::kAddi, kSp, kSp, 4);
+}
+
+RegisterPool::Reg CodeGenerator::getVariableRegister(
+    const SymbolEntry &p_entry) const {
+    auto it = m_allocation.registers.find(&p_entry);
+    return (it == m_allocation.registers.end()) ? RegisterPool::kNoReg
+                                                : it->second;
+}
+
+int CodeGenerator::getSlotOffset(const SymbolEntry &p_entry) const {
+    auto it = m_frame.offsets.find(&p_entry);
+    assert(it != m_frame.offsets.end() && "The variable has no slot");
+    return it->second;
+}
+
+void CodeGenerator::emitLoadSlot(const RegisterPool::Reg p_rd,
+                                 const int p_offset,
+                                 const char *const p_comment,
+                                 const char *const p_symbol) {
+    if (isImmediate12(p_offset)) {
+        m_stream.emitLoad(p_rd, p_offset, kS0, p_comment, p_symbol);
+        return;
+    }
+    m_stream.emitLoadImmediate(p_rd, p_offset);
+    m_stream.emitBinary(Opcode::kAdd, p_rd, kS0, p_rd);
+    m_stream.emitLoad(p_rd, 0, p_rd, p_comment, p_symbol);
+}
+
+void CodeGenerator::emitStoreSlot(const RegisterPool::Reg p_src,
+                                  const int p_offset,
+                                  const char *const p_comment,
+                                  const char *const p_symbol) {
+    if (isImmediate12(p_offset)) {
+        m_stream.emitStore(p_src, p_offset, kS0, p_comment, p_symbol);
+        return;
+    }
+    m_stream.emitLoadImmediate(kRa, p_offset);
+    m_stream.emitBinary(Opcode::kAdd, kRa, kS0, kRa);
+    m_stream.emitStore(p_src, 0, kRa, p_comment, p_symbol);
+}
+
+void CodeGenerator::emitFrameSetup(const char *const p_comment) {
+    const int size = m_frame.size;
+    if (isImmediate12(size)) {
+        m_stream.emitImmediate(Opcode::kAddi, kSp, kSp, -size);
+        m_stream.emitStore(kRa, size + FrameLayoutBuilder::kReturnAddressOffset,
+                           kSp);
+        m_stream.emitStore(kS0, size + FrameLayoutBuilder::kFramePointerOffset,
+                           kSp);
+        m_stream.emitImmediate(Opcode::kAddi, kS0, kSp, size, p_comment);
+        return;
+    }
+    // ra is saved first, so it can hold the frame size; the arguments are
+    // still in the other registers.
+    m_stream.emitStore(kRa, FrameLayoutBuilder::kReturnAddressOffset, kSp);
+    m_stream.emitStore(kS0, FrameLayoutBuilder::kFramePointerOffset, kSp);
+    m_stream.emitUnary(Opcode::kMv, kS0, kSp);
+    m_stream.emitLoadImmediate(kRa, size);
+    m_stream.emitBinary(Opcode::kSub, kSp, kSp, kRa, p_comment);
+}
+
+void CodeGenerator::emitFrameTeardown(const char *const p_comment) {
+    emitFrameRestore(p_comment);
+    m_stream.emitJumpRegister(kRa);
+}
+
+void CodeGenerator::emitFrameRestore(const char *const p_comment) {
+    const int size = m_frame.size;
+    if (isImmediate12(size)) {
+        m_stream.emitLoad(kRa, size + FrameLayoutBuilder::kReturnAddressOffset,
+                          kSp, p_comment);
+        m_stream.emitLoad(kS0, size + FrameLayoutBuilder::kFramePointerOffset,
+                          kSp);
+        m_stream.emitImmediate(Opcode::kAddi, kSp, kSp, size);
+    } else {
+        m_stream.emitLoad(kRa, FrameLayoutBuilder::kReturnAddressOffset, kS0,
+                          p_comment);
+        m_stream.emitUnary(Opcode::kMv, kSp, kS0);
+        m_stream.emitLoad(kS0, FrameLayoutBuilder::kFramePointerOffset, kSp);
+    }
+}
+
+void CodeGenerator::emitPrologue(const FunctionNode *const p_function) {
+    for (const auto &saved : m_frame.saved_registers) {
+        emitStoreSlot(saved.first, saved.second, "save the callee-saved reg");
+    }
+    if (!p_function) {
+        return;
+    }
+
+    if (m_entry_label >= 0) {
+        m_stream.emitLabel(m_entry_label);
+    }
+    std::size_t args_count = 0;
+    for (const auto &parameter : p_function->getParameters()) {
+        for (const auto &variable : parameter->getVariables()) {
+            const SymbolEntry &entry = *variable->getSymbolEntry();
+            // From register a0-a7, then the spilled ones from t0-t6
+            const auto arg_reg = RegisterPool::getArgumentRegister(args_count);
+            const auto var_reg = getVariableRegister(entry);
+            if (var_reg != RegisterPool::kNoReg) {
+                m_stream.emitUnary(Opcode::kMv, var_reg, arg_reg);
+            } else {
+                emitStoreSlot(arg_reg, getSlotOffset(entry));
+            }
+            args_count++;
+        }
+    }
+}
+
+void CodeGenerator::beginStream(const std::string &p_name) {
+    m_stream.reset(p_name);
+}
+
+void CodeGenerator::flushStream() {
+    if (m_options.peephole) {
+        m_peephole.run(m_stream, m_peephole_stats);
+    }
+    AsmWriter(m_output).write(m_stream);
+    // The stream of the globals has no name and no instructions.
+    if (!m_stream.getLabelScope().empty()) {
+        const auto &instructions = m_stream.getInstructions();
+        m_instruction_counts.emplace_back(
+            m_stream.getLabelScope(),
+            std::count_if(instructions.begin(), instructions.end(),
+                          [](const MachineInstruction &p_inst) {
+                              return p_inst.opcode != Opcode::kLabel &&
+                                     p_inst.opcode != Opcode::kDirective;
+                          }));
+    }
+    m_stream.reset(m_stream.getLabelScope());
+}
+
+void CodeGenerator::emitEpilogue() {
+    m_stream.emitLabel(m_return_label);
+    emitRestoreSavedRegisters();
+}
+
+void CodeGenerator::emitRestoreSavedRegisters() {
+    for (const auto &saved : m_frame.saved_registers) {
+        emitLoadSlot(saved.first, saved.second,
+                     "restore the callee-saved reg");
+    }
+}
+
+void CodeGenerator::emitStore(const SymbolEntry &p_entry,
+                              const RegisterPool::Reg p_reg) {
+    const auto var_reg = getVariableRegister(p_entry);
+    if (var_reg != RegisterPool::kNoReg) {
+        if (var_reg != p_reg) {
+            m_stream.emitUnary(Opcode::kMv, var_reg, p_reg, "%s = expr",
+                               p_entry.getNameCString());
+        }
+    } else if (p_entry.getLevel() == 0) {
+        const auto addr = allocateRegister();
+        m_stream.emitLoadAddress(addr, p_entry.getNameCString());
+        m_stream.emitStore(p_reg, 0, addr, "%s = expr",
+                           p_entry.getNameCString());
+        m_registers.release(addr);
+    } else {
+        emitStoreSlot(p_reg, getSlotOffset(p_entry), "%s = expr",
+                      p_entry.getNameCString());
+    }
+}
+
+RegisterPool::Reg CodeGenerator::evaluate(const ExpressionNode &p_expr) {
+    auto it = m_hoisted_values.find(&p_expr);
+    if (it != m_hoisted_values.end()) {
+        return it->second;
+    }
+    m_labeler.label(p_expr);
+
+    ++m_expression_depth;
+    m_result_reg = RegisterPool::kNoReg;
+    const_cast<ExpressionNode &>(p_expr).accept(*this);
+    --m_expression_depth;
+
+    return m_result_reg;
 }
 
 void CodeGenerator::visit(ProgramNode &p_program) {
     // Generate RISC-V instructions for program header
-    dumpInstructions(m_output_file.get(),
-                     "    .file \"%s\"\n"
-                     "    .option nopic\n",
-                     m_source_file_path.c_str());
-
-    // Reconstruct the scope for looking up the symbol entry.
-    // Hint: Use m_symbol_manager->lookup(symbol_name) to get the symbol entry.
-    m_symbol_manager.pushScope(
-        std::move(m_symbol_table_of_scoping_nodes.at(&p_program)));
+    beginStream("");
+    m_stream.emitDirective("    .file \"" + m_source_file_path + "\"");
+    m_stream.emitDirective("    .option nopic");
 
     auto visit_ast_node = [&](auto &ast_node) { ast_node->accept(*this); };
     for_each(p_program.getDeclNodes().begin(), p_program.getDeclNodes().end(),
              visit_ast_node);
-    for_each(p_program.getFuncNodes().begin(), p_program.getFuncNodes().end(),
-             visit_ast_node);
+    flushStream();
+    if (m_options.hoist_invariants) {
+        m_side_effects = std::make_shared<const SideEffectAnalyzer::Summary>(
+            SideEffectAnalyzer().analyze(p_program));
+    }
+    emitFunctions(p_program);
+
+    auto &body = const_cast<CompoundStatementNode &>(p_program.getBody());
+    m_allocation = m_options.allocate_registers
+                       ? LinearScanRegisterAllocator().allocate(body)
+                       : LinearScanRegisterAllocator::Allocation{};
+    m_hoists = m_options.hoist_invariants
+                   ? LoopInvariantHoister().plan(body, *m_side_effects,
+                                                 m_allocation)
+                   : LoopInvariantHoister::Plan{};
+    m_frame = FrameLayoutBuilder().build(body, m_allocation);
+    m_copy_sizes.clear();
+    beginStream(kMainName);
+    m_return_label = m_stream.createLabel();
+    m_tail_calls.clear();
+    m_entry_label = -1;
+
+    m_stream.emitDirective("");
+    m_stream.emitDirective(".section    .text");
+    m_stream.emitDirective("    .align 2");
+    m_stream.emitDirective("    .globl main");
+    m_stream.emitDirective("    .type main, @function");
+    m_stream.emitDirective("main:");
+    emitFrameSetup("end of main prologue");
+    emitPrologue(nullptr);
 
-    dumpInstructions(m_output_file.get(),
-                     "\n.section    .text\n"
-                     "    .align 2\n"
-                     "    .globl main\n"
-                     "    .type main, @function\n"
-                     "main:\n"
-                     "    addi sp, sp, -128\n"
-                     "    sw ra, 124(sp)\n"
-                     "    sw s0, 120(sp)\n"
-                     "    addi s0, sp, 128 # end of main prologue\n");
+    body.accept(*this);
 
-    const_cast<CompoundStatementNode &>(p_program.getBody()).accept(*this);
+    emitEpilogue();
+    emitFrameTeardown("start of main epilogue");
+    m_stream.emitDirective("    .size main, .-main");
+    flushStream();
 
-    dumpInstructions(m_output_file.get(),
-                     "    lw ra, 124(sp)   # start of main epilogue\n"
-                     "    lw s0, 120(sp)\n"
-                     "    addi sp, sp, 128\n"
-                     "    jr ra\n"
-                     "    .size main, .-main\n");
+    if (m_output_file) {
+        fwrite(m_output.data(), 1, m_output.size(), m_output_file.get());
+    }
+}
+
+void CodeGenerator::emitFunctions(ProgramNode &p_program) {
+    const auto &functions = p_program.getFuncNodes();
+    const std::size_t num_threads =
+        std::min(m_options.num_threads, functions.size());
+    if (num_threads <= 1) {
+        for (const auto &function : functions) {
+            function->accept(*this);
+        }
+        return;
+    }
 
-    m_symbol_manager.popScope();
+    // Each function is generated and formatted by a generator of its own.
+    // Nothing but the AST is shared, and the labels are local to the
+    // function, so the outputs are the same as what a single generator would
+    // produce in turn.
+    std::vector<std::string> outputs(functions.size());
+    std::vector<PeepholeOptimizer::Stats> stats(functions.size());
+    std::vector<InstructionCounts> counts(functions.size());
+    {
+        WorkStealingPool pool(num_threads);
+        for (std::size_t i = 0; i < functions.size(); ++i) {
+            pool.submit([this, &functions, &outputs, &stats, &counts, i] {
+                CodeGenerator generator(m_source_file_path, m_options);
+                generator.m_side_effects = m_side_effects;
+                functions[i]->accept(generator);
+                outputs[i] = std::move(generator.m_output);
+                stats[i] = generator.m_peephole_stats;
+                counts[i] = std::move(generator.m_instruction_counts);
+            });
+        }
+        pool.wait();
+    }
+    for (std::size_t i = 0; i < functions.size(); ++i) {
+        m_output += outputs[i];
+        m_peephole_stats.merge(stats[i]);
+        m_instruction_counts.insert(m_instruction_counts.end(),
+                                    counts[i].begin(), counts[i].end());
+    }
 }
 
 void CodeGenerator::visit(DeclNode &p_decl) { p_decl.visitChildNodes(*this); }
 
 void CodeGenerator::visit(VariableNode &p_variable) {
-    const SymbolEntry *sym = m_symbol_manager.lookup(p_variable.getName());
+    const SymbolEntry *sym = p_variable.getSymbolEntry();
     if (sym->getLevel() == 0) {  // Global variable
+        const std::string &name = sym->getName();
         if (sym->getKind() == SymbolEntry::KindEnum::kVariableKind)
-            dumpInstructions(m_output_file.get(), ".comm %s, 4, 4\n",
-                             p_variable.getName().c_str());
+            m_stream.emitDirective(".comm " + name + ", 4, 4");
         else if (sym->getKind() == SymbolEntry::KindEnum::kConstantKind) {
-            constexpr const char *const assembly =
-                ".section    .rodata\n"
-                "    .align 2\n"
-                "    .globl %s\n"
-                "    .type %s, @object\n"
-                "%s:\n"
-                "    .word %d\n";
-            dumpInstructions(
-                m_output_file.get(), assembly, p_variable.getName().c_str(),
-                p_variable.getName().c_str(), p_variable.getName().c_str(),
-                p_variable.getConstantPtr()->integer());
+            m_stream.emitDirective(".section    .rodata");
+            m_stream.emitDirective("    .align 2");
+            m_stream.emitDirective("    .globl " + name);
+            m_stream.emitDirective("    .type " + name + ", @object");
+            m_stream.emitDirective(name + ":");
+            m_stream.emitDirective(
+                "    .word " +
+                std::to_string(getConstantWord(*p_variable.getConstantPtr())));
         }
     } else if (sym->getLevel() > 0 &&
-               p_variable.getConstantPtr()) {  // Local variable
-        dumpInstructions(
-            m_output_file.get(),
-            "    addi t0, s0, %d\n"
-            "    addi sp, sp, -4\n"
-            "    sw t0, 0(sp)     # push the address to the stack\n",
-            sym->getOffset());
-        p_variable.visitChildNodes(*this);
-        dumpInstructions(
-            m_output_file.get(),
-            "    lw t0, 0(sp)     # pop the value from the stack\n"
-            "    addi sp, sp, 4\n"
-            "    lw t1, 0(sp)     # pop the adddress from the stack\n"
-            "    addi sp, sp, 4\n"
-            "    sw t0, 0(t1)     # %s = expr\n",
-            p_variable.getName().c_str());
+               p_variable.getConstantPtr()) {  // Local constant
+        auto reg = getVariableRegister(*sym);
+        if (reg == RegisterPool::kNoReg) {
+            reg = allocateRegister();
+        }
+        m_stream.emitLoadImmediate(
+            reg, getConstantWord(*p_variable.getConstantPtr()));
+        emitStore(*sym, reg);
+        m_registers.release(reg);
     }
 }
 
 void CodeGenerator::visit(ConstantValueNode &p_constant_value) {
-    dumpInstructions(m_output_file.get(),
-                     "    li t0, %d\n"
-                     "    addi sp, sp, -4\n"
-                     "    sw t0, 0(sp)     # push the value to the stack\n",
-                     p_constant_value.getConstantPtr()->integer());
+    m_result_reg = allocateRegister();
+    m_stream.emitLoadImmediate(
+        m_result_reg, getConstantWord(*p_constant_value.getConstantPtr()));
 }
 
 void CodeGenerator::visit(FunctionNode &p_function) {
-    // Reconstruct the scope for looking up the symbol entry.
-    m_symbol_manager.pushScope(
-        std::move(m_symbol_table_of_scoping_nodes.at(&p_function)));
-
-    dumpInstructions(m_output_file.get(),
-                     "\n.section    .text\n"
-                     "    .align 2\n"
-                     "    .globl %s\n"
-                     "    .type %s, @function\n"
-                     "%s:\n"
-                     "    addi sp, sp, -128\n"
-                     "    sw ra, 124(sp)\n"
-                     "    sw s0, 120(sp)\n"
-                     "    addi s0, sp, 128 # end of function prologue\n",
-                     p_function.getName().c_str(), p_function.getName().c_str(),
-                     p_function.getName().c_str());
-
-    for (int args_count = 0;
-         auto &entry : m_symbol_manager.getCurrentTable()->getEntries()) {
-        if (entry->getKind() == SymbolEntry::KindEnum::kParameterKind) {
-            if (args_count <= 7) {  // From register a0-a7
-                dumpInstructions(m_output_file.get(), "    sw a%d, %d(s0)\n",
-                                 args_count, entry->getOffset());
-            } else {  // From spilled registers
-                dumpInstructions(m_output_file.get(), "    sw t%d, %d(s0)\n",
-                                 args_count - 8, entry->getOffset());
-            }
-            args_count++;
-        }
-    }
+    const std::string name = p_function.getNameCString();
+    m_allocation = m_options.allocate_registers
+                       ? LinearScanRegisterAllocator().allocate(p_function)
+                       : LinearScanRegisterAllocator::Allocation{};
+    m_hoists = m_options.hoist_invariants
+                   ? LoopInvariantHoister().plan(p_function, *m_side_effects,
+                                                 m_allocation)
+                   : LoopInvariantHoister::Plan{};
+    m_frame = FrameLayoutBuilder().build(p_function, m_allocation);
+    m_copy_sizes.clear();
+    beginStream(name);
+    m_return_label = m_stream.createLabel();
+    findTailCalls(p_function);
 
-    p_function.visitBodyChildNodes(*this);
+    m_stream.emitDirective("");
+    m_stream.emitDirective(".section    .text");
+    m_stream.emitDirective("    .align 2");
+    m_stream.emitDirective("    .globl " + name);
+    m_stream.emitDirective("    .type " + name + ", @function");
+    m_stream.emitDirective(name + ":");
+    emitFrameSetup("end of function prologue");
 
-    dumpInstructions(m_output_file.get(),
-                     "    lw ra, 124(sp)   # start of function epilogue\n"
-                     "    lw s0, 120(sp)\n"
-                     "    addi sp, sp, 128\n"
-                     "    jr ra\n"
-                     "    .size %s, .-%s\n\n",
-                     p_function.getName().c_str(),
-                     p_function.getName().c_str());
+    emitPrologue(&p_function);
 
-    // Remove the entries in the hash table
-    m_symbol_manager.popScope();
+    p_function.visitBodyChildNodes(*this);
+
+    emitEpilogue();
+    emitFrameTeardown("start of function epilogue");
+    m_stream.emitDirective("    .size " + name + ", .-" + name);
+    m_stream.emitDirective("");
+    flushStream();
 }
 
 void CodeGenerator::visit(CompoundStatementNode &p_compound_statement) {
-    // Reconstruct the scope for looking up the symbol entry.
-    m_symbol_manager.pushScope(
-        std::move(m_symbol_table_of_scoping_nodes.at(&p_compound_statement)));
-
     p_compound_statement.visitChildNodes(*this);
-
-    m_symbol_manager.popScope();
 }
 
 void CodeGenerator::visit(PrintNode &p_print) {
-    p_print.visitChildNodes(*this);
-    dumpInstructions(
-        m_output_file.get(),
-        "    lw a0, 0(sp)     # pop the value from the stack to a0\n"
-        "    addi sp, sp, 4\n"
-        "    jal ra, printInt # call function `printInt`\n");
+    const auto reg = evaluate(p_print.getTarget());
+    m_stream.emitUnary(Opcode::kMv, RegisterPool::getArgumentRegister(0), reg);
+    m_stream.emitCall(kPrintIntName, 1, "call function `printInt`");
+    m_registers.release(reg);
+}
+
+std::pair<RegisterPool::Reg, RegisterPool::Reg>
+CodeGenerator::evaluateOperands(const BinaryOperatorNode &p_bin_op) {
+    const auto &left = p_bin_op.getLeftOperand();
+    const auto &right = p_bin_op.getRightOperand();
+    m_labeler.label(p_bin_op);
+
+    // Evaluate the operand that needs more registers first, so that holding
+    // the result of the first one costs nothing. The operands may only be
+    // reordered if neither of them has side effects.
+    const bool is_right_first = !m_labeler.containsCall(left) &&
+                                !m_labeler.containsCall(right) &&
+                                m_labeler.getNeed(right) > m_labeler.getNeed(left);
+    const auto &first = is_right_first ? right : left;
+    const auto &second = is_right_first ? left : right;
+
+    auto first_reg = evaluate(first);
+    // Fall back to the stack if there are not enough registers left to
+    // evaluate the second operand.
+    const bool is_spilled =
+        RegisterPool::isTemporary(first_reg) &&
+        m_registers.getNumFree() <
+            static_cast<std::size_t>(m_labeler.getNeed(second));
+    if (is_spilled) {
+        emitPush(first_reg);
+        m_registers.release(first_reg);
+    }
+    const auto second_reg = evaluate(second);
+    if (is_spilled) {
+        first_reg = allocateRegister();
+        emitPop(first_reg);
+    }
+
+    if (is_right_first) {
+        return {second_reg, first_reg};
+    }
+    return {first_reg, second_reg};
+}
+
+namespace {
+/// @brief Finds the branch instruction that is taken when the comparison is
+/// `p_value`.
+/// @return `false` if `p_op` is not a comparison.
+bool getBranch(const Operator p_op, const bool p_value, Opcode &p_opcode) {
+    switch (p_op) {
+        case Operator::kEqualOp:
+            p_opcode = p_value ? Opcode::kBeq : Opcode::kBne;
+            return true;
+        case Operator::kNotEqualOp:
+            p_opcode = p_value ? Opcode::kBne : Opcode::kBeq;
+            return true;
+        case Operator::kGreaterOp:
+            p_opcode = p_value ? Opcode::kBgt : Opcode::kBle;
+            return true;
+        case Operator::kGreaterOrEqualOp:
+            p_opcode = p_value ? Opcode::kBge : Opcode::kBlt;
+            return true;
+        case Operator::kLessOp:
+            p_opcode = p_value ? Opcode::kBlt : Opcode::kBge;
+            return true;
+        case Operator::kLessOrEqualOp:
+            p_opcode = p_value ? Opcode::kBle : Opcode::kBgt;
+            return true;
+        default:
+            return false;
+    }
+}
+}  // namespace
+
+void CodeGenerator::emitBranchIf(const ExpressionNode &p_condition,
+                                 const bool p_value, const int p_label) {
+    if (m_hoisted_values.count(&p_condition) != 0) {
+        const auto reg = evaluate(p_condition);
+        if (p_value) {
+            m_stream.emitBranchIfNonZero(reg, p_label);
+        } else {
+            m_stream.emitBranchIfZero(reg, p_label);
+        }
+        return;
+    }
+    const auto *un_op = dynamic_cast<const UnaryOperatorNode *>(&p_condition);
+    if (un_op && un_op->getOp() == Operator::kNotOp) {
+        emitBranchIf(un_op->getOperand(), !p_value, p_label);
+        return;
+    }
+    const auto *bin_op = dynamic_cast<const BinaryOperatorNode *>(&p_condition);
+    Opcode branch;
+    if (bin_op && getBranch(bin_op->getOp(), p_value, branch)) {
+        const auto operands = evaluateOperands(*bin_op);
+        m_stream.emitBranch(branch, operands.first, operands.second, p_label);
+        m_registers.release(operands.first);
+        m_registers.release(operands.second);
+        return;
+    }
+
+    const auto reg = evaluate(p_condition);
+    if (p_value) {
+        m_stream.emitBranchIfNonZero(reg, p_label);
+    } else {
+        m_stream.emitBranchIfZero(reg, p_label);
+    }
+    m_registers.release(reg);
 }
 
 void CodeGenerator::visit(BinaryOperatorNode &p_bin_op) {
-    p_bin_op.visitChildNodes(*this);
-    dumpInstructions(m_output_file.get(),
-                     "    lw t0, 0(sp)     # pop the value from the stack\n"
-                     "    addi sp, sp, 4\n"
-                     "    lw t1, 0(sp)     # pop the adddress from the stack\n"
-                     "    addi sp, sp, 4\n");
+    const auto operands = evaluateOperands(p_bin_op);
+    // Reuse the register of an operand unless it holds a variable.
+    if (RegisterPool::isTemporary(operands.first)) {
+        m_result_reg = operands.first;
+        m_registers.release(operands.second);
+    } else if (RegisterPool::isTemporary(operands.second)) {
+        m_result_reg = operands.second;
+    } else {
+        m_result_reg = allocateRegister();
+    }
+    const auto dst = m_result_reg;
+    const auto lhs = operands.first;
+    const auto rhs = operands.second;
+
     switch (p_bin_op.getOp()) {
         case Operator::kPlusOp:
-            dumpInstructions(m_output_file.get(), "    add t0, t1, t0\n");
+            m_stream.emitBinary(Opcode::kAdd, dst, lhs, rhs);
             break;
         case Operator::kMinusOp:
-            dumpInstructions(m_output_file.get(), "    sub t0, t1, t0\n");
+            m_stream.emitBinary(Opcode::kSub, dst, lhs, rhs);
             break;
         case Operator::kMultiplyOp:
-            dumpInstructions(m_output_file.get(), "    mul t0, t1, t0\n");
+            m_stream.emitBinary(Opcode::kMul, dst, lhs, rhs);
             break;
         case Operator::kDivideOp:
-            dumpInstructions(m_output_file.get(), "    div t0, t1, t0\n");
+            m_stream.emitBinary(Opcode::kDiv, dst, lhs, rhs);
             break;
         case Operator::kModOp:
-            dumpInstructions(m_output_file.get(), "    rem t0, t1, t0\n");
+            m_stream.emitBinary(Opcode::kRem, dst, lhs, rhs);
+            break;
+        case Operator::kAndOp:
+            m_stream.emitBinary(Opcode::kAnd, dst, lhs, rhs);
+            break;
+        case Operator::kOrOp:
+            m_stream.emitBinary(Opcode::kOr, dst, lhs, rhs);
             break;
-        // TODO: AND OR NOT
         case Operator::kEqualOp:
-            dumpInstructions(m_output_file.get(), "    bne t1, t0, ");
+            m_stream.emitBinary(Opcode::kSub, dst, lhs, rhs);
+            m_stream.emitUnary(Opcode::kSeqz, dst, dst);
             break;
         case Operator::kNotEqualOp:
-            dumpInstructions(m_output_file.get(), "    beq t1, t0, ");
+            m_stream.emitBinary(Opcode::kSub, dst, lhs, rhs);
+            m_stream.emitUnary(Opcode::kSnez, dst, dst);
             break;
-        case Operator::kGreaterOp:
-            dumpInstructions(m_output_file.get(), "    ble t1, t0, ");
+        case Operator::kLessOp:
+            m_stream.emitBinary(Opcode::kSlt, dst, lhs, rhs);
             break;
-        case Operator::kGreaterOrEqualOp:
-            dumpInstructions(m_output_file.get(), "    blt t1, t0, ");
+        case Operator::kGreaterOp:
+            m_stream.emitBinary(Opcode::kSlt, dst, rhs, lhs);
             break;
-        case Operator::kLessOp:
-            dumpInstructions(m_output_file.get(), "    bge t1, t0, ");
+        case Operator::kLessOrEqualOp:
+            m_stream.emitBinary(Opcode::kSlt, dst, rhs, lhs);
+            m_stream.emitImmediate(Opcode::kXori, dst, dst, 1);
             break;
-        case Operator::kLessOrEqualOp: {
-            dumpInstructions(m_output_file.get(), "    bgt t1, t0, ");
+        case Operator::kGreaterOrEqualOp:
+            m_stream.emitBinary(Opcode::kSlt, dst, lhs, rhs);
+            m_stream.emitImmediate(Opcode::kXori, dst, dst, 1);
             break;
-        }
         default:
+            assert(false && "unknown binary op");
+    }
+}
+
+void CodeGenerator::visit(UnaryOperatorNode &p_un_op) {
+    const auto operand = evaluate(p_un_op.getOperand());
+    m_result_reg = RegisterPool::isTemporary(operand) ? operand
+                                                      : allocateRegister();
+    if (p_un_op.getOp() == Operator::kNotOp) {
+        m_stream.emitImmediate(Opcode::kXori, m_result_reg, operand, 1);
+    } else {
+        m_stream.emitUnary(Opcode::kNeg, m_result_reg, operand);
+    }
+}
+
+void CodeGenerator::findTailCalls(FunctionNode &p_function) {
+    m_tail_calls.clear();
+    m_entry_label = -1;
+    if (!m_options.eliminate_tail_calls || !p_function.getBody()) {
+        return;
+    }
+    m_tail_calls = TailCallFinder::find(p_function);
+    for (const auto &call : m_tail_calls) {
+        if (call.second) {
+            m_entry_label = m_stream.createLabel();
             break;
+        }
     }
-    if (p_bin_op.getOp() == Operator::kPlusOp ||
-        p_bin_op.getOp() == Operator::kMinusOp ||
-        p_bin_op.getOp() == Operator::kMultiplyOp ||
-        p_bin_op.getOp() == Operator::kDivideOp ||
-        p_bin_op.getOp() == Operator::kModOp) {
-        dumpInstructions(
-            m_output_file.get(),
-            "    addi sp, sp, -4\n"
-            "    sw t0, 0(sp)     # push the result to the stack\n");
+}
+
+void CodeGenerator::emitArguments(const FunctionInvocationNode &p_call) {
+    // Evaluate each argument and move it to the register that carries it. The
+    // argument registers of the previous arguments stay live, so they are
+    // saved if a later argument calls a function.
+    const auto &arguments = p_call.getArguments();
+    for (std::size_t i = 0; i < arguments.size(); ++i) {
+        const auto target = RegisterPool::getArgumentRegister(i);
+        const auto reg = evaluate(*arguments[i]);
+        if (reg != target) {
+            const bool is_allocated = m_registers.allocate(target);
+            assert(is_allocated && "The argument register is occupied");
+            (void)is_allocated;
+            m_stream.emitUnary(Opcode::kMv, target, reg);
+            m_registers.release(reg);
+        }
     }
 }
 
-void CodeGenerator::visit(UnaryOperatorNode &p_un_op) {
-    p_un_op.visitChildNodes(*this);
-    dumpInstructions(m_output_file.get(),
-                     "    lw t0, 0(sp)     # pop the value from the stack\n"
-                     "    addi sp, sp, 4\n"
-                     "    neg t0, t0\n"
-                     "    addi sp, sp, -4\n"
-                     "    sw t0, 0(sp)     # push the result to the stack\n");
+void CodeGenerator::emitTailCall(const FunctionInvocationNode &p_call) {
+    assert(m_registers.getLiveRegisters().empty() &&
+           "A tail call is part of an expression");
+    emitArguments(p_call);
+    const auto &arguments = p_call.getArguments();
+    if (m_tail_calls.at(&p_call)) {
+        m_stream.emitJump(m_entry_label);
+    } else {
+        emitRestoreSavedRegisters();
+        emitFrameRestore("start of tail call");
+        m_stream.emitTailCall(p_call.getNameCString(),
+                              static_cast<int>(arguments.size()),
+                              "tail call function `%s`");
+    }
+    for (std::size_t i = 0; i < arguments.size(); ++i) {
+        m_registers.release(RegisterPool::getArgumentRegister(i));
+    }
 }
 
 void CodeGenerator::visit(FunctionInvocationNode &p_func_invocation) {
-    p_func_invocation.visitChildNodes(*this);
-    int args_count = p_func_invocation.getArguments().size();
-    for (int i = args_count - 1; i >= 0; i--) {
-        if (i > 7)
-            dumpInstructions(m_output_file.get(), "    lw t%d, 0(sp)\n", i - 8);
-        else
-            dumpInstructions(m_output_file.get(), "    lw a%d, 0(sp)\n", i);
-        dumpInstructions(m_output_file.get(), "    addi sp, sp, 4\n");
-    }
-    dumpInstructions(m_output_file.get(), "    jal ra, %s\n",
-                     p_func_invocation.getName().c_str());
-    if (p_func_invocation.getInferredType()->getPrimitiveType() !=
-        PType::PrimitiveTypeEnum::kVoidType) {
-        dumpInstructions(m_output_file.get(),
-                         "    mv t0, a0\n"
-                         "    addi sp, sp, -4\n"
-                         "    sw t0, 0(sp)\n");
+    const bool is_statement = m_expression_depth == 0;
+    if (is_statement && m_tail_calls.count(&p_func_invocation) != 0) {
+        emitTailCall(p_func_invocation);
+        return;
+    }
+
+    // Every register is caller-saved, so save the live ones across the call.
+    const auto saved_regs = m_registers.getLiveRegisters();
+    if (!saved_regs.empty()) {
+        const int size = static_cast<int>(saved_regs.size()) * 4;
+        m_stream.emitImmediate(Opcode::kAddi, kSp, kSp, -size);
+        for (std::size_t i = 0; i < saved_regs.size(); ++i) {
+            m_stream.emitStore(saved_regs[i], static_cast<int>(i) * 4, kSp,
+                               "save the live value");
+            m_registers.release(saved_regs[i]);
+        }
+    }
+
+    emitArguments(p_func_invocation);
+    const auto &arguments = p_func_invocation.getArguments();
+    m_stream.emitCall(p_func_invocation.getNameCString(),
+                      static_cast<int>(arguments.size()));
+    for (std::size_t i = 0; i < arguments.size(); ++i) {
+        m_registers.release(RegisterPool::getArgumentRegister(i));
+    }
+
+    for (const auto reg : saved_regs) {
+        m_registers.allocate(reg);
+    }
+    m_result_reg = RegisterPool::kNoReg;
+    if (!is_statement && p_func_invocation.getInferredType()->getPrimitiveType() !=
+                             PType::PrimitiveTypeEnum::kVoidType) {
+        // Not one of the saved registers, since they are live again.
+        m_result_reg = allocateRegister();
+        m_stream.emitUnary(Opcode::kMv, m_result_reg,
+                           RegisterPool::getArgumentRegister(0));
+    }
+    if (!saved_regs.empty()) {
+        for (std::size_t i = 0; i < saved_regs.size(); ++i) {
+            m_stream.emitLoad(saved_regs[i], static_cast<int>(i) * 4, kSp,
+                              "restore the live value");
+        }
+        m_stream.emitImmediate(Opcode::kAddi, kSp, kSp,
+                               static_cast<int>(saved_regs.size()) * 4);
     }
 }
 
 void CodeGenerator::visit(VariableReferenceNode &p_variable_ref) {
-    const SymbolEntry *sym = m_symbol_manager.lookup(p_variable_ref.getName());
-    if (isAssignment) {
-        if (sym->getLevel() == 0) {
-            dumpInstructions(
-                m_output_file.get(),
-                "    la t0, %s\n"
-                "    addi sp, sp, -4\n"
-                "    sw t0, 0(sp)     # push the address to the stack\n",
-                p_variable_ref.getName().c_str());
-        } else {
-            dumpInstructions(
-                m_output_file.get(),
-                "    addi t0, s0, %d\n"
-                "    addi sp, sp, -4\n"
-                "    sw t0, 0(sp)     # push the address to the stack\n",
-                sym->getOffset());
-        }
+    const SymbolEntry *sym = p_variable_ref.getSymbolEntry();
+    m_result_reg = getVariableRegister(*sym);
+    if (m_result_reg != RegisterPool::kNoReg) {
+        return;
+    }
+    m_result_reg = allocateRegister();
+    const char *const name = p_variable_ref.getNameCString();
+    if (sym->getLevel() == 0) {
+        m_stream.emitLoadAddress(m_result_reg, name);
+        m_stream.emitLoad(m_result_reg, 0, m_result_reg,
+                          "load the value of %s", name);
     } else {
-        if (sym->getLevel() == 0) {
-            dumpInstructions(
-                m_output_file.get(),
-                "    la t0, %s\n"
-                "    lw t1, 0(t0)     # load the value of %s\n"
-                "    mv t0, t1\n"
-                "    addi sp, sp, -4\n"
-                "    sw t0, 0(sp)     # push the value to the stack\n",
-                p_variable_ref.getName().c_str(),
-                p_variable_ref.getName().c_str());
-        } else {
-            dumpInstructions(
-                m_output_file.get(),
-                "    lw t0, %d(s0)   # load the value of %s\n"
-                "    addi sp, sp, -4\n"
-                "    sw t0, 0(sp)     # push the value to the stack\n",
-                sym->getOffset(), p_variable_ref.getName().c_str());
-        }
+        emitLoadSlot(m_result_reg, getSlotOffset(*sym), "load the value of %s",
+                     name);
     }
 }
 
 void CodeGenerator::visit(AssignmentNode &p_assignment) {
-    setIsAssignment(true);
-    const_cast<VariableReferenceNode &>(p_assignment.getLvalue()).accept(*this);
-    setIsAssignment(false);
-    const_cast<ExpressionNode &>(p_assignment.getExpr()).accept(*this);
-    dumpInstructions(m_output_file.get(),
-                     "    lw t0, 0(sp)     # pop the value from the stack\n"
-                     "    addi sp, sp, 4\n"
-                     "    lw t1, 0(sp)     # pop the adddress from the stack\n"
-                     "    addi sp, sp, 4\n"
-                     "    sw t0, 0(t1)     # %s = expr\n",
-                     p_assignment.getLvalue().getName().c_str());
+    const auto reg = evaluate(p_assignment.getExpr());
+    emitStore(*p_assignment.getLvalue().getSymbolEntry(), reg);
+    m_registers.release(reg);
 }
 
 void CodeGenerator::visit(ReadNode &p_read) {
-    setIsAssignment(true);
-    p_read.visitChildNodes(*this);
-    setIsAssignment(false);
-    dumpInstructions(m_output_file.get(),
-                     "    jal ra, readInt  # call function `readInt`\n"
-                     "    lw t0, 0(sp)     # pop the address from the stack\n"
-                     "    addi sp, sp, 4\n"
-                     "    sw a0, 0(t0)     # save the return value\n");
+    m_stream.emitCall(kReadIntName, 0, "call function `readInt`");
+    emitStore(*p_read.getTarget().getSymbolEntry(),
+              RegisterPool::getArgumentRegister(0));
 }
 
 void CodeGenerator::visit(IfNode &p_if) {
-    int l1 = m_symbol_manager.getNewLabel();
-    int l2 = m_symbol_manager.getNewLabel();
-    int l3 = m_symbol_manager.getNewLabel();
+    const auto l1 = m_stream.createLabel();
+    const auto l2 = m_stream.createLabel();
+    const auto l3 = m_stream.createLabel();
 
-    const_cast<ExpressionNode &>(p_if.getCondition()).accept(*this);
-    dumpInstructions(m_output_file.get(), "L%d\nL%d:\n", l2, l1);
+    emitBranchIf(p_if.getCondition(), false, l2);
+    m_stream.emitLabel(l1);
     const_cast<CompoundStatementNode &>(p_if.getBody()).accept(*this);
-    dumpInstructions(m_output_file.get(), "    j L%d\nL%d:\n", l3, l2);
+    m_stream.emitJump(l3);
+    m_stream.emitLabel(l2);
     p_if.visitElseBodyChildNodes(*this);
-    dumpInstructions(m_output_file.get(), "L%d:\n", l3);
+    m_stream.emitLabel(l3);
 }
 
 void CodeGenerator::visit(WhileNode &p_while) {
-    int l1 = m_symbol_manager.getNewLabel();
-    int l2 = m_symbol_manager.getNewLabel();
-    int l3 = m_symbol_manager.getNewLabel();
+    if (m_options.rotate_loops) {
+        // The condition guards the entry, and a copy of it at the bottom
+        // branches back, so an iteration takes a single branch.
+        const auto body_label = m_stream.createLabel();
+        const auto exit_label = m_stream.createLabel();
+
+        emitBranchIf(p_while.getCondition(), false, exit_label);
+        emitPreheader(p_while);
+        m_stream.emitLabel(body_label);
+        p_while.getBody().accept(*this);
+        emitBranchIf(p_while.getCondition(), true, body_label);
+        m_stream.emitLabel(exit_label);
+        retireInvariants(p_while);
+        return;
+    }
+
+    const auto l1 = m_stream.createLabel();
+    const auto l2 = m_stream.createLabel();
+    const auto l3 = m_stream.createLabel();
 
-    dumpInstructions(m_output_file.get(), "L%d:\n", l1);
-    const_cast<ExpressionNode &>(p_while.getCondition()).accept(*this);
-    dumpInstructions(m_output_file.get(), "L%d\nL%d:\n", l3, l2);
+    emitPreheader(p_while);
+    m_stream.emitLabel(l1);
+    emitBranchIf(p_while.getCondition(), false, l3);
+    m_stream.emitLabel(l2);
     const_cast<CompoundStatementNode &>(p_while.getBody()).accept(*this);
-    dumpInstructions(m_output_file.get(), "    j L%d\nL%d:\n", l1, l3);
+    m_stream.emitJump(l1);
+    m_stream.emitLabel(l3);
+    retireInvariants(p_while);
 }
 
 void CodeGenerator::visit(ForNode &p_for) {
-    // Reconstruct the scope for looking up the symbol entry.
-    m_symbol_manager.pushScope(
-        std::move(m_symbol_table_of_scoping_nodes.at(&p_for)));
+    if (m_options.count_loops) {
+        emitCountedLoop(p_for);
+        return;
+    }
 
-    int l1 = m_symbol_manager.getNewLabel();
-    int l2 = m_symbol_manager.getNewLabel();
-    int l3 = m_symbol_manager.getNewLabel();
+    const auto l1 = m_stream.createLabel();
+    const auto l2 = m_stream.createLabel();
+    const auto l3 = m_stream.createLabel();
 
     const_cast<DeclNode &>(p_for.getLoopVarDecl()).accept(*this);
-
-    setIsAssignment(true);
     const_cast<AssignmentNode &>(p_for.getInitStmt()).accept(*this);
-    setIsAssignment(false);
-
-    const SymbolEntry *sym =
-        m_symbol_manager.lookup(p_for.getInitStmt().getLvalue().getName());
-
-    dumpInstructions(m_output_file.get(),
-                     "L%d:\n"
-                     "    lw t0, %d(s0)\n"
-                     "    addi sp, sp, -4\n"
-                     "    sw t0, 0(sp)     # push the value to the stack\n",
-                     l1, sym->getOffset());
-    const_cast<ExpressionNode &>(p_for.getEndCondition()).accept(*this);
-    dumpInstructions(m_output_file.get(),
-                     "    lw t0, 0(sp)     # pop the value from the stack\n"
-                     "    addi sp, sp, 4\n"
-                     "    lw t1, 0(sp)     # pop the value from the stack\n"
-                     "    addi sp, sp, 4\n"
-                     "    bge t1, t0, L%d\nL%d:\n",
-                     l3, l2);
+    emitPreheader(p_for);
+
+    const SymbolEntry *sym = p_for.getInitStmt().getLvalue().getSymbolEntry();
+
+    m_stream.emitLabel(l1);
+    const auto var_reg = evaluate(p_for.getInitStmt().getLvalue());
+    const auto end_reg = evaluate(p_for.getEndCondition());
+    m_stream.emitBranch(Opcode::kBge, var_reg, end_reg, l3);
+    m_stream.emitLabel(l2);
+    m_registers.release(var_reg);
+    m_registers.release(end_reg);
+
     const_cast<CompoundStatementNode &>(p_for.getBody()).accept(*this);
-    dumpInstructions(m_output_file.get(),
-                     "    addi t0, s0, %d\n"
-                     "    addi sp, sp, -4\n"
-                     "    sw t0, 0(sp)\n"
-                     "    lw t0, %d(s0)\n"
-                     "    addi sp, sp, -4\n"
-                     "    sw t0, 0(sp)\n"
-                     "    li t0, 1\n"
-                     "    addi sp, sp, -4\n"
-                     "    sw t0, 0(sp)\n"
-                     "    lw t0, 0(sp)\n"
-                     "    addi sp, sp, 4\n"
-                     "    lw t1, 0(sp)\n"
-                     "    addi sp, sp, 4\n"
-                     "    add t0, t1, t0\n"
-                     "    addi sp, sp, -4\n"
-                     "    sw t0, 0(sp)\n"
-                     "    lw t0, 0(sp)\n"
-                     "    addi sp, sp, 4\n"
-                     "    lw t1, 0(sp)\n"
-                     "    addi sp, sp, 4\n"
-                     "    sw t0, 0(t1)\n"
-                     "    j L%d\n"
-                     "L%d:\n",
-                     sym->getOffset(), sym->getOffset(), l1, l3);
-
-    // Remove the entries in the hash table
-    m_symbol_manager.popScope();
+
+    const auto reg = evaluate(p_for.getInitStmt().getLvalue());
+    m_stream.emitImmediate(Opcode::kAddi, reg, reg, 1);
+    emitStore(*sym, reg);
+    m_registers.release(reg);
+    m_stream.emitJump(l1);
+    m_stream.emitLabel(l3);
+    retireInvariants(p_for);
+}
+
+void CodeGenerator::emitPreheader(const AstNode &p_loop) {
+    auto it = m_hoists.find(&p_loop);
+    if (it == m_hoists.end()) {
+        return;
+    }
+    // The invariants of the enclosing loops are in their registers already.
+    for (const auto &hoist : it->second) {
+        const auto reg = evaluate(*hoist.expr);
+        m_stream.emitUnary(Opcode::kMv, hoist.reg, reg,
+                           "hoist the loop invariant");
+        m_registers.release(reg);
+        m_hoisted_values.emplace(hoist.expr, hoist.reg);
+    }
+}
+
+void CodeGenerator::retireInvariants(const AstNode &p_loop) {
+    auto it = m_hoists.find(&p_loop);
+    if (it == m_hoists.end()) {
+        return;
+    }
+    for (const auto &hoist : it->second) {
+        m_hoisted_values.erase(hoist.expr);
+    }
+}
+
+void CodeGenerator::emitCountedLoop(ForNode &p_for) {
+    const SymbolEntry &entry =
+        *p_for.getInitStmt().getLvalue().getSymbolEntry();
+    const int lower = getConstantWord(*p_for.getLowerBound().getConstantPtr());
+    const int upper = getConstantWord(*p_for.getUpperBound().getConstantPtr());
+    // Checked by the semantic analyzer.
+    assert(lower < upper && "The loop never runs");
+    auto &body = p_for.getBody();
+
+    const auto var_reg = getVariableRegister(entry);
+    if (var_reg != RegisterPool::kNoReg) {
+        m_stream.emitLoadImmediate(var_reg, lower);
+    } else {
+        const auto reg = allocateRegister();
+        m_stream.emitLoadImmediate(reg, lower);
+        emitStore(entry, reg);
+        m_registers.release(reg);
+    }
+    if (static_cast<int64_t>(upper) - lower == 1) {
+        body.accept(*this);
+        return;
+    }
+    emitPreheader(p_for);
+
+    const int64_t trip_count = static_cast<int64_t>(upper) - lower;
+    const int64_t factor = getUnrollFactor(trip_count, body);
+    if (factor == trip_count) {
+        body.accept(*this);
+        for (int64_t i = 1; i < trip_count; ++i) {
+            m_registers.release(emitIncrement(entry));
+            body.accept(*this);
+        }
+        retireInvariants(p_for);
+        return;
+    }
+    // The iterations left over by the unrolled ones run before the loop.
+    for (int64_t i = 0; i < trip_count % factor; ++i) {
+        body.accept(*this);
+        m_registers.release(emitIncrement(entry));
+    }
+
+    // The bound is held in a caller-saved register only if nothing in the
+    // body may overwrite it; loading it on each iteration is cheaper than
+    // saving it around the calls.
+    auto end_reg = RegisterPool::kNoReg;
+    if (m_registers.getNumFree() > kMinFreeRegistersInLoop &&
+        !CallFinder::hasCall(body)) {
+        end_reg = allocateRegister();
+        m_stream.emitLoadImmediate(end_reg, upper);
+    }
+
+    const auto body_label = m_stream.createLabel();
+    m_stream.emitLabel(body_label);
+    body.accept(*this);
+    for (int64_t i = 1; i < factor; ++i) {
+        m_registers.release(emitIncrement(entry));
+        body.accept(*this);
+    }
+
+    const auto reg = emitIncrement(entry);
+    if (end_reg == RegisterPool::kNoReg) {
+        end_reg = allocateRegister();
+        m_stream.emitLoadImmediate(end_reg, upper);
+    }
+    m_stream.emitBranch(Opcode::kBlt, reg, end_reg, body_label);
+    m_registers.release(reg);
+    m_registers.release(end_reg);
+    retireInvariants(p_for);
+}
+
+RegisterPool::Reg CodeGenerator::emitIncrement(const SymbolEntry &p_entry) {
+    auto reg = getVariableRegister(p_entry);
+    if (reg != RegisterPool::kNoReg) {
+        m_stream.emitImmediate(Opcode::kAddi, reg, reg, 1);
+        return reg;
+    }
+    reg = allocateRegister();
+    emitLoadSlot(reg, getSlotOffset(p_entry), "load the value of %s",
+                 p_entry.getNameCString());
+    m_stream.emitImmediate(Opcode::kAddi, reg, reg, 1);
+    emitStore(p_entry, reg);
+    return reg;
+}
+
+int64_t CodeGenerator::getUnrollFactor(const int64_t p_trip_count,
+                                       CompoundStatementNode &p_body) {
+    const bool is_short =
+        p_trip_count <= static_cast<int64_t>(m_options.unroll_full_limit);
+    if (!m_options.unroll_loops ||
+        (!is_short && m_options.unroll_factor < 2)) {
+        return 1;
+    }
+
+    // Generate the body once to see how large a copy of it is, along with
+    // the increment of the loop variable. The loops nested in it are
+    // measured while it is, so that each body is generated for measuring
+    // only once, however deep it is nested.
+    auto it = m_copy_sizes.find(&p_body);
+    if (it == m_copy_sizes.end()) {
+        const auto mark = m_stream.getMark();
+        p_body.accept(*this);
+        const auto size =
+            static_cast<int64_t>(m_stream.countInstructionsSince(mark)) + 1;
+        m_stream.rollBack(mark);
+        it = m_copy_sizes.emplace(&p_body, size).first;
+    }
+    const int64_t copy_size = it->second;
+
+    const auto budget = static_cast<int64_t>(m_options.unroll_budget);
+    if (is_short && (p_trip_count - 1) * copy_size <= budget) {
+        return p_trip_count;
+    }
+    // The extra copies are the ones in the loop and the ones before it.
+    for (auto factor = std::min(
+             static_cast<int64_t>(m_options.unroll_factor), p_trip_count / 2);
+         factor >= 2; --factor) {
+        if ((factor - 1 + p_trip_count % factor) * copy_size <= budget) {
+            return factor;
+        }
+    }
+    return 1;
 }
 
 void CodeGenerator::visit(ReturnNode &p_return) {
-    p_return.visitChildNodes(*this);
-    dumpInstructions(m_output_file.get(),
-                     "    lw t0, 0(sp)     # pop the value from the stack\n"
-                     "    addi sp, sp, 4\n"
-                     "    mv a0, t0        # load the value to ret register\n");
+    const auto *call = dynamic_cast<const FunctionInvocationNode *>(
+        &p_return.getReturnValue());
+    if (call && m_tail_calls.count(call) != 0) {
+        // The callee leaves the value in the return register.
+        emitTailCall(*call);
+        return;
+    }
+    const auto reg = evaluate(p_return.getReturnValue());
+    m_stream.emitUnary(Opcode::kMv, RegisterPool::getArgumentRegister(0), reg,
+                       "load the value to ret register");
+    m_stream.emitJump(m_return_label);
+    m_registers.release(reg);
 }
@@ -0,0 +1,113 @@
+#include "codegen/FrameLayoutBuilder.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <limits>
+
+#include "visitor/AstNodeInclude.hpp"
+
+constexpr int FrameLayoutBuilder::kWordSize;
+constexpr int FrameLayoutBuilder::kStackAlignment;
+
+FrameLayoutBuilder::Layout FrameLayoutBuilder::build(
+    FunctionNode &p_function,
+    const LinearScanRegisterAllocator::Allocation &p_allocation) {
+    reset(p_allocation);
+
+    // An array is passed by its address.
+    for (const auto &parameter : p_function.getParameters()) {
+        for (const auto &variable : parameter->getVariables()) {
+            addSlot(*variable->getSymbolEntry(), kWordSize);
+        }
+    }
+    p_function.visitBodyChildNodes(*this);
+    return layOut();
+}
+
+FrameLayoutBuilder::Layout FrameLayoutBuilder::build(
+    CompoundStatementNode &p_body,
+    const LinearScanRegisterAllocator::Allocation &p_allocation) {
+    reset(p_allocation);
+    p_body.accept(*this);
+    return layOut();
+}
+
+std::uint64_t FrameLayoutBuilder::getSize(const PType &p_type) {
+    std::uint64_t size = kWordSize;
+    for (const auto dimension : p_type.getDimensions()) {
+        size *= dimension;
+    }
+    return size;
+}
+
+void FrameLayoutBuilder::reset(
+    const LinearScanRegisterAllocator::Allocation &p_allocation) {
+    m_allocation = &p_allocation;
+    m_scalars = Region{};
+    m_arrays = Region{};
+}
+
+void FrameLayoutBuilder::addSlot(const SymbolEntry &p_entry,
+                                 const std::uint64_t p_size) {
+    if (m_allocation->registers.count(&p_entry) != 0) {
+        return;
+    }
+    Region &region = p_size == kWordSize ? m_scalars : m_arrays;
+    region.top += p_size;
+    region.size = std::max(region.size, region.top);
+    region.slots.emplace_back(&p_entry, region.top);
+}
+
+void FrameLayoutBuilder::visitScope(AstNode &p_node) {
+    const std::uint64_t scalars_top = m_scalars.top;
+    const std::uint64_t arrays_top = m_arrays.top;
+    p_node.visitChildNodes(*this);
+    m_scalars.top = scalars_top;
+    m_arrays.top = arrays_top;
+}
+
+FrameLayoutBuilder::Layout FrameLayoutBuilder::layOut() const {
+    Layout layout;
+    std::uint64_t size = -kFramePointerOffset;
+    for (const auto reg : m_allocation->saved_registers) {
+        size += kWordSize;
+        layout.saved_registers.emplace_back(reg, -static_cast<int>(size));
+    }
+
+    for (const Region *region : {&m_scalars, &m_arrays}) {
+        for (const auto &slot : region->slots) {
+            layout.offsets[slot.first] =
+                -static_cast<int>(size + slot.second);
+        }
+        size += region->size;
+    }
+
+    size = (size + kStackAlignment - 1) / kStackAlignment * kStackAlignment;
+    assert(size <= static_cast<std::uint64_t>(
+                       std::numeric_limits<int>::max()) &&
+           "The stack frame is too large");
+    layout.size = static_cast<int>(size);
+    return layout;
+}
+
+void FrameLayoutBuilder::visit(DeclNode &p_decl) {
+    p_decl.visitChildNodes(*this);
+}
+
+void FrameLayoutBuilder::visit(VariableNode &p_variable) {
+    const SymbolEntry &entry = *p_variable.getSymbolEntry();
+    addSlot(entry, getSize(*entry.getTypePtr()));
+}
+
+void FrameLayoutBuilder::visit(CompoundStatementNode &p_compound_statement) {
+    visitScope(p_compound_statement);
+}
+
+void FrameLayoutBuilder::visit(IfNode &p_if) { p_if.visitChildNodes(*this); }
+
+void FrameLayoutBuilder::visit(WhileNode &p_while) {
+    p_while.visitChildNodes(*this);
+}
+
+void FrameLayoutBuilder::visit(ForNode &p_for) { visitScope(p_for); }
@@ -0,0 +1,155 @@
+#include "codegen/InstructionStream.hpp"
+
+#include <algorithm>
+#include <utility>
+
+void InstructionStream::reset(const std::string &p_label_scope) {
+    m_label_scope = p_label_scope;
+    m_num_labels = 0;
+    m_instructions.clear();
+    m_directives.clear();
+}
+
+void InstructionStream::rollBack(const Mark &p_mark) {
+    m_instructions.erase(m_instructions.begin() + p_mark.num_instructions,
+                         m_instructions.end());
+    m_directives.resize(p_mark.num_directives);
+    m_num_labels = p_mark.num_labels;
+}
+
+std::size_t InstructionStream::countInstructionsSince(
+    const Mark &p_mark) const {
+    return std::count_if(m_instructions.begin() + p_mark.num_instructions,
+                         m_instructions.end(),
+                         [](const MachineInstruction &p_inst) {
+                             return p_inst.opcode != Opcode::kLabel &&
+                                    p_inst.opcode != Opcode::kDirective;
+                         });
+}
+
+MachineInstruction &InstructionStream::append(const Opcode p_opcode) {
+    m_instructions.emplace_back(p_opcode);
+    return m_instructions.back();
+}
+
+void InstructionStream::emitBinary(const Opcode p_opcode, const Reg p_rd,
+                                   const Reg p_rs1, const Reg p_rs2,
+                                   const char *const p_comment) {
+    auto &inst = append(p_opcode);
+    inst.rd = p_rd;
+    inst.rs1 = p_rs1;
+    inst.rs2 = p_rs2;
+    inst.comment = p_comment;
+}
+
+void InstructionStream::emitImmediate(const Opcode p_opcode, const Reg p_rd,
+                                      const Reg p_rs1, const int p_imm,
+                                      const char *const p_comment) {
+    auto &inst = append(p_opcode);
+    inst.rd = p_rd;
+    inst.rs1 = p_rs1;
+    inst.imm = p_imm;
+    inst.comment = p_comment;
+}
+
+void InstructionStream::emitLoadImmediate(const Reg p_rd, const int p_imm) {
+    auto &inst = append(Opcode::kLi);
+    inst.rd = p_rd;
+    inst.imm = p_imm;
+}
+
+void InstructionStream::emitUnary(const Opcode p_opcode, const Reg p_rd,
+                                  const Reg p_rs1, const char *const p_comment,
+                                  const char *const p_symbol) {
+    auto &inst = append(p_opcode);
+    inst.rd = p_rd;
+    inst.rs1 = p_rs1;
+    inst.comment = p_comment;
+    inst.symbol = p_symbol;
+}
+
+void InstructionStream::emitLoad(const Reg p_rd, const int p_offset,
+                                 const Reg p_base, const char *const p_comment,
+                                 const char *const p_symbol) {
+    auto &inst = append(Opcode::kLw);
+    inst.rd = p_rd;
+    inst.rs1 = p_base;
+    inst.imm = p_offset;
+    inst.comment = p_comment;
+    inst.symbol = p_symbol;
+}
+
+void InstructionStream::emitStore(const Reg p_src, const int p_offset,
+                                  const Reg p_base, const char *const p_comment,
+                                  const char *const p_symbol) {
+    auto &inst = append(Opcode::kSw);
+    inst.rs1 = p_base;
+    inst.rs2 = p_src;
+    inst.imm = p_offset;
+    inst.comment = p_comment;
+    inst.symbol = p_symbol;
+}
+
+void InstructionStream::emitLoadAddress(const Reg p_rd,
+                                        const char *const p_symbol) {
+    auto &inst = append(Opcode::kLa);
+    inst.rd = p_rd;
+    inst.symbol = p_symbol;
+}
+
+void InstructionStream::emitBranch(const Opcode p_opcode, const Reg p_rs1,
+                                   const Reg p_rs2, const int p_label) {
+    auto &inst = append(p_opcode);
+    inst.rs1 = p_rs1;
+    inst.rs2 = p_rs2;
+    inst.label = p_label;
+}
+
+void InstructionStream::emitBranchIfZero(const Reg p_rs1, const int p_label) {
+    auto &inst = append(Opcode::kBeqz);
+    inst.rs1 = p_rs1;
+    inst.label = p_label;
+}
+
+void InstructionStream::emitBranchIfNonZero(const Reg p_rs1,
+                                            const int p_label) {
+    auto &inst = append(Opcode::kBnez);
+    inst.rs1 = p_rs1;
+    inst.label = p_label;
+}
+
+void InstructionStream::emitJump(const int p_label) {
+    append(Opcode::kJ).label = p_label;
+}
+
+void InstructionStream::emitCall(const char *const p_symbol,
+                                 const int p_num_arguments,
+                                 const char *const p_comment) {
+    auto &inst = append(Opcode::kJal);
+    inst.rd = RegisterPool::kReturnAddress;
+    inst.imm = p_num_arguments;
+    inst.symbol = p_symbol;
+    inst.comment = p_comment;
+}
+
+void InstructionStream::emitTailCall(const char *const p_symbol,
+                                     const int p_num_arguments,
+                                     const char *const p_comment) {
+    auto &inst = append(Opcode::kTail);
+    inst.imm = p_num_arguments;
+    inst.symbol = p_symbol;
+    inst.comment = p_comment;
+}
+
+void InstructionStream::emitJumpRegister(const Reg p_rs1) {
+    append(Opcode::kJr).rs1 = p_rs1;
+}
+
+void InstructionStream::emitLabel(const int p_label) {
+    append(Opcode::kLabel).label = p_label;
+}
+
+void InstructionStream::emitDirective(std::string p_text) {
+    append(Opcode::kDirective).imm = static_cast<int>(m_directives.size());
+    m_directives.emplace_back(std::move(p_text));
+}
@@ -0,0 +1,559 @@
+#include "codegen/IrCodeGenerator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/RegisterPool.hpp"
+
+namespace {
+// ra and s0 are saved right below the frame pointer.
+constexpr int kFirstLocationOffset = -12;
+constexpr int kWordSize = 4;
+constexpr int kStackAlignment = 16;
+
+bool isImmediate12(const int p_value) {
+    return p_value >= -2048 && p_value <= 2047;
+}
+
+const char *getBranch(const IrOpcode p_opcode) {
+    switch (p_opcode) {
+        case IrOpcode::kEq:
+            return "beq";
+        case IrOpcode::kNe:
+            return "bne";
+        case IrOpcode::kLt:
+            return "blt";
+        case IrOpcode::kLe:
+            return "ble";
+        case IrOpcode::kGt:
+            return "bgt";
+        case IrOpcode::kGe:
+            return "bge";
+        default:
+            assert(false && "not a comparison");
+            return "";
+    }
+}
+
+const char *getInvertedBranch(const IrOpcode p_opcode) {
+    switch (p_opcode) {
+        case IrOpcode::kEq:
+            return "bne";
+        case IrOpcode::kNe:
+            return "beq";
+        case IrOpcode::kLt:
+            return "bge";
+        case IrOpcode::kLe:
+            return "bgt";
+        case IrOpcode::kGt:
+            return "ble";
+        case IrOpcode::kGe:
+            return "blt";
+        default:
+            assert(false && "not a comparison");
+            return "";
+    }
+}
+}  // namespace
+
+IrCodeGenerator::IrCodeGenerator(const std::string &source_file_name,
+                                 const std::string &save_path) {
+    m_output_file.reset(fopen(
+        CodeGenerator::getOutputFilePath(source_file_name, save_path).c_str(),
+        "w"));
+    assert(m_output_file.get() && "Failed to open output file");
+}
+
+void IrCodeGenerator::dumpInstructions(const char *p_format, ...) {
+    va_list args;
+    va_start(args, p_format);
+    vfprintf(m_output_file.get(), p_format, args);
+    va_end(args);
+}
+
+void IrCodeGenerator::generate(const IrModule &p_module) {
+    m_module = &p_module;
+
+    dumpInstructions("    .file \"%s\"\n"
+                     "    .option nopic\n",
+                     p_module.getSourceFilePath().c_str());
+    for (const auto &global : p_module.getGlobals()) {
+        if (!global.is_constant) {
+            dumpInstructions(".comm %s, 4, 4\n", global.name.c_str());
+            continue;
+        }
+        dumpInstructions(".section    .rodata\n"
+                         "    .align 2\n"
+                         "    .globl %s\n"
+                         "    .type %s, @object\n"
+                         "%s:\n"
+                         "    .word %d\n",
+                         global.name.c_str(), global.name.c_str(),
+                         global.name.c_str(), global.initial_value);
+    }
+    for (const auto &function : p_module.getFunctions()) {
+        generateFunction(*function);
+    }
+
+    m_module = nullptr;
+}
+
+int IrCodeGenerator::getSlotOffset(const int p_slot) const {
+    return kFirstLocationOffset - kWordSize * p_slot;
+}
+
+void IrCodeGenerator::layoutFrame() {
+    const std::size_t num_temps = m_function->getNumTemps();
+    std::vector<int> def_blocks(num_temps, -1);
+    std::vector<int> use_counts(num_temps, 0);
+    std::vector<bool> is_block_local(num_temps, true);
+    for (const auto &block : m_function->getBlocks()) {
+        for (const auto &instruction : block->getInstructions()) {
+            if (instruction.hasResult()) {
+                def_blocks[instruction.dst] = block->getId();
+            }
+        }
+    }
+    for (const auto &block : m_function->getBlocks()) {
+        for (const auto &instruction : block->getInstructions()) {
+            // Phis are written and read at the block boundaries.
+            const bool is_phi = instruction.opcode == IrOpcode::kPhi;
+            if (is_phi) {
+                is_block_local[instruction.dst] = false;
+            }
+            for (const auto &operand : instruction.operands) {
+                if (operand.isTemp()) {
+                    ++use_counts[operand.value];
+                    if (is_phi || def_blocks[operand.value] != block->getId()) {
+                        is_block_local[operand.value] = false;
+                    }
+                }
+            }
+        }
+    }
+
+    // A comparison right before the branch that is its only use.
+    m_is_fused.assign(num_temps, false);
+    for (const auto &block : m_function->getBlocks()) {
+        const auto &instructions = block->getInstructions();
+        if (instructions.size() < 2 ||
+            instructions.back().opcode != IrOpcode::kBr) {
+            continue;
+        }
+        const auto &comparison = instructions[instructions.size() - 2];
+        if (comparison.isComparison() &&
+            instructions.back().operands[0] ==
+                IrOperand::temp(comparison.dst) &&
+            use_counts[comparison.dst] == 1) {
+            m_is_fused[comparison.dst] = true;
+        }
+    }
+
+    m_temp_offsets.assign(num_temps, 0);
+    int next_offset = getSlotOffset(
+        static_cast<int>(m_function->getSlots().size()));
+    auto new_location = [&next_offset]() {
+        const int offset = next_offset;
+        next_offset -= kWordSize;
+        return offset;
+    };
+
+    // The temps that cross blocks keep their own locations.
+    for (std::size_t temp = 0; temp < num_temps; ++temp) {
+        if (use_counts[temp] > 0 && !is_block_local[temp]) {
+            m_temp_offsets[temp] = new_location();
+        }
+    }
+    m_phi_shadow_offsets.assign(num_temps, 0);
+    for (const auto &block : m_function->getBlocks()) {
+        for (const auto &instruction : block->getInstructions()) {
+            if (instruction.opcode == IrOpcode::kPhi) {
+                m_phi_shadow_offsets[instruction.dst] = new_location();
+            }
+        }
+    }
+
+    // The others are recycled within their block; all of them are free again
+    // at the start of the next block.
+    std::vector<int> local_locations;
+    std::vector<int> free_locations;
+    std::unordered_map<int, std::size_t> last_uses;
+    for (const auto &block : m_function->getBlocks()) {
+        const auto &instructions = block->getInstructions();
+        free_locations = local_locations;
+        last_uses.clear();
+        for (std::size_t i = 0; i < instructions.size(); ++i) {
+            for (const auto &operand : instructions[i].operands) {
+                if (operand.isTemp()) {
+                    last_uses[operand.value] = i;
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < instructions.size(); ++i) {
+            const auto &instruction = instructions[i];
+            for (const auto &operand : instruction.operands) {
+                if (operand.isTemp() && is_block_local[operand.value] &&
+                    last_uses.at(operand.value) == i &&
+                    m_temp_offsets[operand.value] != 0) {
+                    free_locations.push_back(m_temp_offsets[operand.value]);
+                    // Only release once if used twice by the instruction.
+                    last_uses[operand.value] = instructions.size();
+                }
+            }
+
+            const int dst = instruction.dst;
+            if (!instruction.hasResult() || !is_block_local[dst] ||
+                use_counts[dst] == 0 || isFused(instruction)) {
+                continue;
+            }
+            if (free_locations.empty()) {
+                m_temp_offsets[dst] = new_location();
+                local_locations.push_back(m_temp_offsets[dst]);
+            } else {
+                m_temp_offsets[dst] = free_locations.back();
+                free_locations.pop_back();
+            }
+        }
+    }
+
+    const int size = -(next_offset + kWordSize);
+    m_frame_size = std::max(kStackAlignment, (size + kStackAlignment - 1) /
+                                                 kStackAlignment *
+                                                 kStackAlignment);
+}
+
+bool IrCodeGenerator::isFused(const IrInstruction &p_instruction) const {
+    return p_instruction.hasResult() && m_is_fused[p_instruction.dst];
+}
+
+void IrCodeGenerator::generateFunction(const IrFunction &p_function) {
+    m_function = &p_function;
+    layoutFrame();
+
+    const char *const name = p_function.getNameCString();
+    dumpInstructions("\n.section    .text\n"
+                     "    .align 2\n"
+                     "    .globl %s\n"
+                     "    .type %s, @function\n"
+                     "%s:\n",
+                     name, name, name);
+    emitPrologue();
+
+    const auto &blocks = p_function.getBlocks();
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        const int next = (i + 1 < blocks.size()) ? blocks[i + 1]->getId() : -1;
+        emitBlock(*blocks[i], next);
+    }
+
+    dumpInstructions(".L%s_ret:\n", name);
+    emitEpilogue();
+    dumpInstructions("    .size %s, .-%s\n", name, name);
+
+    m_function = nullptr;
+}
+
+void IrCodeGenerator::emitPrologue() {
+    if (isImmediate12(m_frame_size)) {
+        dumpInstructions("    addi sp, sp, -%d\n"
+                         "    sw ra, %d(sp)\n"
+                         "    sw s0, %d(sp)\n"
+                         "    addi s0, sp, %d\n",
+                         m_frame_size, m_frame_size - 4, m_frame_size - 8,
+                         m_frame_size);
+    } else {
+        // ra is saved first, so it can hold the frame size.
+        dumpInstructions("    sw ra, -4(sp)\n"
+                         "    sw s0, -8(sp)\n"
+                         "    mv s0, sp\n"
+                         "    li ra, %d\n"
+                         "    sub sp, sp, ra\n",
+                         m_frame_size);
+    }
+
+    // From register a0-a7, then the spilled ones from t0-t6; ra is free to
+    // be the scratch register.
+    for (std::size_t i = 0; i < m_function->getNumParameters(); ++i) {
+        emitStoreFrame(
+            RegisterPool::getName(RegisterPool::getArgumentRegister(i)),
+            getSlotOffset(static_cast<int>(i)), "ra");
+    }
+}
+
+void IrCodeGenerator::emitEpilogue() {
+    dumpInstructions("    lw ra, -4(s0)\n"
+                     "    mv sp, s0\n"
+                     "    lw s0, -8(sp)\n"
+                     "    jr ra\n");
+}
+
+void IrCodeGenerator::emitBlock(const IrBasicBlock &p_block,
+                                const int p_next_block_id) {
+    dumpInstructions(".L%s_%d:\n", m_function->getNameCString(),
+                     p_block.getId());
+    for (const auto &instruction : p_block.getInstructions()) {
+        if (instruction.isTerminator()) {
+            emitPhiCopies(p_block);
+        }
+        switch (instruction.opcode) {
+            case IrOpcode::kBr:
+                emitBranch(p_block, p_next_block_id);
+                break;
+            case IrOpcode::kJmp:
+                emitJump(instruction.targets[0], p_next_block_id);
+                break;
+            case IrOpcode::kRet:
+                if (!instruction.operands.empty()) {
+                    emitLoadOperand(instruction.operands[0], "a0");
+                }
+                if (p_next_block_id != -1) {
+                    dumpInstructions("    j .L%s_ret\n",
+                                     m_function->getNameCString());
+                }
+                break;
+            default:
+                if (!isFused(instruction)) {
+                    emitInstruction(instruction);
+                }
+                break;
+        }
+    }
+}
+
+void IrCodeGenerator::emitPhiCopies(const IrBasicBlock &p_block) {
+    for (const int successor : p_block.getSuccessors()) {
+        const auto &instructions =
+            m_function->getBlock(successor).getInstructions();
+        for (const auto &phi : instructions) {
+            if (phi.opcode != IrOpcode::kPhi) {
+                break;
+            }
+            const auto incoming = std::find(phi.targets.begin(),
+                                            phi.targets.end(), p_block.getId());
+            emitLoadOperand(phi.operands[incoming - phi.targets.begin()], "t0");
+            emitStoreFrame("t0", m_phi_shadow_offsets[phi.dst], "t1");
+        }
+    }
+}
+
+void IrCodeGenerator::emitJump(const int p_target, const int p_next_block_id) {
+    if (p_target != p_next_block_id) {
+        dumpInstructions("    j .L%s_%d\n", m_function->getNameCString(),
+                         p_target);
+    }
+}
+
+void IrCodeGenerator::emitBranch(const IrBasicBlock &p_block,
+                                 const int p_next_block_id) {
+    const auto &instructions = p_block.getInstructions();
+    const auto &branch = instructions.back();
+    const int true_target = branch.targets[0];
+    const int false_target = branch.targets[1];
+    const char *const name = m_function->getNameCString();
+
+    if (instructions.size() >= 2 &&
+        isFused(instructions[instructions.size() - 2])) {
+        const auto &comparison = instructions[instructions.size() - 2];
+        emitLoadOperand(comparison.operands[0], "t0");
+        emitLoadOperand(comparison.operands[1], "t1");
+        if (true_target == p_next_block_id) {
+            dumpInstructions("    %s t0, t1, .L%s_%d\n",
+                             getInvertedBranch(comparison.opcode), name,
+                             false_target);
+            return;
+        }
+        dumpInstructions("    %s t0, t1, .L%s_%d\n",
+                         getBranch(comparison.opcode), name, true_target);
+        emitJump(false_target, p_next_block_id);
+        return;
+    }
+
+    emitLoadOperand(branch.operands[0], "t0");
+    if (true_target == p_next_block_id) {
+        dumpInstructions("    beqz t0, .L%s_%d\n", name, false_target);
+        return;
+    }
+    dumpInstructions("    bnez t0, .L%s_%d\n", name, true_target);
+    emitJump(false_target, p_next_block_id);
+}
+
+void IrCodeGenerator::emitInstruction(const IrInstruction &p_instruction) {
+    const auto &operands = p_instruction.operands;
+
+    if (p_instruction.isBinary()) {
+        emitLoadOperand(operands[0], "t0");
+        emitLoadOperand(operands[1], "t1");
+        switch (p_instruction.opcode) {
+            case IrOpcode::kAdd:
+                dumpInstructions("    add t0, t0, t1\n");
+                break;
+            case IrOpcode::kSub:
+                dumpInstructions("    sub t0, t0, t1\n");
+                break;
+            case IrOpcode::kMul:
+                dumpInstructions("    mul t0, t0, t1\n");
+                break;
+            case IrOpcode::kDiv:
+                dumpInstructions("    div t0, t0, t1\n");
+                break;
+            case IrOpcode::kRem:
+                dumpInstructions("    rem t0, t0, t1\n");
+                break;
+            case IrOpcode::kAnd:
+                dumpInstructions("    and t0, t0, t1\n");
+                break;
+            case IrOpcode::kOr:
+                dumpInstructions("    or t0, t0, t1\n");
+                break;
+            case IrOpcode::kEq:
+                dumpInstructions("    sub t0, t0, t1\n"
+                                 "    seqz t0, t0\n");
+                break;
+            case IrOpcode::kNe:
+                dumpInstructions("    sub t0, t0, t1\n"
+                                 "    snez t0, t0\n");
+                break;
+            case IrOpcode::kLt:
+                dumpInstructions("    slt t0, t0, t1\n");
+                break;
+            case IrOpcode::kGt:
+                dumpInstructions("    slt t0, t1, t0\n");
+                break;
+            case IrOpcode::kLe:
+                dumpInstructions("    slt t0, t1, t0\n"
+                                 "    xori t0, t0, 1\n");
+                break;
+            case IrOpcode::kGe:
+                dumpInstructions("    slt t0, t0, t1\n"
+                                 "    xori t0, t0, 1\n");
+                break;
+            default:
+                assert(false && "unknown binary opcode");
+        }
+        emitStoreResult(p_instruction.dst, "t0");
+        return;
+    }
+
+    switch (p_instruction.opcode) {
+        case IrOpcode::kNeg:
+            emitLoadOperand(operands[0], "t0");
+            dumpInstructions("    neg t0, t0\n");
+            emitStoreResult(p_instruction.dst, "t0");
+            break;
+        case IrOpcode::kNot:
+            emitLoadOperand(operands[0], "t0");
+            dumpInstructions("    xori t0, t0, 1\n");
+            emitStoreResult(p_instruction.dst, "t0");
+            break;
+        case IrOpcode::kCopy:
+            emitLoadOperand(operands[0], "t0");
+            emitStoreResult(p_instruction.dst, "t0");
+            break;
+        case IrOpcode::kLoad:
+            if (operands[0].isGlobal()) {
+                const char *const name =
+                    m_module->getGlobals()[operands[0].value].name.c_str();
+                dumpInstructions("    la t0, %s\n"
+                                 "    lw t0, 0(t0)\n",
+                                 name);
+            } else {
+                emitLoadFrame("t0", getSlotOffset(operands[0].value));
+            }
+            emitStoreResult(p_instruction.dst, "t0");
+            break;
+        case IrOpcode::kStore:
+            emitLoadOperand(operands[1], "t0");
+            if (operands[0].isGlobal()) {
+                const char *const name =
+                    m_module->getGlobals()[operands[0].value].name.c_str();
+                dumpInstructions("    la t1, %s\n"
+                                 "    sw t0, 0(t1)\n",
+                                 name);
+            } else {
+                emitStoreFrame("t0", getSlotOffset(operands[0].value), "t1");
+            }
+            break;
+        case IrOpcode::kCall:
+            // Each argument is loaded straight into its register.
+            for (std::size_t i = 0; i < operands.size(); ++i) {
+                emitLoadOperand(operands[i],
+                                RegisterPool::getName(
+                                    RegisterPool::getArgumentRegister(i)));
+            }
+            dumpInstructions("    jal ra, %s\n", p_instruction.callee.c_str());
+            if (p_instruction.hasResult()) {
+                emitStoreResult(p_instruction.dst, "a0");
+            }
+            break;
+        case IrOpcode::kPrint:
+            emitLoadOperand(operands[0], "a0");
+            dumpInstructions("    jal ra, printInt\n");
+            break;
+        case IrOpcode::kRead:
+            dumpInstructions("    jal ra, readInt\n");
+            emitStoreResult(p_instruction.dst, "a0");
+            break;
+        case IrOpcode::kParam:
+            // Saved to its slot by the prologue.
+            emitLoadFrame("t0", getSlotOffset(operands[0].value));
+            emitStoreResult(p_instruction.dst, "t0");
+            break;
+        case IrOpcode::kPhi:
+            emitLoadFrame("t0", m_phi_shadow_offsets[p_instruction.dst]);
+            emitStoreResult(p_instruction.dst, "t0");
+            break;
+        default:
+            assert(false && "unknown opcode");
+    }
+}
+
+void IrCodeGenerator::emitLoadOperand(const IrOperand &p_operand,
+                                      const char *const p_reg) {
+    if (p_operand.isImmediate()) {
+        dumpInstructions("    li %s, %d\n", p_reg, p_operand.value);
+        return;
+    }
+    assert(p_operand.isTemp() && "Only temps and immediates are operands");
+    emitLoadFrame(p_reg, m_temp_offsets[p_operand.value]);
+}
+
+void IrCodeGenerator::emitStoreResult(const int p_dst,
+                                      const char *const p_reg) {
+    // Unused results have no location.
+    if (m_temp_offsets[p_dst] != 0) {
+        emitStoreFrame(p_reg, m_temp_offsets[p_dst], "t2");
+    }
+}
+
+void IrCodeGenerator::emitLoadFrame(const char *const p_reg,
+                                    const int p_offset) {
+    if (isImmediate12(p_offset)) {
+        dumpInstructions("    lw %s, %d(s0)\n", p_reg, p_offset);
+        return;
+    }
+    dumpInstructions("    li %s, %d\n"
+                     "    add %s, s0, %s\n"
+                     "    lw %s, 0(%s)\n",
+                     p_reg, p_offset, p_reg, p_reg, p_reg, p_reg);
+}
+
+void IrCodeGenerator::emitStoreFrame(const char *const p_reg,
+                                     const int p_offset,
+                                     const char *const p_scratch) {
+    if (isImmediate12(p_offset)) {
+        dumpInstructions("    sw %s, %d(s0)\n", p_reg, p_offset);
+        return;
+    }
+    dumpInstructions("    li %s, %d\n"
+                     "    add %s, s0, %s\n"
+                     "    sw %s, 0(%s)\n",
+                     p_scratch, p_offset, p_scratch, p_scratch, p_reg,
+                     p_scratch);
+}
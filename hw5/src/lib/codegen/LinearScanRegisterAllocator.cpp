@@ -0,0 +1,281 @@
+#include "codegen/LinearScanRegisterAllocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "visitor/AstNodeInclude.hpp"
+
+namespace {
+// Beyond this depth every reference weighs the same.
+constexpr int kMaxWeightedLoopDepth = 6;
+// Saving and restoring the register costs two memory accesses, so a variable
+// referenced fewer times than this outside of loops stays in memory.
+constexpr double kMinWeight = 3.0;
+}  // namespace
+
+void LinearScanRegisterAllocator::reset() {
+    m_intervals.clear();
+    m_interval_indices.clear();
+    m_loops.clear();
+    m_position = 0;
+    m_loop_depth = 0;
+}
+
+LinearScanRegisterAllocator::Allocation LinearScanRegisterAllocator::allocate(
+    FunctionNode &p_function) {
+    reset();
+
+    // The parameters are defined on entry.
+    for (const auto &parameter : p_function.getParameters()) {
+        for (const auto &variable : parameter->getVariables()) {
+            declare(*variable->getSymbolEntry());
+            touch(*variable->getSymbolEntry());
+        }
+    }
+    p_function.visitBodyChildNodes(*this);
+
+    extendOverLoops();
+    return scan();
+}
+
+LinearScanRegisterAllocator::Allocation LinearScanRegisterAllocator::allocate(
+    CompoundStatementNode &p_body) {
+    reset();
+    p_body.accept(*this);
+
+    extendOverLoops();
+    return scan();
+}
+
+const SymbolEntry *LinearScanRegisterAllocator::getCandidate(
+    const SymbolEntry *const p_entry) const {
+    if (!p_entry || p_entry->getLevel() == 0) {
+        return nullptr;
+    }
+    switch (p_entry->getKind()) {
+        case SymbolEntry::KindEnum::kParameterKind:
+        case SymbolEntry::KindEnum::kVariableKind:
+        case SymbolEntry::KindEnum::kLoopVarKind:
+        case SymbolEntry::KindEnum::kConstantKind:
+            break;
+        default:
+            return nullptr;
+    }
+    // Only the values that fit in a word.
+    const PType *type = p_entry->getTypePtr();
+    if (!type->isInteger() && !type->isBool()) {
+        return nullptr;
+    }
+    return p_entry;
+}
+
+void LinearScanRegisterAllocator::declare(const SymbolEntry &p_entry) {
+    m_interval_indices[&p_entry] = m_intervals.size();
+    m_intervals.push_back({&p_entry, m_position, -1, -1, 0.0});
+}
+
+void LinearScanRegisterAllocator::touch(const SymbolEntry &p_entry) {
+    auto it = m_interval_indices.find(&p_entry);
+    assert(it != m_interval_indices.end() && "Touch an undeclared variable");
+
+    auto &interval = m_intervals[it->second];
+    ++m_position;
+    if (interval.start < 0) {
+        interval.start = m_position;
+    }
+    interval.end = m_position;
+    interval.weight +=
+        std::pow(10.0, std::min(m_loop_depth, kMaxWeightedLoopDepth));
+}
+
+void LinearScanRegisterAllocator::extendOverLoops() {
+    // Stretching over an inner loop may make the interval overlap an outer
+    // one, so repeat until nothing changes.
+    bool is_changed = true;
+    while (is_changed) {
+        is_changed = false;
+        for (const auto &loop : m_loops) {
+            for (auto &interval : m_intervals) {
+                if (interval.start < 0 || interval.declared >= loop.start ||
+                    interval.start > loop.end || interval.end < loop.start) {
+                    continue;
+                }
+                if (interval.start > loop.start || interval.end < loop.end) {
+                    interval.start = std::min(interval.start, loop.start);
+                    interval.end = std::max(interval.end, loop.end);
+                    is_changed = true;
+                }
+            }
+        }
+    }
+}
+
+LinearScanRegisterAllocator::Allocation LinearScanRegisterAllocator::scan() {
+    std::vector<LiveInterval *> intervals;
+    for (auto &interval : m_intervals) {
+        // Never referenced or too cold to be worth a register.
+        if (interval.start >= 0 && interval.weight >= kMinWeight) {
+            intervals.push_back(&interval);
+        }
+    }
+    std::stable_sort(intervals.begin(), intervals.end(),
+                     [](const LiveInterval *lhs, const LiveInterval *rhs) {
+                         return lhs->start < rhs->start;
+                     });
+
+    std::unordered_map<const LiveInterval *, std::size_t> assigned;
+    std::vector<const LiveInterval *> active;
+    std::vector<bool> is_free(RegisterPool::kNumSavedRegisters + 1, true);
+
+    for (const LiveInterval *interval : intervals) {
+        // Expire the intervals that end before this one starts.
+        for (auto it = active.begin(); it != active.end();) {
+            if ((*it)->end < interval->start) {
+                is_free[assigned.at(*it)] = true;
+                it = active.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        std::size_t number = 1;
+        while (number <= RegisterPool::kNumSavedRegisters && !is_free[number]) {
+            ++number;
+        }
+        if (number <= RegisterPool::kNumSavedRegisters) {
+            is_free[number] = false;
+            assigned[interval] = number;
+            active.push_back(interval);
+            continue;
+        }
+
+        // Spill the coldest one; on a tie, the one that ends last.
+        auto coldest = std::min_element(
+            active.begin(), active.end(),
+            [](const LiveInterval *lhs, const LiveInterval *rhs) {
+                return lhs->weight < rhs->weight ||
+                       (lhs->weight == rhs->weight && lhs->end > rhs->end);
+            });
+        if ((*coldest)->weight < interval->weight ||
+            ((*coldest)->weight == interval->weight &&
+             (*coldest)->end > interval->end)) {
+            assigned[interval] = assigned.at(*coldest);
+            assigned.erase(*coldest);
+            *coldest = interval;
+        }
+    }
+
+    Allocation allocation;
+    std::vector<bool> is_used(RegisterPool::kNumSavedRegisters + 1, false);
+    for (const auto &interval : m_intervals) {
+        auto it = assigned.find(&interval);
+        if (it == assigned.end()) {
+            continue;
+        }
+        allocation.registers[interval.entry] =
+            RegisterPool::getSavedRegister(it->second);
+        is_used[it->second] = true;
+    }
+    for (std::size_t number = 1; number <= RegisterPool::kNumSavedRegisters;
+         ++number) {
+        if (is_used[number]) {
+            allocation.saved_registers.push_back(
+                RegisterPool::getSavedRegister(number));
+        }
+    }
+    return allocation;
+}
+
+void LinearScanRegisterAllocator::visit(DeclNode &p_decl) {
+    p_decl.visitChildNodes(*this);
+}
+
+void LinearScanRegisterAllocator::visit(VariableNode &p_variable) {
+    const SymbolEntry *entry = getCandidate(p_variable.getSymbolEntry());
+    if (!entry) {
+        return;
+    }
+    declare(*entry);
+    // A constant is defined by its declaration.
+    if (entry->getKind() == SymbolEntry::KindEnum::kConstantKind) {
+        touch(*entry);
+    }
+}
+
+void LinearScanRegisterAllocator::visit(
+    CompoundStatementNode &p_compound_statement) {
+    p_compound_statement.visitChildNodes(*this);
+}
+
+void LinearScanRegisterAllocator::visit(PrintNode &p_print) {
+    p_print.visitChildNodes(*this);
+}
+
+void LinearScanRegisterAllocator::visit(BinaryOperatorNode &p_bin_op) {
+    p_bin_op.visitChildNodes(*this);
+}
+
+void LinearScanRegisterAllocator::visit(UnaryOperatorNode &p_un_op) {
+    p_un_op.visitChildNodes(*this);
+}
+
+void LinearScanRegisterAllocator::visit(
+    FunctionInvocationNode &p_func_invocation) {
+    p_func_invocation.visitChildNodes(*this);
+}
+
+void LinearScanRegisterAllocator::visit(VariableReferenceNode &p_variable_ref) {
+    p_variable_ref.visitChildNodes(*this);
+
+    // A name not declared in the function is a global one.
+    const SymbolEntry *entry = getCandidate(p_variable_ref.getSymbolEntry());
+    if (entry && m_interval_indices.count(entry) != 0) {
+        touch(*entry);
+    }
+}
+
+void LinearScanRegisterAllocator::visit(AssignmentNode &p_assignment) {
+    p_assignment.visitChildNodes(*this);
+}
+
+void LinearScanRegisterAllocator::visit(ReadNode &p_read) {
+    p_read.visitChildNodes(*this);
+}
+
+void LinearScanRegisterAllocator::visit(IfNode &p_if) {
+    p_if.visitChildNodes(*this);
+}
+
+void LinearScanRegisterAllocator::visit(WhileNode &p_while) {
+    const int start = ++m_position;
+    ++m_loop_depth;
+    p_while.visitChildNodes(*this);
+    --m_loop_depth;
+    m_loops.push_back({start, ++m_position});
+}
+
+void LinearScanRegisterAllocator::visit(ForNode &p_for) {
+    const_cast<DeclNode &>(p_for.getLoopVarDecl()).accept(*this);
+    const_cast<AssignmentNode &>(p_for.getInitStmt()).accept(*this);
+
+    const int start = ++m_position;
+    ++m_loop_depth;
+    // The loop variable is compared on each iteration...
+    const_cast<VariableReferenceNode &>(p_for.getInitStmt().getLvalue())
+        .accept(*this);
+    const_cast<ExpressionNode &>(p_for.getEndCondition()).accept(*this);
+    const_cast<CompoundStatementNode &>(p_for.getBody()).accept(*this);
+    // ...and incremented at the end of it.
+    const_cast<VariableReferenceNode &>(p_for.getInitStmt().getLvalue())
+        .accept(*this);
+    --m_loop_depth;
+    m_loops.push_back({start, ++m_position});
+}
+
+void LinearScanRegisterAllocator::visit(ReturnNode &p_return) {
+    p_return.visitChildNodes(*this);
+}
@@ -0,0 +1,303 @@
+#include "codegen/LoopInvariantHoister.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+#include "sema/SymbolTable.hpp"
+#include "visitor/AstNodeInclude.hpp"
+
+constexpr int LoopInvariantHoister::kMinCost;
+
+namespace {
+std::vector<const ExpressionNode *> getOperands(const ExpressionNode &p_expr) {
+    std::vector<const ExpressionNode *> operands;
+    if (const auto *bin_op =
+            dynamic_cast<const BinaryOperatorNode *>(&p_expr)) {
+        operands.push_back(&bin_op->getLeftOperand());
+        operands.push_back(&bin_op->getRightOperand());
+    } else if (const auto *un_op =
+                   dynamic_cast<const UnaryOperatorNode *>(&p_expr)) {
+        operands.push_back(&un_op->getOperand());
+    } else if (const auto *ref =
+                   dynamic_cast<const VariableReferenceNode *>(&p_expr)) {
+        for (const auto &index : ref->getIndices()) {
+            operands.push_back(index.get());
+        }
+    } else if (const auto *call =
+                   dynamic_cast<const FunctionInvocationNode *>(&p_expr)) {
+        for (const auto &argument : call->getArguments()) {
+            operands.push_back(argument.get());
+        }
+    }
+    return operands;
+}
+}  // namespace
+
+void LoopInvariantHoister::reset(
+    const SideEffectAnalyzer::Summary &p_side_effects,
+    const LinearScanRegisterAllocator::Allocation &p_allocation) {
+    m_side_effects = &p_side_effects;
+    m_allocation = &p_allocation;
+    m_loops.clear();
+    m_depths.clear();
+}
+
+void LoopInvariantHoister::beginPass(const bool p_is_picking) {
+    m_is_picking = p_is_picking;
+    m_num_visited_loops = 0;
+    m_open_loops.clear();
+}
+
+LoopInvariantHoister::Plan LoopInvariantHoister::plan(
+    FunctionNode &p_function, const SideEffectAnalyzer::Summary &p_side_effects,
+    LinearScanRegisterAllocator::Allocation &p_allocation) {
+    reset(p_side_effects, p_allocation);
+    for (const bool is_picking : {false, true}) {
+        beginPass(is_picking);
+        p_function.visitBodyChildNodes(*this);
+    }
+    return assignRegisters(p_allocation);
+}
+
+LoopInvariantHoister::Plan LoopInvariantHoister::plan(
+    CompoundStatementNode &p_body,
+    const SideEffectAnalyzer::Summary &p_side_effects,
+    LinearScanRegisterAllocator::Allocation &p_allocation) {
+    reset(p_side_effects, p_allocation);
+    for (const bool is_picking : {false, true}) {
+        beginPass(is_picking);
+        p_body.accept(*this);
+    }
+    return assignRegisters(p_allocation);
+}
+
+void LoopInvariantHoister::write(const SymbolEntry *const p_entry) {
+    if (m_is_picking) {
+        return;
+    }
+    for (const auto index : m_open_loops) {
+        m_loops[index].written.insert(p_entry);
+    }
+}
+
+void LoopInvariantHoister::writeCallees(const ExpressionNode &p_expr) {
+    if (const auto *call =
+            dynamic_cast<const FunctionInvocationNode *>(&p_expr)) {
+        auto it = m_side_effects->find(call->getNameCString());
+        if (it != m_side_effects->end()) {
+            for (const SymbolEntry *global : it->second) {
+                write(global);
+            }
+        }
+    }
+    for (const ExpressionNode *operand : getOperands(p_expr)) {
+        writeCallees(*operand);
+    }
+}
+
+void LoopInvariantHoister::visitExpression(const ExpressionNode &p_expr) {
+    if (!m_is_picking) {
+        writeCallees(p_expr);
+        return;
+    }
+    if (!m_open_loops.empty()) {
+        measure(p_expr);
+        pick(p_expr, m_open_loops.size());
+    }
+}
+
+std::size_t LoopInvariantHoister::measure(const ExpressionNode &p_expr) {
+    const std::size_t num_open_loops = m_open_loops.size();
+    std::size_t depth = 0;
+    for (const ExpressionNode *operand : getOperands(p_expr)) {
+        depth = std::max(depth, measure(*operand));
+    }
+
+    if (dynamic_cast<const FunctionInvocationNode *>(&p_expr)) {
+        depth = num_open_loops;
+    } else if (const auto *ref =
+                   dynamic_cast<const VariableReferenceNode *>(&p_expr)) {
+        // An element of an array is never kept in a register.
+        if (!ref->getIndices().empty()) {
+            depth = num_open_loops;
+        }
+        for (std::size_t i = num_open_loops; i > depth; --i) {
+            if (m_loops[m_open_loops[i - 1]].written.count(
+                    ref->getSymbolEntry()) != 0) {
+                depth = i;
+                break;
+            }
+        }
+    }
+    m_depths[&p_expr] = depth;
+    return depth;
+}
+
+void LoopInvariantHoister::pick(const ExpressionNode &p_expr,
+                                std::size_t p_depth) {
+    const std::size_t depth = m_depths.at(&p_expr);
+    if (depth < p_depth && getCost(p_expr) >= kMinCost) {
+        m_loops[m_open_loops[depth]].invariants.push_back(&p_expr);
+        p_depth = depth;
+    }
+    for (const ExpressionNode *operand : getOperands(p_expr)) {
+        pick(*operand, p_depth);
+    }
+}
+
+int LoopInvariantHoister::getCost(const ExpressionNode &p_expr) const {
+    if (dynamic_cast<const ConstantValueNode *>(&p_expr)) {
+        return 1;
+    }
+    if (const auto *ref =
+            dynamic_cast<const VariableReferenceNode *>(&p_expr)) {
+        const SymbolEntry *entry = ref->getSymbolEntry();
+        if (entry->getLevel() == 0) {
+            return 2;
+        }
+        return m_allocation->registers.count(entry) != 0 ? 0 : 1;
+    }
+    int cost = 1;
+    for (const ExpressionNode *operand : getOperands(p_expr)) {
+        cost += getCost(*operand);
+    }
+    return cost;
+}
+
+LoopInvariantHoister::Plan LoopInvariantHoister::assignRegisters(
+    LinearScanRegisterAllocator::Allocation &p_allocation) const {
+    std::vector<RegisterPool::Reg> free_registers;
+    for (std::size_t number = 1; number <= RegisterPool::kNumSavedRegisters;
+         ++number) {
+        const auto reg = RegisterPool::getSavedRegister(number);
+        const auto &saved = p_allocation.saved_registers;
+        if (std::find(saved.begin(), saved.end(), reg) == saved.end()) {
+            free_registers.push_back(reg);
+        }
+    }
+
+    // The value of a loop lives until the loop ends, so the loops inside it
+    // take other registers; a loop takes the rest in turn.
+    Plan plan;
+    std::vector<std::vector<RegisterPool::Reg>> registers_in_use(
+        m_loops.size());
+    std::vector<RegisterPool::Reg> used;
+    for (std::size_t i = 0; i < m_loops.size(); ++i) {
+        const Loop &loop = m_loops[i];
+        auto &in_use = registers_in_use[i];
+        if (loop.parent >= 0) {
+            in_use = registers_in_use[loop.parent];
+        }
+        for (const ExpressionNode *invariant : loop.invariants) {
+            auto it = std::find_if(
+                free_registers.begin(), free_registers.end(),
+                [&in_use](const RegisterPool::Reg p_reg) {
+                    return std::find(in_use.begin(), in_use.end(), p_reg) ==
+                           in_use.end();
+                });
+            if (it == free_registers.end()) {
+                break;
+            }
+            in_use.push_back(*it);
+            plan[loop.node].push_back({invariant, *it});
+            if (std::find(used.begin(), used.end(), *it) == used.end()) {
+                used.push_back(*it);
+            }
+        }
+    }
+
+    auto &saved = p_allocation.saved_registers;
+    saved.insert(saved.end(), used.begin(), used.end());
+    std::sort(saved.begin(), saved.end());
+    return plan;
+}
+
+void LoopInvariantHoister::visit(VariableNode &p_variable) {
+    write(p_variable.getSymbolEntry());
+}
+
+void LoopInvariantHoister::visit(DeclNode &p_decl) {
+    p_decl.visitChildNodes(*this);
+}
+
+void LoopInvariantHoister::visit(CompoundStatementNode &p_compound_statement) {
+    p_compound_statement.visitChildNodes(*this);
+}
+
+void LoopInvariantHoister::visit(PrintNode &p_print) {
+    visitExpression(p_print.getTarget());
+}
+
+void LoopInvariantHoister::visit(AssignmentNode &p_assignment) {
+    const auto &target = p_assignment.getLvalue();
+    write(target.getSymbolEntry());
+    for (const auto &index : target.getIndices()) {
+        visitExpression(*index);
+    }
+    visitExpression(p_assignment.getExpr());
+}
+
+void LoopInvariantHoister::visit(ReadNode &p_read) {
+    const auto &target = p_read.getTarget();
+    write(target.getSymbolEntry());
+    for (const auto &index : target.getIndices()) {
+        visitExpression(*index);
+    }
+}
+
+void LoopInvariantHoister::visit(IfNode &p_if) {
+    visitExpression(p_if.getCondition());
+    p_if.getBody().accept(*this);
+    if (p_if.hasElseBody()) {
+        p_if.getElseBody().accept(*this);
+    }
+}
+
+void LoopInvariantHoister::visitLoop(const AstNode &p_loop,
+                                     const ExpressionNode *const p_condition,
+                                     DeclNode *const p_loop_var_decl,
+                                     CompoundStatementNode &p_body) {
+    const std::size_t index = m_num_visited_loops++;
+    if (!m_is_picking) {
+        m_loops.push_back({&p_loop,
+                           m_open_loops.empty()
+                               ? -1
+                               : static_cast<int>(m_open_loops.back()),
+                           {},
+                           {}});
+    }
+    m_open_loops.push_back(index);
+    if (p_loop_var_decl) {
+        p_loop_var_decl->accept(*this);
+    }
+    if (p_condition) {
+        visitExpression(*p_condition);
+    }
+    p_body.accept(*this);
+    m_open_loops.pop_back();
+}
+
+void LoopInvariantHoister::visit(WhileNode &p_while) {
+    visitLoop(p_while, &p_while.getCondition(), nullptr, p_while.getBody());
+}
+
+void LoopInvariantHoister::visit(ForNode &p_for) {
+    auto &loop_var_decl = const_cast<DeclNode &>(p_for.getLoopVarDecl());
+    const auto lower = p_for.getLowerBound().getConstantPtr()->integer();
+    const auto upper = p_for.getUpperBound().getConstantPtr()->integer();
+    if (upper - lower == 1) {
+        loop_var_decl.accept(*this);
+        p_for.getBody().accept(*this);
+        return;
+    }
+    visitLoop(p_for, nullptr, &loop_var_decl, p_for.getBody());
+}
+
+void LoopInvariantHoister::visit(ReturnNode &p_return) {
+    visitExpression(p_return.getReturnValue());
+}
+
+void LoopInvariantHoister::visit(FunctionInvocationNode &p_func_invocation) {
+    visitExpression(p_func_invocation);
+}
@@ -0,0 +1,22 @@
+#include "codegen/MachineInstruction.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+namespace {
+// In the order of `MachineInstruction::Opcode`.
+const char *const kMnemonics[] = {
+    "add", "sub", "mul", "div", "rem", "and", "or", "slt",     // R-type
+    "addi", "xori", "li",                                      // immediate
+    "mv", "neg", "seqz", "snez",                               // unary
+    "lw", "sw", "la",                                          // memory
+    "beq", "bne", "blt", "bge", "ble", "bgt", "beqz", "bnez",  // branch
+    "j", "jal", "j", "jr",                                     // jump
+    nullptr, nullptr};                                         // label, directive
+}  // namespace
+
+const char *MachineInstruction::getMnemonic(const Opcode p_opcode) {
+    const auto index = static_cast<std::size_t>(p_opcode);
+    assert(index < sizeof(kMnemonics) / sizeof(kMnemonics[0]));
+    return kMnemonics[index];
+}
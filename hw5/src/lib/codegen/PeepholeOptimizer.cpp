@@ -0,0 +1,269 @@
+#include "codegen/PeepholeOptimizer.hpp"
+
+#include <cassert>
+
+#include "codegen/InstructionStream.hpp"
+
+constexpr std::size_t PeepholeOptimizer::kWindowSize;
+
+namespace {
+using Opcode = MachineInstruction::Opcode;
+
+constexpr RegisterPool::Reg kSp = RegisterPool::kStackPointer;
+
+const char *const kRuleNames[PeepholeOptimizer::kNumRules] = {
+    "push/pop pairs",  "forwarded stores", "redundant stores",
+    "redundant moves", "folded moves",     "merged stack adjustments"};
+
+bool isStackAdjustment(const MachineInstruction &p_inst) {
+    return p_inst.opcode == Opcode::kAddi && p_inst.rd == kSp &&
+           p_inst.rs1 == kSp;
+}
+
+bool isMove(const MachineInstruction &p_inst) {
+    return p_inst.opcode == Opcode::kMv;
+}
+
+MachineInstruction makeMove(const RegisterPool::Reg p_rd,
+                            const RegisterPool::Reg p_rs1) {
+    MachineInstruction move{Opcode::kMv};
+    move.rd = p_rd;
+    move.rs1 = p_rs1;
+    return move;
+}
+}  // namespace
+
+void PeepholeOptimizer::Stats::merge(const Stats &p_other) {
+    for (std::size_t i = 0; i < kNumRules; ++i) {
+        hits[i] += p_other.hits[i];
+    }
+}
+
+const char *PeepholeOptimizer::getRuleName(const Rule p_rule) {
+    assert(p_rule < kNumRules);
+    return kRuleNames[p_rule];
+}
+
+void PeepholeOptimizer::run(InstructionStream &p_stream, Stats &p_stats) {
+    m_stats = &p_stats;
+    auto &instructions = p_stream.getInstructions();
+    m_output.clear();
+    m_output.reserve(instructions.size());
+    for (auto it = instructions.cbegin(); it != instructions.cend(); ++it) {
+        m_output.push_back(*it);
+        simplifyTail(it + 1, instructions.cend());
+    }
+    instructions.swap(m_output);
+    m_stats = nullptr;
+}
+
+void PeepholeOptimizer::simplifyTail(const Iterator p_next,
+                                     const Iterator p_end) {
+    while (!m_output.empty() &&
+           (cancelPushPop() || forwardStore() || removeRedundantStore() ||
+            removeRedundantMove() || foldMove(p_next, p_end) ||
+            mergeStackAdjustments())) {
+    }
+}
+
+bool PeepholeOptimizer::cancelPushPop() {
+    const std::size_t size = m_output.size();
+    if (size < 4 || !isStackAdjustment(m_output[size - 1]) ||
+        m_output[size - 1].imm != 4) {
+        return false;
+    }
+    const auto &pop = m_output[size - 2];
+    if (pop.opcode != Opcode::kLw || pop.rs1 != kSp || pop.imm != 0) {
+        return false;
+    }
+
+    // The push is the closest instruction before the pop that uses `sp`.
+    std::size_t push = size - 3;
+    for (;; --push) {
+        if (push == 0 || size - 2 - push > kWindowSize ||
+            m_output[push].isControlFlow()) {
+            return false;
+        }
+        if (m_output[push].refersTo(kSp)) {
+            break;
+        }
+    }
+    // The push may share its adjustment with the ones before it.
+    const auto &store = m_output[push];
+    const auto &adjustment = m_output[push - 1];
+    if (store.opcode != Opcode::kSw || store.imm != 0 ||
+        !isStackAdjustment(adjustment)) {
+        return false;
+    }
+    const Reg value = store.rs2;
+    for (std::size_t i = push + 1; i < size - 2; ++i) {
+        if (m_output[i].getDefinedRegister() == value) {
+            return false;
+        }
+    }
+
+    const auto move = makeMove(pop.rd, value);
+    m_output.erase(m_output.end() - 2, m_output.end());
+    m_output.erase(m_output.begin() + push);
+    if (adjustment.imm == -4) {
+        m_output.erase(m_output.begin() + (push - 1));
+    } else {
+        m_output[push - 1].imm += 4;
+    }
+    m_output.push_back(move);
+    ++m_stats->hits[kPushPop];
+    return true;
+}
+
+bool PeepholeOptimizer::forwardStore() {
+    // A pop is left to `cancelPushPop()`, which drops the push as well.
+    auto &load = m_output.back();
+    if (load.opcode != Opcode::kLw || load.rs1 == kSp) {
+        return false;
+    }
+
+    // Stores through another base register may write the same word.
+    const std::size_t size = m_output.size();
+    std::size_t store = size - 1;
+    for (;;) {
+        if (store == 0 || size - store > kWindowSize) {
+            return false;
+        }
+        const auto &inst = m_output[--store];
+        if (inst.isControlFlow() ||
+            inst.getDefinedRegister() == load.rs1) {
+            return false;
+        }
+        if (inst.opcode == Opcode::kSw) {
+            if (inst.rs1 != load.rs1) {
+                return false;
+            }
+            if (inst.imm == load.imm) {
+                break;
+            }
+        }
+    }
+    const Reg value = m_output[store].rs2;
+    for (std::size_t i = store + 1; i < size - 1; ++i) {
+        if (m_output[i].getDefinedRegister() == value) {
+            return false;
+        }
+    }
+
+    ++m_stats->hits[kStoreLoad];
+    if (load.rd == value) {
+        m_output.pop_back();
+        return true;
+    }
+    load.opcode = Opcode::kMv;
+    load.rs1 = value;
+    load.imm = 0;
+    return true;
+}
+
+bool PeepholeOptimizer::removeRedundantStore() {
+    const std::size_t size = m_output.size();
+    if (size < 2) {
+        return false;
+    }
+    const auto &load = m_output[size - 2];
+    const auto &store = m_output[size - 1];
+    if (load.opcode != Opcode::kLw || store.opcode != Opcode::kSw ||
+        load.rd != store.rs2 || load.rs1 != store.rs1 ||
+        load.imm != store.imm || load.rd == load.rs1) {
+        return false;
+    }
+    m_output.pop_back();
+    ++m_stats->hits[kRedundantStore];
+    return true;
+}
+
+bool PeepholeOptimizer::removeRedundantMove() {
+    const auto &last = m_output.back();
+    if (!isMove(last)) {
+        return false;
+    }
+    const std::size_t size = m_output.size();
+    const bool is_redundant =
+        last.rd == last.rs1 ||
+        (size >= 2 && isMove(m_output[size - 2]) &&
+         m_output[size - 2].rd == last.rs1 &&
+         m_output[size - 2].rs1 == last.rd);
+    if (!is_redundant) {
+        return false;
+    }
+    m_output.pop_back();
+    ++m_stats->hits[kRedundantMove];
+    return true;
+}
+
+bool PeepholeOptimizer::foldMove(const Iterator p_next, const Iterator p_end) {
+    const std::size_t size = m_output.size();
+    if (size < 2 || !isMove(m_output[size - 1])) {
+        return false;
+    }
+    const auto &move = m_output[size - 1];
+    auto &def = m_output[size - 2];
+    const Reg temp = move.rs1;
+    // Only the instructions up to `la` compute nothing but their `rd`.
+    if (def.opcode > Opcode::kLa || def.rd != temp ||
+        !RegisterPool::isTemporary(temp) || isLiveAfter(temp, p_next, p_end)) {
+        return false;
+    }
+
+    def.rd = move.rd;
+    if (move.comment && !def.comment && def.opcode != Opcode::kLa) {
+        def.comment = move.comment;
+        def.symbol = move.symbol;
+    }
+    m_output.pop_back();
+    ++m_stats->hits[kMoveFolding];
+    return true;
+}
+
+bool PeepholeOptimizer::mergeStackAdjustments() {
+    const std::size_t size = m_output.size();
+    if (size < 2 || !isStackAdjustment(m_output[size - 1]) ||
+        !isStackAdjustment(m_output[size - 2])) {
+        return false;
+    }
+    const int amount = m_output[size - 2].imm + m_output[size - 1].imm;
+    m_output.pop_back();
+    if (amount == 0) {
+        m_output.pop_back();
+    } else {
+        m_output.back().imm = amount;
+    }
+    ++m_stats->hits[kStackAdjustment];
+    return true;
+}
+
+bool PeepholeOptimizer::isLiveAfter(const Reg p_reg, const Iterator p_next,
+                                    const Iterator p_end) {
+    const Iterator last =
+        static_cast<std::size_t>(p_end - p_next) > kWindowSize
+            ? p_next + kWindowSize
+            : p_end;
+    for (auto it = p_next; it != last; ++it) {
+        if (it->reads(p_reg)) {
+            return true;
+        }
+        if (it->opcode == Opcode::kJal || it->opcode == Opcode::kTail) {
+            // The callee reads its arguments and may overwrite the rest of
+            // the registers of the pool.
+            for (int i = 0; i < it->imm; ++i) {
+                if (RegisterPool::getArgumentRegister(i) == p_reg) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        if (it->isControlFlow()) {
+            return true;
+        }
+        if (it->getDefinedRegister() == p_reg) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,90 @@
+#include "codegen/RegisterPool.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace {
+// t0-t6 come first so that indices 0-6 are the temporaries, followed by a0-a7
+// and then the callee-saved s1-s11, which are not managed by the pool, and
+// the registers with a fixed role.
+constexpr std::size_t kNumNamedRegisters =
+    static_cast<std::size_t>(RegisterPool::kFramePointer) + 1;
+const char *const kRegisterNames[kNumNamedRegisters] = {
+    "t0", "t1", "t2", "t3", "t4", "t5", "t6", "a0", "a1", "a2",
+    "a3", "a4", "a5", "a6", "a7", "s1", "s2", "s3", "s4", "s5",
+    "s6", "s7", "s8", "s9", "s10", "s11", "ra", "sp", "s0"};
+
+constexpr RegisterPool::Reg kFirstTemporary = 0;
+constexpr RegisterPool::Reg kFirstArgument = 7;
+constexpr std::size_t kNumTemporaries = 7;
+constexpr std::size_t kNumArguments = 8;
+
+// The order in which `allocate()` hands out registers.
+const RegisterPool::Reg kAllocationOrder[RegisterPool::kNumRegisters] = {
+    0, 1, 2, 3, 4, 5, 6, 14, 13, 12, 11, 10, 9, 8, 7};
+}  // namespace
+
+const char *RegisterPool::getName(const Reg p_reg) {
+    assert(p_reg >= 0 &&
+           static_cast<std::size_t>(p_reg) < kNumNamedRegisters);
+    return kRegisterNames[p_reg];
+}
+
+RegisterPool::Reg RegisterPool::getArgumentRegister(const std::size_t p_nth) {
+    assert(p_nth < kNumArguments + kNumTemporaries &&
+           "Too many arguments to be passed through registers");
+    if (p_nth < kNumArguments) {
+        return kFirstArgument + static_cast<Reg>(p_nth);
+    }
+    return kFirstTemporary + static_cast<Reg>(p_nth - kNumArguments);
+}
+
+RegisterPool::Reg RegisterPool::getSavedRegister(const std::size_t p_number) {
+    assert(p_number >= 1 && p_number <= kNumSavedRegisters);
+    return static_cast<Reg>(kNumRegisters + p_number - 1);
+}
+
+RegisterPool::Reg RegisterPool::allocate() {
+    for (const Reg reg : kAllocationOrder) {
+        if (!m_is_live[reg]) {
+            m_is_live[reg] = true;
+            return reg;
+        }
+    }
+    return kNoReg;
+}
+
+bool RegisterPool::allocate(const Reg p_reg) {
+    if (m_is_live[p_reg]) {
+        return false;
+    }
+    m_is_live[p_reg] = true;
+    return true;
+}
+
+void RegisterPool::release(const Reg p_reg) {
+    if (!isTemporary(p_reg)) {
+        return;
+    }
+    assert(m_is_live[p_reg] && "Release a register that is not live");
+    m_is_live[p_reg] = false;
+}
+
+std::size_t RegisterPool::getNumFree() const {
+    std::size_t num = 0;
+    for (const bool is_live : m_is_live) {
+        num += !is_live;
+    }
+    return num;
+}
+
+std::vector<RegisterPool::Reg> RegisterPool::getLiveRegisters() const {
+    std::vector<Reg> regs;
+    for (std::size_t reg = 0; reg < kNumRegisters; ++reg) {
+        if (m_is_live[reg]) {
+            regs.push_back(static_cast<Reg>(reg));
+        }
+    }
+    return regs;
+}
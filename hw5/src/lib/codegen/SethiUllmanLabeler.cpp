@@ -0,0 +1,63 @@
+#include "codegen/SethiUllmanLabeler.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "visitor/AstNodeInclude.hpp"
+
+void SethiUllmanLabeler::label(const ExpressionNode &p_expr) {
+    if (m_labels.find(&p_expr) == m_labels.end()) {
+        const_cast<ExpressionNode &>(p_expr).accept(*this);
+    }
+}
+
+int SethiUllmanLabeler::getNeed(const ExpressionNode &p_expr) const {
+    auto it = m_labels.find(&p_expr);
+    assert(it != m_labels.end() && "The expression is not labeled");
+    return it->second.need;
+}
+
+bool SethiUllmanLabeler::containsCall(const ExpressionNode &p_expr) const {
+    auto it = m_labels.find(&p_expr);
+    assert(it != m_labels.end() && "The expression is not labeled");
+    return it->second.has_call;
+}
+
+void SethiUllmanLabeler::visit(ConstantValueNode &p_constant_value) {
+    m_labels[&p_constant_value] = {1, false};
+}
+
+void SethiUllmanLabeler::visit(BinaryOperatorNode &p_bin_op) {
+    p_bin_op.visitChildNodes(*this);
+
+    const Label left = m_labels.at(&p_bin_op.getLeftOperand());
+    const Label right = m_labels.at(&p_bin_op.getRightOperand());
+    const int need = (left.need == right.need)
+                         ? left.need + 1
+                         : std::max(left.need, right.need);
+    m_labels[&p_bin_op] = {need, left.has_call || right.has_call};
+}
+
+void SethiUllmanLabeler::visit(UnaryOperatorNode &p_un_op) {
+    p_un_op.visitChildNodes(*this);
+
+    const Label operand = m_labels.at(&p_un_op.getOperand());
+    m_labels[&p_un_op] = operand;
+}
+
+void SethiUllmanLabeler::visit(FunctionInvocationNode &p_func_invocation) {
+    // The arguments are evaluated after the live registers are saved, so they
+    // don't add to the need of the enclosing expression.
+    p_func_invocation.visitChildNodes(*this);
+    m_labels[&p_func_invocation] = {1, true};
+}
+
+void SethiUllmanLabeler::visit(VariableReferenceNode &p_variable_ref) {
+    p_variable_ref.visitChildNodes(*this);
+
+    bool has_call = false;
+    for (const auto &index : p_variable_ref.getIndices()) {
+        has_call = has_call || m_labels.at(index.get()).has_call;
+    }
+    m_labels[&p_variable_ref] = {1, has_call};
+}
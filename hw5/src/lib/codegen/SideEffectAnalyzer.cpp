@@ -0,0 +1,95 @@
+#include "codegen/SideEffectAnalyzer.hpp"
+
+#include <utility>
+
+#include "sema/SymbolTable.hpp"
+#include "visitor/AstNodeInclude.hpp"
+
+SideEffectAnalyzer::Summary SideEffectAnalyzer::analyze(
+    ProgramNode &p_program) {
+    m_summary.clear();
+    m_callees.clear();
+    for (const auto &function : p_program.getFuncNodes()) {
+        function->accept(*this);
+    }
+
+    // Add the writes of the callees until nothing changes, so that the
+    // recursive calls are covered as well.
+    bool is_changed = true;
+    while (is_changed) {
+        is_changed = false;
+        for (auto &caller : m_callees) {
+            Globals &writes = m_summary[caller.first];
+            const auto num_writes = writes.size();
+            for (const auto &callee : caller.second) {
+                const Globals &callee_writes = m_summary[callee];
+                writes.insert(callee_writes.begin(), callee_writes.end());
+            }
+            is_changed = is_changed || writes.size() != num_writes;
+        }
+    }
+    return std::move(m_summary);
+}
+
+void SideEffectAnalyzer::write(const VariableReferenceNode &p_target) {
+    const SymbolEntry *entry = p_target.getSymbolEntry();
+    if (entry->getLevel() == 0 &&
+        entry->getKind() == SymbolEntry::KindEnum::kVariableKind) {
+        m_writes->insert(entry);
+    }
+}
+
+void SideEffectAnalyzer::visit(FunctionNode &p_function) {
+    m_writes = &m_summary[p_function.getNameCString()];
+    m_calls = &m_callees[p_function.getNameCString()];
+    p_function.visitBodyChildNodes(*this);
+}
+
+void SideEffectAnalyzer::visit(CompoundStatementNode &p_compound_statement) {
+    p_compound_statement.visitChildNodes(*this);
+}
+
+void SideEffectAnalyzer::visit(PrintNode &p_print) {
+    p_print.visitChildNodes(*this);
+}
+
+void SideEffectAnalyzer::visit(BinaryOperatorNode &p_bin_op) {
+    p_bin_op.visitChildNodes(*this);
+}
+
+void SideEffectAnalyzer::visit(UnaryOperatorNode &p_un_op) {
+    p_un_op.visitChildNodes(*this);
+}
+
+void SideEffectAnalyzer::visit(FunctionInvocationNode &p_func_invocation) {
+    m_calls->insert(p_func_invocation.getNameCString());
+    p_func_invocation.visitChildNodes(*this);
+}
+
+void SideEffectAnalyzer::visit(VariableReferenceNode &p_variable_ref) {
+    p_variable_ref.visitChildNodes(*this);
+}
+
+void SideEffectAnalyzer::visit(AssignmentNode &p_assignment) {
+    write(p_assignment.getLvalue());
+    p_assignment.visitChildNodes(*this);
+}
+
+void SideEffectAnalyzer::visit(ReadNode &p_read) {
+    write(p_read.getTarget());
+    p_read.visitChildNodes(*this);
+}
+
+void SideEffectAnalyzer::visit(IfNode &p_if) { p_if.visitChildNodes(*this); }
+
+void SideEffectAnalyzer::visit(WhileNode &p_while) {
+    p_while.visitChildNodes(*this);
+}
+
+void SideEffectAnalyzer::visit(ForNode &p_for) {
+    p_for.visitChildNodes(*this);
+}
+
+void SideEffectAnalyzer::visit(ReturnNode &p_return) {
+    p_return.visitChildNodes(*this);
+}
@@ -0,0 +1,36 @@
+#include "driver/CompilationContext.hpp"
+
+// Generated by bison and flex; the scanner header needs the token and
+// location types from the parser header.
+#include "parser.h"
+#include "scanner.h"
+
+CompilationContext::~CompilationContext() {
+    // The tree is not destroyed: all it owns is in the arena, which frees it
+    // chunk by chunk.
+    if (m_scanner) {
+        yylex_destroy(m_scanner);
+    }
+}
+
+bool CompilationContext::open() {
+    if (!m_source.open(m_source_path.c_str())) {
+        return false;
+    }
+    if (yylex_init_extra(this, &m_scanner) != 0) {
+        m_scanner = nullptr;
+        return false;
+    }
+    yy_scan_buffer(m_source.getScanBuffer(), m_source.getScanBufferSize(),
+                   m_scanner);
+    return true;
+}
+
+bool CompilationContext::parse() {
+    AstArena *const saved_arena = AstArena::getCurrent();
+    AstArena::setCurrent(&m_ast_arena);
+    const bool is_parsed = yyparse(m_scanner, *this) == 0 &&
+                           !m_scanner_state.has_lexical_error;
+    AstArena::setCurrent(saved_arena);
+    return is_parsed;
+}
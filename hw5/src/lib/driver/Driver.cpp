@@ -0,0 +1,308 @@
+#include "driver/Driver.hpp"
+
+#include "AST/AstDumper.hpp"
+#include "AST/ast.hpp"
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/IrCodeGenerator.hpp"
+#include "driver/CompilationContext.hpp"
+#include "ir/IrBuilder.hpp"
+#include "ir/IrPrinter.hpp"
+#include "ir/IrSsaConstructor.hpp"
+#include "ir/IrSsaVerifier.hpp"
+#include "opt/ConstantFolder.hpp"
+#include "opt/DeadCodeEliminator.hpp"
+#include "opt/FunctionInliner.hpp"
+#include "sema/SemanticAnalyzer.hpp"
+#include "util/WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sys/resource.h>
+#include <unordered_map>
+
+namespace {
+/// @param p_before,p_after The instructions of each function without and
+/// with the elimination; empty if not generated by `CodeGenerator`.
+void printDeadCodeReport(
+    std::FILE *const p_file,
+    const std::vector<DeadCodeEliminator::Report> &p_reports,
+    const CodeGenerator::InstructionCounts &p_before,
+    const CodeGenerator::InstructionCounts &p_after) {
+    const bool has_counts = p_before.size() == p_reports.size() &&
+                            p_after.size() == p_reports.size();
+    for (std::size_t i = 0; i < p_reports.size(); ++i) {
+        const auto &report = p_reports[i];
+        std::fprintf(p_file, "dce: %-16s ", report.function.c_str());
+        if (has_counts) {
+            std::fprintf(p_file, "%6ld instructions, ",
+                         static_cast<long>(p_before[i].second) -
+                             static_cast<long>(p_after[i].second));
+        }
+        std::fprintf(p_file,
+                     "%zu unreachable statements, %zu dead stores, "
+                     "%zu unused locals\n",
+                     report.unreachable_statements, report.dead_stores,
+                     report.unused_locals);
+    }
+}
+
+void printInlineReport(std::FILE *const p_file,
+                       const std::vector<FunctionInliner::Report> &p_reports) {
+    for (const auto &report : p_reports) {
+        std::fprintf(p_file, "inline: %-16s %4u:%-3u %-16s %s",
+                     report.caller.c_str(),
+                     static_cast<unsigned>(report.location.line),
+                     static_cast<unsigned>(report.location.col),
+                     report.callee.c_str(),
+                     FunctionInliner::getReasonText(report.reason));
+        if (report.size > 0) {
+            std::fprintf(p_file, " (size %d, call cost %d)", report.size,
+                         report.call_cost);
+        }
+        std::fputc('\n', p_file);
+    }
+}
+}  // namespace
+
+int Driver::compile(const std::string &p_source_path,
+                    std::FILE *const p_listing_file,
+                    std::FILE *const p_diagnostic_file) const {
+    CodeGenOptions options = m_options.codegen;
+    options.num_threads = m_options.num_threads;
+    // Both own entries that the nodes point to, so they are declared before
+    // the context, which owns the AST. The analyzer is made once the context
+    // it analyzes is.
+    FunctionInliner function_inliner(
+        static_cast<int>(options.inline_threshold));
+    std::unique_ptr<SemanticAnalyzer> sema_analyzer;
+    CompilationContext context(p_source_path, p_listing_file,
+                               p_diagnostic_file);
+    if (!context.open()) {
+        std::fprintf(p_diagnostic_file, "open() failed: %s\n",
+                     std::strerror(errno));
+        return -1;
+    }
+
+    const auto parse_start = std::chrono::steady_clock::now();
+    if (!context.parse()) {
+        return -1;
+    }
+    const std::chrono::duration<double, std::milli> parse_time =
+        std::chrono::steady_clock::now() - parse_start;
+    AstNode *const root = context.getRoot();
+    if (m_options.ast_stats) {
+        const AstArena &ast_arena = context.getAstArena();
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        std::fprintf(p_diagnostic_file,
+                     "AST: %zu allocations, %zu bytes in %zu arena chunks "
+                     "(%zu bytes reserved)\n"
+                     "parse: %.2f ms, peak RSS %ld KiB\n",
+                     ast_arena.getNumAllocations(),
+                     ast_arena.getNumBytesAllocated(),
+                     ast_arena.getNumChunks(), ast_arena.getNumBytesReserved(),
+                     parse_time.count(), usage.ru_maxrss);
+    }
+
+    if (m_options.dump_ast) {
+        AstDumper ast_dumper(p_listing_file);
+        root->accept(ast_dumper);
+    }
+
+    sema_analyzer = std::make_unique<SemanticAnalyzer>(
+        context.getTypeContext(), context.getSource(),
+        context.getScannerState().dump_symbols, p_diagnostic_file,
+        p_listing_file);
+    sema_analyzer->setNumThreads(m_options.num_threads);
+    root->accept(*sema_analyzer);
+
+    // The folder and the inliner rely on the types inferred by the analyzer,
+    // and the code generators on the entries of the variables the inliner
+    // declares.
+    if (!sema_analyzer->hasError() &&
+        (options.fold_constants || options.inline_functions)) {
+        AstArena *const saved_arena = AstArena::getCurrent();
+        AstArena::setCurrent(&context.getAstArena());
+        if (options.fold_constants) {
+            ConstantFolder().run(*root);
+        }
+        if (options.inline_functions) {
+            function_inliner.run(*root);
+        }
+        AstArena::setCurrent(saved_arena);
+    }
+    DeadCodeEliminator dead_code_eliminator;
+    CodeGenerator::InstructionCounts counts_before;
+    CodeGenerator::InstructionCounts counts_after;
+    const bool is_dce_reported = !sema_analyzer->hasError() &&
+                                 options.eliminate_dead_code &&
+                                 m_options.dce_report;
+    if (!sema_analyzer->hasError() && options.eliminate_dead_code) {
+        // The instructions saved are counted with the AST code generator.
+        if (is_dce_reported && !m_options.ir_codegen) {
+            counts_before =
+                CodeGenerator::countInstructions(p_source_path, *root, options);
+        }
+        dead_code_eliminator.run(*root);
+    }
+    if (!sema_analyzer->hasError() &&
+        (m_options.dump_ir || m_options.ir_codegen)) {
+        auto module = IrBuilder().build(p_source_path, *root);
+        if (options.build_ssa) {
+            IrSsaConstructor ssa_constructor;
+            for (const auto &function : module->getFunctions()) {
+                ssa_constructor.run(*function);
+                const auto errors = IrSsaVerifier::verify(*function);
+                for (const auto &error : errors) {
+                    std::fprintf(p_diagnostic_file,
+                                 "SSA verification failed: %s\n",
+                                 error.c_str());
+                }
+                if (!errors.empty()) {
+                    return -1;
+                }
+            }
+        }
+        if (m_options.dump_ir) {
+            IrPrinter(p_listing_file).print(*module);
+        }
+        if (m_options.ir_codegen) {
+            IrCodeGenerator(p_source_path, m_options.save_path)
+                .generate(*module);
+        }
+    }
+    // The code generator relies on the entries resolved by the analyzer.
+    if (!sema_analyzer->hasError() && !m_options.ir_codegen) {
+        CodeGenerator code_generator(p_source_path, m_options.save_path,
+                                     options);
+        root->accept(code_generator);
+        counts_after = code_generator.getInstructionCounts();
+        if (m_options.peephole_stats) {
+            const auto &stats = code_generator.getPeepholeStats();
+            for (std::size_t i = 0; i < PeepholeOptimizer::kNumRules; ++i) {
+                const auto rule = static_cast<PeepholeOptimizer::Rule>(i);
+                std::fprintf(p_diagnostic_file, "peephole: %6zu %s\n",
+                             stats.hits[rule],
+                             PeepholeOptimizer::getRuleName(rule));
+            }
+        }
+    }
+
+    if (!sema_analyzer->hasError() && options.inline_functions &&
+        m_options.inline_report) {
+        printInlineReport(p_diagnostic_file, function_inliner.getReports());
+    }
+    if (is_dce_reported) {
+        printDeadCodeReport(p_diagnostic_file,
+                            dead_code_eliminator.getReports(), counts_before,
+                            counts_after);
+    }
+
+    if (!sema_analyzer->hasError()) {
+        std::fprintf(p_listing_file,
+                     "\n"
+                     "|---------------------------------------------------|\n"
+                     "|  There is no syntactic error and semantic error!  |\n"
+                     "|---------------------------------------------------|\n");
+    }
+    return 0;
+}
+
+std::pair<std::size_t, std::size_t> Driver::findOutputCollision(
+    const std::vector<std::string> &p_source_paths) const {
+    std::unordered_map<std::string, std::size_t> owners;
+    for (std::size_t i = 0; i < p_source_paths.size(); ++i) {
+        const auto inserted = owners.emplace(
+            CodeGenerator::getOutputFilePath(p_source_paths[i],
+                                             m_options.save_path),
+            i);
+        if (!inserted.second) {
+            return {inserted.first->second, i};
+        }
+    }
+    return {0, 0};
+}
+
+int Driver::compileAll(const std::vector<std::string> &p_source_paths,
+                       const std::size_t p_num_jobs) const {
+    // Two files with the same name would race for one `.S` file.
+    const auto collision = findOutputCollision(p_source_paths);
+    if (collision.first != collision.second) {
+        std::fprintf(stderr, "%s and %s are both compiled to %s\n",
+                     p_source_paths[collision.first].c_str(),
+                     p_source_paths[collision.second].c_str(),
+                     CodeGenerator::getOutputFilePath(
+                         p_source_paths[collision.second],
+                         m_options.save_path)
+                         .c_str());
+        return -1;
+    }
+
+    struct Output {
+        char *listing = nullptr;
+        std::size_t listing_size = 0;
+        char *diagnostics = nullptr;
+        std::size_t diagnostics_size = 0;
+        int status = 0;
+        bool is_done = false;
+    };
+    std::vector<Output> outputs(p_source_paths.size());
+    std::mutex mutex;
+    std::condition_variable output_done;
+
+    WorkStealingPool pool(std::min(p_num_jobs, p_source_paths.size()));
+    for (std::size_t i = 0; i < p_source_paths.size(); ++i) {
+        pool.submit([this, i, &p_source_paths, &outputs, &mutex,
+                     &output_done] {
+            Output &output = outputs[i];
+            std::FILE *const listing_file =
+                open_memstream(&output.listing, &output.listing_size);
+            std::FILE *const diagnostic_file =
+                open_memstream(&output.diagnostics, &output.diagnostics_size);
+            int status = -1;
+            if (listing_file && diagnostic_file) {
+                status =
+                    compile(p_source_paths[i], listing_file, diagnostic_file);
+            }
+            if (listing_file) {
+                std::fclose(listing_file);
+            }
+            if (diagnostic_file) {
+                std::fclose(diagnostic_file);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                output.status = status;
+                output.is_done = true;
+            }
+            output_done.notify_all();
+        });
+    }
+
+    // Each file is written out as soon as the ones before it are, so the
+    // output keeps up with the compilation instead of waiting for the end.
+    int status = 0;
+    for (Output &output : outputs) {
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            output_done.wait(lock, [&output] { return output.is_done; });
+        }
+        std::fwrite(output.listing, 1, output.listing_size, stdout);
+        std::fflush(stdout);
+        std::fwrite(output.diagnostics, 1, output.diagnostics_size, stderr);
+        std::free(output.listing);
+        std::free(output.diagnostics);
+        if (status == 0) {
+            status = output.status;
+        }
+    }
+    pool.wait();
+    return status;
+}
@@ -0,0 +1,17 @@
+#include "ir/IrBasicBlock.hpp"
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+void IrBasicBlock::append(IrInstruction p_instruction) {
+    assert(!isTerminated() && "Append to a terminated block");
+    m_instructions.push_back(std::move(p_instruction));
+}
+
+std::vector<int> IrBasicBlock::getSuccessors() const {
+    if (!isTerminated()) {
+        return {};
+    }
+    return m_instructions.back().targets;
+}
@@ -0,0 +1,329 @@
+#include "ir/IrBuilder.hpp"
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "visitor/AstNodeInclude.hpp"
+
+namespace {
+IrType toIrType(const PType &p_type) {
+    if (p_type.isVoid()) {
+        return IrType::kVoid;
+    }
+    return p_type.isBool() ? IrType::kBool : IrType::kInt;
+}
+
+// Booleans share the storage of the integer, so only read the active member.
+int getConstantWord(const Constant &p_constant) {
+    if (p_constant.getTypePtr()->isBool()) {
+        return p_constant.boolean();
+    }
+    return static_cast<int>(p_constant.integer());
+}
+
+IrOpcode toIrOpcode(const Operator p_op) {
+    switch (p_op) {
+        case Operator::kPlusOp:
+            return IrOpcode::kAdd;
+        case Operator::kMinusOp:
+            return IrOpcode::kSub;
+        case Operator::kMultiplyOp:
+            return IrOpcode::kMul;
+        case Operator::kDivideOp:
+            return IrOpcode::kDiv;
+        case Operator::kModOp:
+            return IrOpcode::kRem;
+        case Operator::kAndOp:
+            return IrOpcode::kAnd;
+        case Operator::kOrOp:
+            return IrOpcode::kOr;
+        case Operator::kEqualOp:
+            return IrOpcode::kEq;
+        case Operator::kNotEqualOp:
+            return IrOpcode::kNe;
+        case Operator::kLessOp:
+            return IrOpcode::kLt;
+        case Operator::kLessOrEqualOp:
+            return IrOpcode::kLe;
+        case Operator::kGreaterOp:
+            return IrOpcode::kGt;
+        case Operator::kGreaterOrEqualOp:
+            return IrOpcode::kGe;
+        case Operator::kNegOp:
+            return IrOpcode::kNeg;
+        case Operator::kNotOp:
+            return IrOpcode::kNot;
+    }
+    assert(false && "unknown operator");
+    return IrOpcode::kAdd;
+}
+}  // namespace
+
+std::unique_ptr<IrModule> IrBuilder::build(
+    const std::string &p_source_file_path, AstNode &p_program) {
+    m_module = std::make_unique<IrModule>(p_source_file_path);
+    p_program.accept(*this);
+    m_homes.clear();
+    return std::move(m_module);
+}
+
+IrOperand IrBuilder::lower(const ExpressionNode &p_expr) {
+    ++m_expression_depth;
+    m_result = IrOperand{};
+    const_cast<ExpressionNode &>(p_expr).accept(*this);
+    --m_expression_depth;
+
+    return m_result;
+}
+
+IrOperand IrBuilder::getHome(
+    const VariableReferenceNode &p_variable_ref) const {
+    assert(p_variable_ref.getSymbolEntry() &&
+           "Reference to an undeclared symbol");
+    return m_homes.at(p_variable_ref.getSymbolEntry());
+}
+
+void IrBuilder::append(IrInstruction p_instruction) {
+    if (m_block->isTerminated()) {
+        m_block = m_function->newBlock();
+    }
+    m_block->append(std::move(p_instruction));
+}
+
+IrOperand IrBuilder::appendWithResult(const IrOpcode p_opcode,
+                                      const IrType p_type,
+                                      std::vector<IrOperand> p_operands) {
+    IrInstruction instruction{p_opcode, p_type};
+    instruction.dst = m_function->newTemp(p_type);
+    instruction.operands = std::move(p_operands);
+    append(std::move(instruction));
+    return IrOperand::temp(m_block->getInstructions().back().dst);
+}
+
+void IrBuilder::appendJump(const IrBasicBlock &p_target) {
+    IrInstruction instruction{IrOpcode::kJmp};
+    instruction.targets = {p_target.getId()};
+    append(std::move(instruction));
+}
+
+void IrBuilder::appendBranch(const IrOperand p_condition,
+                             const IrBasicBlock &p_true,
+                             const IrBasicBlock &p_false) {
+    IrInstruction instruction{IrOpcode::kBr};
+    instruction.operands = {p_condition};
+    instruction.targets = {p_true.getId(), p_false.getId()};
+    append(std::move(instruction));
+}
+
+void IrBuilder::startBlock(IrBasicBlock *const p_block) {
+    if (!m_block->isTerminated()) {
+        appendJump(*p_block);
+    }
+    m_block = p_block;
+}
+
+void IrBuilder::finishFunction() {
+    if (!m_block->isTerminated()) {
+        append(IrInstruction{IrOpcode::kRet});
+    }
+    m_function = nullptr;
+    m_block = nullptr;
+}
+
+void IrBuilder::visit(ProgramNode &p_program) {
+    for (auto &decl : p_program.getDeclNodes()) {
+        decl->accept(*this);
+    }
+    for (auto &func : p_program.getFuncNodes()) {
+        func->accept(*this);
+    }
+
+    m_function = m_module->addFunction(
+        std::make_unique<IrFunction>("main", IrType::kVoid));
+    m_block = m_function->newBlock();
+    const_cast<CompoundStatementNode &>(p_program.getBody()).accept(*this);
+    finishFunction();
+}
+
+void IrBuilder::visit(DeclNode &p_decl) { p_decl.visitChildNodes(*this); }
+
+void IrBuilder::visit(VariableNode &p_variable) {
+    const SymbolEntry *entry = p_variable.getSymbolEntry();
+    const Constant *constant = p_variable.getConstantPtr();
+    const IrType type = toIrType(*entry->getTypePtr());
+
+    if (entry->getLevel() == 0) {
+        m_homes[entry] = IrOperand::global(m_module->addGlobal(
+            {entry->getName(), type, constant != nullptr,
+             constant ? getConstantWord(*constant) : 0}));
+        return;
+    }
+
+    const auto slot = IrOperand::slot(
+        m_function->addSlot({entry->getName(), type}));
+    m_homes[entry] = slot;
+    if (constant) {
+        IrInstruction store{IrOpcode::kStore};
+        store.operands = {slot, IrOperand::immediate(getConstantWord(*constant))};
+        append(std::move(store));
+    }
+}
+
+void IrBuilder::visit(ConstantValueNode &p_constant_value) {
+    m_result = IrOperand::immediate(
+        getConstantWord(*p_constant_value.getConstantPtr()));
+}
+
+void IrBuilder::visit(FunctionNode &p_function) {
+    m_function = m_module->addFunction(std::make_unique<IrFunction>(
+        p_function.getNameCString(), toIrType(*p_function.getTypePtr())));
+    for (const auto &parameter : p_function.getParameters()) {
+        for (const auto &variable : parameter->getVariables()) {
+            const SymbolEntry &entry = *variable->getSymbolEntry();
+            m_homes[&entry] = IrOperand::slot(m_function->addParameter(
+                {entry.getName(), toIrType(*entry.getTypePtr())}));
+        }
+    }
+    m_block = m_function->newBlock();
+    p_function.visitBodyChildNodes(*this);
+    finishFunction();
+}
+
+void IrBuilder::visit(CompoundStatementNode &p_compound_statement) {
+    p_compound_statement.visitChildNodes(*this);
+}
+
+void IrBuilder::visit(PrintNode &p_print) {
+    IrInstruction print{IrOpcode::kPrint};
+    print.operands = {lower(p_print.getTarget())};
+    append(std::move(print));
+}
+
+void IrBuilder::visit(BinaryOperatorNode &p_bin_op) {
+    const auto lhs = lower(p_bin_op.getLeftOperand());
+    const auto rhs = lower(p_bin_op.getRightOperand());
+    m_result = appendWithResult(toIrOpcode(p_bin_op.getOp()),
+                                toIrType(*p_bin_op.getInferredType()),
+                                {lhs, rhs});
+}
+
+void IrBuilder::visit(UnaryOperatorNode &p_un_op) {
+    const auto operand = lower(p_un_op.getOperand());
+    m_result = appendWithResult(toIrOpcode(p_un_op.getOp()),
+                                toIrType(*p_un_op.getInferredType()),
+                                {operand});
+}
+
+void IrBuilder::visit(FunctionInvocationNode &p_func_invocation) {
+    const bool is_statement = m_expression_depth == 0;
+
+    IrInstruction call{IrOpcode::kCall};
+    call.callee = p_func_invocation.getNameCString();
+    for (const auto &argument : p_func_invocation.getArguments()) {
+        call.operands.push_back(lower(*argument));
+    }
+    const IrType type = toIrType(*p_func_invocation.getInferredType());
+    if (!is_statement && type != IrType::kVoid) {
+        call.type = type;
+        call.dst = m_function->newTemp(type);
+        m_result = IrOperand::temp(call.dst);
+    }
+    append(std::move(call));
+}
+
+void IrBuilder::visit(VariableReferenceNode &p_variable_ref) {
+    m_result = appendWithResult(IrOpcode::kLoad,
+                                toIrType(*p_variable_ref.getInferredType()),
+                                {getHome(p_variable_ref)});
+}
+
+void IrBuilder::visit(AssignmentNode &p_assignment) {
+    const auto value = lower(p_assignment.getExpr());
+    IrInstruction store{IrOpcode::kStore};
+    store.operands = {getHome(p_assignment.getLvalue()), value};
+    append(std::move(store));
+}
+
+void IrBuilder::visit(ReadNode &p_read) {
+    const auto &target = p_read.getTarget();
+    const auto value = appendWithResult(
+        IrOpcode::kRead, toIrType(*target.getInferredType()), {});
+    IrInstruction store{IrOpcode::kStore};
+    store.operands = {getHome(target), value};
+    append(std::move(store));
+}
+
+void IrBuilder::visit(IfNode &p_if) {
+    auto *body = m_function->newBlock();
+    auto *else_body = p_if.hasElseBody() ? m_function->newBlock() : nullptr;
+    auto *join = m_function->newBlock();
+
+    appendBranch(lower(p_if.getCondition()), *body,
+                 else_body ? *else_body : *join);
+
+    m_block = body;
+    const_cast<CompoundStatementNode &>(p_if.getBody()).accept(*this);
+    if (else_body) {
+        if (!m_block->isTerminated()) {
+            appendJump(*join);
+        }
+        m_block = else_body;
+        p_if.visitElseBodyChildNodes(*this);
+    }
+    startBlock(join);
+}
+
+void IrBuilder::visit(WhileNode &p_while) {
+    auto *condition = m_function->newBlock();
+    auto *body = m_function->newBlock();
+    auto *exit = m_function->newBlock();
+
+    startBlock(condition);
+    appendBranch(lower(p_while.getCondition()), *body, *exit);
+
+    m_block = body;
+    const_cast<CompoundStatementNode &>(p_while.getBody()).accept(*this);
+    if (!m_block->isTerminated()) {
+        appendJump(*condition);
+    }
+    m_block = exit;
+}
+
+void IrBuilder::visit(ForNode &p_for) {
+    const_cast<DeclNode &>(p_for.getLoopVarDecl()).accept(*this);
+    const_cast<AssignmentNode &>(p_for.getInitStmt()).accept(*this);
+
+    auto *condition = m_function->newBlock();
+    auto *body = m_function->newBlock();
+    auto *exit = m_function->newBlock();
+
+    const auto loop_var = getHome(p_for.getInitStmt().getLvalue());
+
+    startBlock(condition);
+    const auto value = appendWithResult(IrOpcode::kLoad, IrType::kInt,
+                                        {loop_var});
+    const auto end = lower(p_for.getEndCondition());
+    appendBranch(appendWithResult(IrOpcode::kLt, IrType::kBool, {value, end}),
+                 *body, *exit);
+
+    m_block = body;
+    const_cast<CompoundStatementNode &>(p_for.getBody()).accept(*this);
+    const auto current = appendWithResult(IrOpcode::kLoad, IrType::kInt,
+                                          {loop_var});
+    const auto next = appendWithResult(IrOpcode::kAdd, IrType::kInt,
+                                       {current, IrOperand::immediate(1)});
+    IrInstruction store{IrOpcode::kStore};
+    store.operands = {loop_var, next};
+    append(std::move(store));
+    appendJump(*condition);
+    m_block = exit;
+}
+
+void IrBuilder::visit(ReturnNode &p_return) {
+    IrInstruction ret{IrOpcode::kRet};
+    ret.operands = {lower(p_return.getReturnValue())};
+    append(std::move(ret));
+}
@@ -0,0 +1,105 @@
+#include "ir/IrControlFlowGraph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+IrControlFlowGraph::IrControlFlowGraph(const IrFunction &p_function) {
+    const auto &blocks = p_function.getBlocks();
+    const std::size_t num_blocks = blocks.size();
+
+    m_predecessors.resize(num_blocks);
+    m_successors.resize(num_blocks);
+    for (const auto &block : blocks) {
+        auto successors = block->getSuccessors();
+        std::sort(successors.begin(), successors.end());
+        successors.erase(std::unique(successors.begin(), successors.end()),
+                         successors.end());
+        for (const int successor : successors) {
+            m_predecessors[successor].push_back(block->getId());
+        }
+        m_successors[block->getId()] = std::move(successors);
+    }
+
+    m_rpo_numbers.assign(num_blocks, -1);
+    if (num_blocks == 0) {
+        return;
+    }
+
+    // Iterative depth-first search; deep nesting would overflow the stack.
+    std::vector<int> postorder;
+    std::vector<bool> is_visited(num_blocks, false);
+    std::vector<std::pair<int, std::size_t>> stack{{0, 0}};
+    is_visited[0] = true;
+    while (!stack.empty()) {
+        auto &frame = stack.back();
+        const auto &successors = m_successors[frame.first];
+        if (frame.second < successors.size()) {
+            const int successor = successors[frame.second++];
+            if (!is_visited[successor]) {
+                is_visited[successor] = true;
+                stack.emplace_back(successor, 0);
+            }
+            continue;
+        }
+        postorder.push_back(frame.first);
+        stack.pop_back();
+    }
+
+    m_reverse_postorder.assign(postorder.rbegin(), postorder.rend());
+    for (std::size_t i = 0; i < m_reverse_postorder.size(); ++i) {
+        m_rpo_numbers[m_reverse_postorder[i]] = static_cast<int>(i);
+    }
+}
+
+int IrControlFlowGraph::removeUnreachableBlocks(IrFunction &p_function) {
+    const IrControlFlowGraph cfg(p_function);
+    auto &blocks = p_function.getBlocks();
+
+    std::vector<int> new_ids(blocks.size(), -1);
+    int num_kept = 0;
+    for (std::size_t id = 0; id < blocks.size(); ++id) {
+        if (cfg.isReachable(static_cast<int>(id))) {
+            new_ids[id] = num_kept++;
+        }
+    }
+    const int num_removed = static_cast<int>(blocks.size()) - num_kept;
+    if (num_removed == 0) {
+        return 0;
+    }
+
+    std::vector<std::unique_ptr<IrBasicBlock>> kept;
+    kept.reserve(num_kept);
+    for (auto &block : blocks) {
+        const int new_id = new_ids[block->getId()];
+        if (new_id == -1) {
+            continue;
+        }
+        auto renumbered = std::make_unique<IrBasicBlock>(new_id);
+        renumbered->getInstructions() = std::move(block->getInstructions());
+        for (auto &instruction : renumbered->getInstructions()) {
+            // A phi may still list an unreachable predecessor.
+            std::size_t num_targets = 0;
+            for (std::size_t i = 0; i < instruction.targets.size(); ++i) {
+                const int target = new_ids[instruction.targets[i]];
+                if (target == -1) {
+                    continue;
+                }
+                instruction.targets[num_targets] = target;
+                if (instruction.opcode == IrOpcode::kPhi) {
+                    instruction.operands[num_targets] = instruction.operands[i];
+                }
+                ++num_targets;
+            }
+            instruction.targets.resize(num_targets);
+            if (instruction.opcode == IrOpcode::kPhi) {
+                instruction.operands.resize(num_targets);
+            }
+        }
+        kept.push_back(std::move(renumbered));
+    }
+    blocks = std::move(kept);
+    return num_removed;
+}
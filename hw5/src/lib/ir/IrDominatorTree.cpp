@@ -0,0 +1,110 @@
+#include "ir/IrDominatorTree.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+constexpr int IrDominatorTree::kNoBlock;
+
+IrDominatorTree::IrDominatorTree(const IrControlFlowGraph &p_cfg) {
+    const std::size_t num_blocks = p_cfg.getNumBlocks();
+    const auto &rpo = p_cfg.getReversePostorder();
+
+    m_idoms.assign(num_blocks, kNoBlock);
+    m_children.resize(num_blocks);
+    m_frontiers.resize(num_blocks);
+    m_preorder_numbers.assign(num_blocks, -1);
+    m_postorder_numbers.assign(num_blocks, -1);
+    if (rpo.empty()) {
+        return;
+    }
+
+    // Walk up from both blocks until they meet; a block with a smaller
+    // reverse postorder number is higher in the tree.
+    const int entry = rpo.front();
+    m_idoms[entry] = entry;
+    auto intersect = [&](int p_lhs, int p_rhs) {
+        while (p_lhs != p_rhs) {
+            while (p_cfg.getRpoNumber(p_lhs) > p_cfg.getRpoNumber(p_rhs)) {
+                p_lhs = m_idoms[p_lhs];
+            }
+            while (p_cfg.getRpoNumber(p_rhs) > p_cfg.getRpoNumber(p_lhs)) {
+                p_rhs = m_idoms[p_rhs];
+            }
+        }
+        return p_lhs;
+    };
+
+    bool is_changed = true;
+    while (is_changed) {
+        is_changed = false;
+        for (std::size_t i = 1; i < rpo.size(); ++i) {
+            const int block = rpo[i];
+            int new_idom = kNoBlock;
+            for (const int predecessor : p_cfg.getPredecessors(block)) {
+                if (m_idoms[predecessor] == kNoBlock) {
+                    continue;
+                }
+                new_idom = (new_idom == kNoBlock)
+                               ? predecessor
+                               : intersect(predecessor, new_idom);
+            }
+            if (m_idoms[block] != new_idom) {
+                m_idoms[block] = new_idom;
+                is_changed = true;
+            }
+        }
+    }
+
+    // Dominance frontiers: walk up from each predecessor of a join block to
+    // its immediate dominator.
+    for (const int block : rpo) {
+        const auto &predecessors = p_cfg.getPredecessors(block);
+        if (predecessors.size() < 2) {
+            continue;
+        }
+        for (const int predecessor : predecessors) {
+            if (!p_cfg.isReachable(predecessor)) {
+                continue;
+            }
+            int runner = predecessor;
+            while (runner != m_idoms[block]) {
+                auto &frontier = m_frontiers[runner];
+                if (frontier.empty() || frontier.back() != block) {
+                    frontier.push_back(block);
+                }
+                runner = m_idoms[runner];
+            }
+        }
+    }
+
+    m_idoms[entry] = kNoBlock;
+    for (std::size_t block = 0; block < num_blocks; ++block) {
+        if (m_idoms[block] != kNoBlock) {
+            m_children[m_idoms[block]].push_back(static_cast<int>(block));
+        }
+    }
+
+    int preorder = 0;
+    int postorder = 0;
+    std::vector<std::pair<int, std::size_t>> stack{{entry, 0}};
+    m_preorder_numbers[entry] = preorder++;
+    while (!stack.empty()) {
+        auto &frame = stack.back();
+        const auto &children = m_children[frame.first];
+        if (frame.second < children.size()) {
+            const int child = children[frame.second++];
+            m_preorder_numbers[child] = preorder++;
+            stack.emplace_back(child, 0);
+            continue;
+        }
+        m_postorder_numbers[frame.first] = postorder++;
+        stack.pop_back();
+    }
+}
+
+bool IrDominatorTree::dominates(const int p_dominator,
+                                const int p_block) const {
+    return m_preorder_numbers[p_dominator] <= m_preorder_numbers[p_block] &&
+           m_postorder_numbers[p_dominator] >= m_postorder_numbers[p_block];
+}
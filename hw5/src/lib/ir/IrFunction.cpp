@@ -0,0 +1,27 @@
+#include "ir/IrFunction.hpp"
+
+#include <cassert>
+#include <memory>
+
+int IrFunction::addParameter(const IrSlot &p_slot) {
+    assert(m_slots.size() == m_num_parameters &&
+           "Parameters must come before the local slots");
+    ++m_num_parameters;
+    return addSlot(p_slot);
+}
+
+int IrFunction::addSlot(const IrSlot &p_slot) {
+    m_slots.push_back(p_slot);
+    return static_cast<int>(m_slots.size()) - 1;
+}
+
+int IrFunction::newTemp(const IrType p_type) {
+    m_temp_types.push_back(p_type);
+    return static_cast<int>(m_temp_types.size()) - 1;
+}
+
+IrBasicBlock *IrFunction::newBlock() {
+    m_blocks.emplace_back(
+        std::make_unique<IrBasicBlock>(static_cast<int>(m_blocks.size())));
+    return m_blocks.back().get();
+}
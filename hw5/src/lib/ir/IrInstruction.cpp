@@ -0,0 +1,75 @@
+#include "ir/IrInstruction.hpp"
+
+#include <cassert>
+
+const char *IrInstruction::getOpcodeCString(const IrOpcode p_opcode) {
+    switch (p_opcode) {
+        case IrOpcode::kAdd:
+            return "add";
+        case IrOpcode::kSub:
+            return "sub";
+        case IrOpcode::kMul:
+            return "mul";
+        case IrOpcode::kDiv:
+            return "div";
+        case IrOpcode::kRem:
+            return "rem";
+        case IrOpcode::kAnd:
+            return "and";
+        case IrOpcode::kOr:
+            return "or";
+        case IrOpcode::kEq:
+            return "eq";
+        case IrOpcode::kNe:
+            return "ne";
+        case IrOpcode::kLt:
+            return "lt";
+        case IrOpcode::kLe:
+            return "le";
+        case IrOpcode::kGt:
+            return "gt";
+        case IrOpcode::kGe:
+            return "ge";
+        case IrOpcode::kNeg:
+            return "neg";
+        case IrOpcode::kNot:
+            return "not";
+        case IrOpcode::kCopy:
+            return "copy";
+        case IrOpcode::kLoad:
+            return "load";
+        case IrOpcode::kStore:
+            return "store";
+        case IrOpcode::kCall:
+            return "call";
+        case IrOpcode::kPrint:
+            return "print";
+        case IrOpcode::kRead:
+            return "read";
+        case IrOpcode::kParam:
+            return "param";
+        case IrOpcode::kPhi:
+            return "phi";
+        case IrOpcode::kBr:
+            return "br";
+        case IrOpcode::kJmp:
+            return "jmp";
+        case IrOpcode::kRet:
+            return "ret";
+    }
+    assert(false && "unknown opcode");
+    return "";
+}
+
+const char *getIrTypeCString(const IrType p_type) {
+    switch (p_type) {
+        case IrType::kVoid:
+            return "void";
+        case IrType::kInt:
+            return "int";
+        case IrType::kBool:
+            return "bool";
+    }
+    assert(false && "unknown type");
+    return "";
+}
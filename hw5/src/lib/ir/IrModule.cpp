@@ -0,0 +1,14 @@
+#include "ir/IrModule.hpp"
+
+#include <memory>
+#include <utility>
+
+int IrModule::addGlobal(const IrGlobal &p_global) {
+    m_globals.push_back(p_global);
+    return static_cast<int>(m_globals.size()) - 1;
+}
+
+IrFunction *IrModule::addFunction(std::unique_ptr<IrFunction> p_function) {
+    m_functions.push_back(std::move(p_function));
+    return m_functions.back().get();
+}
@@ -0,0 +1,116 @@
+#include "ir/IrPrinter.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+
+void IrPrinter::print(const IrModule &p_module) {
+    m_module = &p_module;
+
+    fprintf(m_out, "; module \"%s\"\n", p_module.getSourceFilePath().c_str());
+    for (const auto &global : p_module.getGlobals()) {
+        if (global.is_constant) {
+            fprintf(m_out, "@%s = constant %s %d\n", global.name.c_str(),
+                    getIrTypeCString(global.type), global.initial_value);
+        } else {
+            fprintf(m_out, "@%s = global %s\n", global.name.c_str(),
+                    getIrTypeCString(global.type));
+        }
+    }
+    for (const auto &function : p_module.getFunctions()) {
+        fprintf(m_out, "\n");
+        print(*function);
+    }
+
+    m_module = nullptr;
+}
+
+void IrPrinter::print(const IrFunction &p_function) {
+    const auto &slots = p_function.getSlots();
+
+    fprintf(m_out, "define %s @%s(", getIrTypeCString(p_function.getReturnType()),
+            p_function.getNameCString());
+    for (std::size_t i = 0; i < p_function.getNumParameters(); ++i) {
+        fprintf(m_out, "%s$%zu %s: %s", (i == 0) ? "" : ", ", i,
+                slots[i].name.c_str(), getIrTypeCString(slots[i].type));
+    }
+    fprintf(m_out, ") {\n");
+    for (std::size_t i = p_function.getNumParameters(); i < slots.size(); ++i) {
+        fprintf(m_out, "  $%zu = slot %s %s\n", i, getIrTypeCString(slots[i].type),
+                slots[i].name.c_str());
+    }
+
+    for (const auto &block : p_function.getBlocks()) {
+        fprintf(m_out, "bb%d:\n", block->getId());
+        for (const auto &instruction : block->getInstructions()) {
+            printInstruction(instruction);
+        }
+    }
+    fprintf(m_out, "}\n");
+}
+
+void IrPrinter::printOperand(const IrOperand &p_operand) {
+    switch (p_operand.kind) {
+        case IrOperand::Kind::kNone:
+            fprintf(m_out, "<none>");
+            break;
+        case IrOperand::Kind::kTemp:
+            fprintf(m_out, "%%%d", p_operand.value);
+            break;
+        case IrOperand::Kind::kImmediate:
+            fprintf(m_out, "%d", p_operand.value);
+            break;
+        case IrOperand::Kind::kSlot:
+            fprintf(m_out, "$%d", p_operand.value);
+            break;
+        case IrOperand::Kind::kGlobal:
+            if (m_module) {
+                fprintf(m_out, "@%s",
+                        m_module->getGlobals()[p_operand.value].name.c_str());
+            } else {
+                fprintf(m_out, "@%d", p_operand.value);
+            }
+            break;
+    }
+}
+
+void IrPrinter::printInstruction(const IrInstruction &p_instruction) {
+    fprintf(m_out, "  ");
+    if (p_instruction.hasResult()) {
+        fprintf(m_out, "%%%d:%s = ", p_instruction.dst,
+                getIrTypeCString(p_instruction.type));
+    }
+    fprintf(m_out, "%s", IrInstruction::getOpcodeCString(p_instruction.opcode));
+
+    if (p_instruction.opcode == IrOpcode::kCall) {
+        fprintf(m_out, " @%s(", p_instruction.callee.c_str());
+        for (std::size_t i = 0; i < p_instruction.operands.size(); ++i) {
+            fprintf(m_out, "%s", (i == 0) ? "" : ", ");
+            printOperand(p_instruction.operands[i]);
+        }
+        fprintf(m_out, ")\n");
+        return;
+    }
+
+    if (p_instruction.opcode == IrOpcode::kPhi) {
+        for (std::size_t i = 0; i < p_instruction.operands.size(); ++i) {
+            fprintf(m_out, "%s[", (i == 0) ? " " : ", ");
+            printOperand(p_instruction.operands[i]);
+            fprintf(m_out, ", bb%d]", p_instruction.targets[i]);
+        }
+        fprintf(m_out, "\n");
+        return;
+    }
+
+    const char *separator = " ";
+    for (const auto &operand : p_instruction.operands) {
+        fprintf(m_out, "%s", separator);
+        printOperand(operand);
+        separator = ", ";
+    }
+    for (const int target : p_instruction.targets) {
+        fprintf(m_out, "%sbb%d", separator, target);
+        separator = ", ";
+    }
+    fprintf(m_out, "\n");
+}
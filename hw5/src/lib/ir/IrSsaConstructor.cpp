@@ -0,0 +1,316 @@
+#include "ir/IrSsaConstructor.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace {
+bool isPhi(const IrInstruction &p_instruction) {
+    return p_instruction.opcode == IrOpcode::kPhi;
+}
+}  // namespace
+
+void IrSsaConstructor::run(IrFunction &p_function) {
+    m_function = &p_function;
+
+    m_statistics.num_removed_blocks +=
+        IrControlFlowGraph::removeUnreachableBlocks(p_function);
+    const IrControlFlowGraph cfg(p_function);
+    assert((p_function.getBlocks().empty() || cfg.getPredecessors(0).empty()) &&
+           "The entry block must not have predecessors");
+    const IrDominatorTree dom_tree(cfg);
+
+    insertPhis(cfg, dom_tree);
+    rename(cfg, dom_tree);
+    removeUselessPhis();
+
+    m_statistics.num_promoted_slots += p_function.getSlots().size();
+    m_function = nullptr;
+}
+
+void IrSsaConstructor::insertPhis(const IrControlFlowGraph &p_cfg,
+                                  const IrDominatorTree &p_dom_tree) {
+    const auto &slots = m_function->getSlots();
+    const auto &blocks = m_function->getBlocks();
+    const int num_slots = static_cast<int>(slots.size());
+
+    // Only the slots read in a block before being written there need phis.
+    std::vector<std::vector<int>> def_blocks(num_slots);
+    std::vector<bool> is_live_across(num_slots, false);
+    std::vector<int> stored_in(num_slots, -1);
+    for (const auto &block : blocks) {
+        for (const auto &instruction : block->getInstructions()) {
+            if (instruction.opcode == IrOpcode::kLoad &&
+                instruction.operands[0].isSlot()) {
+                const int slot = instruction.operands[0].value;
+                if (stored_in[slot] != block->getId()) {
+                    is_live_across[slot] = true;
+                }
+            } else if (instruction.opcode == IrOpcode::kStore &&
+                       instruction.operands[0].isSlot()) {
+                const int slot = instruction.operands[0].value;
+                if (stored_in[slot] != block->getId()) {
+                    stored_in[slot] = block->getId();
+                    def_blocks[slot].push_back(block->getId());
+                }
+            }
+        }
+    }
+
+    m_phi_slots.assign(m_function->getNumTemps(), -1);
+    std::vector<std::vector<IrInstruction>> new_phis(blocks.size());
+    std::vector<int> has_phi_for(blocks.size(), -1);
+    std::vector<int> is_queued_for(blocks.size(), -1);
+    std::vector<int> worklist;
+    for (int slot = 0; slot < num_slots; ++slot) {
+        if (!is_live_across[slot]) {
+            continue;
+        }
+        worklist = def_blocks[slot];
+        for (const int block : worklist) {
+            is_queued_for[block] = slot;
+        }
+        while (!worklist.empty()) {
+            const int block = worklist.back();
+            worklist.pop_back();
+            for (const int frontier : p_dom_tree.getFrontier(block)) {
+                if (has_phi_for[frontier] == slot) {
+                    continue;
+                }
+                has_phi_for[frontier] = slot;
+
+                IrInstruction phi{IrOpcode::kPhi, slots[slot].type};
+                phi.dst = m_function->newTemp(slots[slot].type);
+                phi.targets = p_cfg.getPredecessors(frontier);
+                phi.operands.resize(phi.targets.size());
+                m_phi_slots.push_back(slot);
+                new_phis[frontier].push_back(std::move(phi));
+
+                if (is_queued_for[frontier] != slot) {
+                    is_queued_for[frontier] = slot;
+                    worklist.push_back(frontier);
+                }
+            }
+        }
+    }
+
+    for (std::size_t block = 0; block < blocks.size(); ++block) {
+        if (new_phis[block].empty()) {
+            continue;
+        }
+        auto &instructions = blocks[block]->getInstructions();
+        instructions.insert(instructions.begin(),
+                            std::make_move_iterator(new_phis[block].begin()),
+                            std::make_move_iterator(new_phis[block].end()));
+    }
+}
+
+void IrSsaConstructor::rename(const IrControlFlowGraph &p_cfg,
+                              const IrDominatorTree &p_dom_tree) {
+    const auto &slots = m_function->getSlots();
+    auto &blocks = m_function->getBlocks();
+    if (blocks.empty()) {
+        return;
+    }
+
+    // The value of each slot on entry.
+    std::vector<std::vector<IrOperand>> stacks(slots.size());
+    std::vector<IrInstruction> parameters;
+    for (std::size_t slot = 0; slot < slots.size(); ++slot) {
+        if (slot < m_function->getNumParameters()) {
+            IrInstruction parameter{IrOpcode::kParam, slots[slot].type};
+            parameter.dst = m_function->newTemp(slots[slot].type);
+            parameter.operands = {
+                IrOperand::immediate(static_cast<int>(slot))};
+            stacks[slot].push_back(IrOperand::temp(parameter.dst));
+            parameters.push_back(std::move(parameter));
+        } else {
+            stacks[slot].push_back(IrOperand::immediate(0));
+        }
+    }
+    auto &entry = blocks.front()->getInstructions();
+    entry.insert(entry.begin(), std::make_move_iterator(parameters.begin()),
+                 std::make_move_iterator(parameters.end()));
+    m_phi_slots.resize(m_function->getNumTemps(), -1);
+    m_replacements.assign(m_function->getNumTemps(), IrOperand{});
+
+    // The slots pushed so far; a block pops back to its mark on exit.
+    std::vector<int> pushed_slots;
+    // (block, mark); the mark is -1 until the block is entered.
+    std::vector<std::pair<int, int>> walk{{0, -1}};
+    while (!walk.empty()) {
+        auto &frame = walk.back();
+        const int block_id = frame.first;
+        if (frame.second != -1) {
+            while (static_cast<int>(pushed_slots.size()) > frame.second) {
+                stacks[pushed_slots.back()].pop_back();
+                pushed_slots.pop_back();
+            }
+            walk.pop_back();
+            continue;
+        }
+        frame.second = static_cast<int>(pushed_slots.size());
+
+        auto &instructions = blocks[block_id]->getInstructions();
+        std::size_t num_kept = 0;
+        for (std::size_t i = 0; i < instructions.size(); ++i) {
+            auto &instruction = instructions[i];
+            if (isPhi(instruction)) {
+                const int slot = m_phi_slots[instruction.dst];
+                if (slot != -1) {
+                    stacks[slot].push_back(IrOperand::temp(instruction.dst));
+                    pushed_slots.push_back(slot);
+                }
+            } else {
+                for (auto &operand : instruction.operands) {
+                    if (operand.isTemp() &&
+                        m_replacements[operand.value].kind !=
+                            IrOperand::Kind::kNone) {
+                        operand = m_replacements[operand.value];
+                    }
+                }
+                if (instruction.opcode == IrOpcode::kLoad &&
+                    instruction.operands[0].isSlot()) {
+                    m_replacements[instruction.dst] =
+                        stacks[instruction.operands[0].value].back();
+                    ++m_statistics.num_removed_loads;
+                    continue;
+                }
+                if (instruction.opcode == IrOpcode::kStore &&
+                    instruction.operands[0].isSlot()) {
+                    const int slot = instruction.operands[0].value;
+                    stacks[slot].push_back(instruction.operands[1]);
+                    pushed_slots.push_back(slot);
+                    ++m_statistics.num_removed_stores;
+                    continue;
+                }
+            }
+            if (num_kept != i) {
+                instructions[num_kept] = std::move(instruction);
+            }
+            ++num_kept;
+        }
+        instructions.resize(num_kept);
+
+        for (const int successor : p_cfg.getSuccessors(block_id)) {
+            for (auto &phi : blocks[successor]->getInstructions()) {
+                if (!isPhi(phi)) {
+                    break;
+                }
+                const int slot = m_phi_slots[phi.dst];
+                if (slot == -1) {
+                    continue;
+                }
+                const auto incoming = std::find(phi.targets.begin(),
+                                                phi.targets.end(), block_id);
+                phi.operands[incoming - phi.targets.begin()] =
+                    stacks[slot].back();
+            }
+        }
+
+        // NOTE: `frame` is invalidated by pushing.
+        for (const int child : p_dom_tree.getChildren(block_id)) {
+            walk.emplace_back(child, -1);
+        }
+    }
+}
+
+void IrSsaConstructor::removeUselessPhis() {
+    auto &blocks = m_function->getBlocks();
+    std::vector<int> use_counts(m_function->getNumTemps());
+    m_replacements.assign(m_function->getNumTemps(), IrOperand{});
+
+    auto resolve = [this](IrOperand p_operand) {
+        while (p_operand.isTemp() &&
+               m_replacements[p_operand.value].kind != IrOperand::Kind::kNone) {
+            p_operand = m_replacements[p_operand.value];
+        }
+        return p_operand;
+    };
+
+    bool is_changed = true;
+    while (is_changed) {
+        is_changed = false;
+
+        // A phi whose operands are all the same value, or itself, is that
+        // value.
+        for (auto &block : blocks) {
+            for (auto &phi : block->getInstructions()) {
+                if (!isPhi(phi) || phi.dst == IrInstruction::kNoTemp) {
+                    continue;
+                }
+                IrOperand value;
+                bool is_trivial = true;
+                for (auto &operand : phi.operands) {
+                    operand = resolve(operand);
+                    if (operand == IrOperand::temp(phi.dst) ||
+                        operand == value) {
+                        continue;
+                    }
+                    if (value.kind != IrOperand::Kind::kNone) {
+                        is_trivial = false;
+                        break;
+                    }
+                    value = operand;
+                }
+                if (is_trivial) {
+                    // Only reached through itself: never written.
+                    m_replacements[phi.dst] =
+                        (value.kind == IrOperand::Kind::kNone)
+                            ? IrOperand::immediate(0)
+                            : value;
+                    phi.dst = IrInstruction::kNoTemp;
+                    is_changed = true;
+                }
+            }
+        }
+
+        std::fill(use_counts.begin(), use_counts.end(), 0);
+        for (auto &block : blocks) {
+            for (auto &instruction : block->getInstructions()) {
+                // A dead phi is about to be erased; what it reads is unused.
+                if (isPhi(instruction) && !instruction.hasResult()) {
+                    continue;
+                }
+                for (auto &operand : instruction.operands) {
+                    operand = resolve(operand);
+                    if (operand.isTemp() && operand.value != instruction.dst) {
+                        ++use_counts[operand.value];
+                    }
+                }
+            }
+        }
+
+        // A phi used by nothing but itself is dead.
+        for (auto &block : blocks) {
+            for (auto &phi : block->getInstructions()) {
+                if (isPhi(phi) && phi.dst != IrInstruction::kNoTemp &&
+                    use_counts[phi.dst] == 0) {
+                    phi.dst = IrInstruction::kNoTemp;
+                    is_changed = true;
+                }
+            }
+        }
+    }
+
+    for (auto &block : blocks) {
+        auto &instructions = block->getInstructions();
+        instructions.erase(
+            std::remove_if(instructions.begin(), instructions.end(),
+                           [](const IrInstruction &p_instruction) {
+                               return isPhi(p_instruction) &&
+                                      !p_instruction.hasResult();
+                           }),
+            instructions.end());
+        for (const auto &instruction : instructions) {
+            if (!isPhi(instruction)) {
+                break;
+            }
+            ++m_statistics.num_phis;
+        }
+    }
+    m_phi_slots.clear();
+    m_replacements.clear();
+}
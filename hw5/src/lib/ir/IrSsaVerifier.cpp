@@ -0,0 +1,167 @@
+#include "ir/IrSsaVerifier.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ir/IrControlFlowGraph.hpp"
+#include "ir/IrDominatorTree.hpp"
+
+namespace {
+std::string getLocation(const IrFunction &p_function, const int p_block,
+                        const std::size_t p_index) {
+    return "@" + p_function.getName() + " bb" + std::to_string(p_block) +
+           "[" + std::to_string(p_index) + "]: ";
+}
+}  // namespace
+
+std::vector<std::string> IrSsaVerifier::verify(const IrFunction &p_function) {
+    std::vector<std::string> errors;
+    const auto &blocks = p_function.getBlocks();
+    const int num_blocks = static_cast<int>(blocks.size());
+    const int num_temps = static_cast<int>(p_function.getNumTemps());
+
+    // The shape of the blocks comes first; the rest relies on it.
+    for (const auto &block : blocks) {
+        const auto &instructions = block->getInstructions();
+        if (!block->isTerminated()) {
+            errors.push_back(getLocation(p_function, block->getId(),
+                                         instructions.size()) +
+                             "missing terminator");
+        }
+        for (std::size_t i = 0; i < instructions.size(); ++i) {
+            const auto &instruction = instructions[i];
+            if (instruction.isTerminator() && i + 1 != instructions.size()) {
+                errors.push_back(getLocation(p_function, block->getId(), i) +
+                                 "terminator in the middle of a block");
+            }
+            if (instruction.isTerminator() ||
+                instruction.opcode == IrOpcode::kPhi) {
+                for (const int target : instruction.targets) {
+                    if (target < 0 || target >= num_blocks) {
+                        errors.push_back(
+                            getLocation(p_function, block->getId(), i) +
+                            "target bb" + std::to_string(target) +
+                            " out of range");
+                    }
+                }
+            }
+        }
+    }
+    if (!errors.empty()) {
+        return errors;
+    }
+
+    const IrControlFlowGraph cfg(p_function);
+    const IrDominatorTree dom_tree(cfg);
+    if (num_blocks > 0 && !cfg.getPredecessors(0).empty()) {
+        errors.push_back("@" + p_function.getName() +
+                         " bb0: the entry block has predecessors");
+    }
+
+    // (block, index) of the definition of each temp.
+    std::vector<int> def_blocks(num_temps, -1);
+    std::vector<std::size_t> def_indices(num_temps, 0);
+    for (const auto &block : blocks) {
+        const int id = block->getId();
+        if (!cfg.isReachable(id)) {
+            errors.push_back("@" + p_function.getName() + " bb" +
+                             std::to_string(id) + ": unreachable block");
+            continue;
+        }
+        const auto &instructions = block->getInstructions();
+        for (std::size_t i = 0; i < instructions.size(); ++i) {
+            const int dst = instructions[i].dst;
+            if (!instructions[i].hasResult()) {
+                continue;
+            }
+            if (dst < 0 || dst >= num_temps) {
+                errors.push_back(getLocation(p_function, id, i) + "%" +
+                                 std::to_string(dst) + " out of range");
+            } else if (def_blocks[dst] != -1) {
+                errors.push_back(getLocation(p_function, id, i) + "%" +
+                                 std::to_string(dst) + " defined twice");
+            } else {
+                def_blocks[dst] = id;
+                def_indices[dst] = i;
+            }
+        }
+    }
+    if (!errors.empty()) {
+        return errors;
+    }
+
+    // Whether the definition of the temp is available right before the
+    // instruction `p_index` of `p_block`.
+    auto is_available = [&](const int p_temp, const int p_block,
+                            const std::size_t p_index) {
+        if (def_blocks[p_temp] == -1) {
+            return false;
+        }
+        if (def_blocks[p_temp] == p_block) {
+            return def_indices[p_temp] < p_index;
+        }
+        return dom_tree.dominates(def_blocks[p_temp], p_block);
+    };
+
+    for (const auto &block : blocks) {
+        const int id = block->getId();
+        const auto &instructions = block->getInstructions();
+        bool is_in_phis = true;
+        for (std::size_t i = 0; i < instructions.size(); ++i) {
+            const auto &instruction = instructions[i];
+            const auto location = getLocation(p_function, id, i);
+
+            if (instruction.opcode != IrOpcode::kPhi) {
+                is_in_phis = false;
+                for (const auto &operand : instruction.operands) {
+                    if (operand.isSlot()) {
+                        errors.push_back(location + "slot $" +
+                                         std::to_string(operand.value) +
+                                         " is not promoted");
+                    } else if (operand.isTemp() &&
+                               !is_available(operand.value, id, i)) {
+                        errors.push_back(location + "%" +
+                                         std::to_string(operand.value) +
+                                         " is not defined before its use");
+                    }
+                }
+                continue;
+            }
+
+            if (!is_in_phis) {
+                errors.push_back(location + "phi after a non-phi");
+            }
+            const auto &predecessors = cfg.getPredecessors(id);
+            auto incoming = instruction.targets;
+            std::sort(incoming.begin(), incoming.end());
+            auto expected = predecessors;
+            std::sort(expected.begin(), expected.end());
+            if (incoming != expected ||
+                instruction.operands.size() != instruction.targets.size()) {
+                errors.push_back(location +
+                                 "phi does not match the predecessors");
+                continue;
+            }
+            for (std::size_t j = 0; j < instruction.operands.size(); ++j) {
+                const auto &operand = instruction.operands[j];
+                const int from = instruction.targets[j];
+                if (operand.kind == IrOperand::Kind::kNone ||
+                    operand.isSlot()) {
+                    errors.push_back(location + "phi has no value from bb" +
+                                     std::to_string(from));
+                } else if (operand.isTemp() &&
+                           !is_available(operand.value, from,
+                                         blocks[from]->getInstructions()
+                                             .size())) {
+                    errors.push_back(location + "%" +
+                                     std::to_string(operand.value) +
+                                     " is not defined at the end of bb" +
+                                     std::to_string(from));
+                }
+            }
+        }
+    }
+    return errors;
+}
@@ -0,0 +1,280 @@
+#include "opt/ConstantFolder.hpp"
+
+#include <cstdint>
+
+#include "sema/SymbolTable.hpp"
+#include "visitor/AstNodeInclude.hpp"
+
+namespace {
+// Booleans share the storage of the integer, so only read the active member.
+int getConstantWord(const Constant &p_constant) {
+    if (p_constant.getTypePtr()->isBool()) {
+        return p_constant.boolean();
+    }
+    return static_cast<int>(p_constant.integer());
+}
+
+bool isWordType(const PType &p_type) {
+    return p_type.isInteger() || p_type.isBool();
+}
+
+/// @return Whether `p_expr` is a constant that fits in a word.
+bool getConstant(const ExpressionNode &p_expr, int &p_value) {
+    const auto *constant = dynamic_cast<const ConstantValueNode *>(&p_expr);
+    if (!constant || !isWordType(*constant->getInferredType())) {
+        return false;
+    }
+    p_value = getConstantWord(*constant->getConstantPtr());
+    return true;
+}
+
+// The operands are words, so none of these overflows 64 bits; truncating the
+// result wraps it around like the instruction does.
+int toWord(const int64_t p_value) {
+    return static_cast<int>(static_cast<uint32_t>(p_value));
+}
+
+/// @return `false` if the result is left to the run time.
+bool evaluate(const Operator p_op, const int64_t p_lhs, const int64_t p_rhs,
+              int &p_result) {
+    switch (p_op) {
+        case Operator::kPlusOp:
+            p_result = toWord(p_lhs + p_rhs);
+            return true;
+        case Operator::kMinusOp:
+            p_result = toWord(p_lhs - p_rhs);
+            return true;
+        case Operator::kMultiplyOp:
+            p_result = toWord(p_lhs * p_rhs);
+            return true;
+        case Operator::kDivideOp:
+            if (p_rhs == 0) {
+                return false;
+            }
+            p_result = toWord(p_lhs / p_rhs);
+            return true;
+        case Operator::kModOp:
+            if (p_rhs == 0) {
+                return false;
+            }
+            p_result = toWord(p_lhs % p_rhs);
+            return true;
+        case Operator::kAndOp:
+            p_result = p_lhs & p_rhs;
+            return true;
+        case Operator::kOrOp:
+            p_result = p_lhs | p_rhs;
+            return true;
+        case Operator::kLessOp:
+            p_result = p_lhs < p_rhs;
+            return true;
+        case Operator::kLessOrEqualOp:
+            p_result = p_lhs <= p_rhs;
+            return true;
+        case Operator::kGreaterOp:
+            p_result = p_lhs > p_rhs;
+            return true;
+        case Operator::kGreaterOrEqualOp:
+            p_result = p_lhs >= p_rhs;
+            return true;
+        case Operator::kEqualOp:
+            p_result = p_lhs == p_rhs;
+            return true;
+        case Operator::kNotEqualOp:
+            p_result = p_lhs != p_rhs;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// @return Whether `x op p_value` (or `p_value op x` if `!p_is_right`) is
+/// `x`.
+bool isIdentity(const Operator p_op, const int p_value, const bool p_is_right) {
+    switch (p_op) {
+        case Operator::kPlusOp:
+        case Operator::kOrOp:
+            return p_value == 0;
+        case Operator::kMinusOp:
+            return p_is_right && p_value == 0;
+        case Operator::kMultiplyOp:
+        case Operator::kAndOp:
+            return p_value == 1;
+        case Operator::kDivideOp:
+            return p_is_right && p_value == 1;
+        default:
+            return false;
+    }
+}
+
+/// @return Whether `x op p_value` (or `p_value op x` if `!p_is_right`) is
+/// `p_result` whatever `x` is.
+bool isAbsorbing(const Operator p_op, const int p_value, const bool p_is_right,
+                 int &p_result) {
+    switch (p_op) {
+        case Operator::kMultiplyOp:
+        case Operator::kAndOp:
+            p_result = 0;
+            return p_value == 0;
+        case Operator::kModOp:
+            p_result = 0;
+            return p_is_right && p_value == 1;
+        case Operator::kOrOp:
+            p_result = 1;
+            return p_value == 1;
+        default:
+            return false;
+    }
+}
+}  // namespace
+
+void ConstantFolder::run(AstNode &p_root) { p_root.accept(*this); }
+
+bool ConstantFolder::fold(std::unique_ptr<ExpressionNode> &p_expr) {
+    const bool has_call_before = m_has_call;
+    m_has_call = false;
+    p_expr->accept(*this);
+    if (m_replacement) {
+        p_expr = std::move(m_replacement);
+    }
+    const bool has_call = m_has_call;
+    m_has_call = has_call_before || has_call;
+    return has_call;
+}
+
+void ConstantFolder::replaceWithConstant(const ExpressionNode &p_expr,
+                                         const int p_value) {
+    const PType *type = p_expr.getInferredType();
+    Constant::ConstantValue value;
+    value.integer = 0;
+    if (type->isBool()) {
+        value.boolean = p_value != 0;
+    } else {
+        value.integer = p_value;
+    }
+    const Location &location = p_expr.getLocation();
+    auto *constant = new ConstantValueNode(location.line, location.col,
+                                           new Constant(type, value));
+    constant->setInferredType(type);
+    m_replacement.reset(constant);
+}
+
+void ConstantFolder::visit(ProgramNode &p_program) {
+    p_program.visitChildNodes(*this);
+}
+
+void ConstantFolder::visit(FunctionNode &p_function) {
+    p_function.visitChildNodes(*this);
+}
+
+void ConstantFolder::visit(CompoundStatementNode &p_compound_statement) {
+    p_compound_statement.visitChildNodes(*this);
+}
+
+void ConstantFolder::visit(PrintNode &p_print) { fold(p_print.getTargetPtr()); }
+
+void ConstantFolder::visit(BinaryOperatorNode &p_bin_op) {
+    const bool left_has_call = fold(p_bin_op.getLeftOperandPtr());
+    const bool right_has_call = fold(p_bin_op.getRightOperandPtr());
+
+    int lhs = 0;
+    int rhs = 0;
+    const bool is_left_constant = getConstant(p_bin_op.getLeftOperand(), lhs);
+    const bool is_right_constant =
+        getConstant(p_bin_op.getRightOperand(), rhs);
+    const Operator op = p_bin_op.getOp();
+    if (is_left_constant && is_right_constant) {
+        int result = 0;
+        if (evaluate(op, lhs, rhs, result)) {
+            replaceWithConstant(p_bin_op, result);
+        }
+        return;
+    }
+    if (!is_left_constant && !is_right_constant) {
+        return;
+    }
+
+    const int value = is_right_constant ? rhs : lhs;
+    auto &other = is_right_constant ? p_bin_op.getLeftOperandPtr()
+                                    : p_bin_op.getRightOperandPtr();
+    const bool other_has_call = is_right_constant ? left_has_call
+                                                  : right_has_call;
+    int result = 0;
+    if (isIdentity(op, value, is_right_constant)) {
+        m_replacement = std::move(other);
+    } else if (!other_has_call &&
+               isAbsorbing(op, value, is_right_constant, result)) {
+        replaceWithConstant(p_bin_op, result);
+    }
+}
+
+void ConstantFolder::visit(UnaryOperatorNode &p_un_op) {
+    fold(p_un_op.getOperandPtr());
+
+    int value = 0;
+    if (getConstant(p_un_op.getOperand(), value)) {
+        replaceWithConstant(p_un_op, p_un_op.getOp() == Operator::kNotOp
+                                         ? !value
+                                         : toWord(-int64_t{value}));
+        return;
+    }
+    auto *inner =
+        dynamic_cast<UnaryOperatorNode *>(p_un_op.getOperandPtr().get());
+    if (inner && inner->getOp() == p_un_op.getOp()) {
+        m_replacement = std::move(inner->getOperandPtr());
+    }
+}
+
+void ConstantFolder::visit(FunctionInvocationNode &p_func_invocation) {
+    for (auto &argument : p_func_invocation.getArguments()) {
+        fold(argument);
+    }
+    m_has_call = true;
+}
+
+void ConstantFolder::visit(VariableReferenceNode &p_variable_ref) {
+    for (auto &index : p_variable_ref.getIndices()) {
+        fold(index);
+    }
+
+    const SymbolEntry *entry = p_variable_ref.getSymbolEntry();
+    if (entry && entry->getKind() == SymbolEntry::KindEnum::kConstantKind &&
+        isWordType(*entry->getTypePtr())) {
+        replaceWithConstant(p_variable_ref,
+                            getConstantWord(*entry->getAttribute().constant()));
+    }
+}
+
+void ConstantFolder::visit(AssignmentNode &p_assignment) {
+    // Only the indices of the target are expressions.
+    for (auto &index : p_assignment.getLvalue().getIndices()) {
+        fold(index);
+    }
+    fold(p_assignment.getExprPtr());
+}
+
+void ConstantFolder::visit(ReadNode &p_read) {
+    for (auto &index : p_read.getTarget().getIndices()) {
+        fold(index);
+    }
+}
+
+void ConstantFolder::visit(IfNode &p_if) {
+    fold(p_if.getConditionPtr());
+    p_if.getBody().accept(*this);
+    if (p_if.hasElseBody()) {
+        p_if.getElseBody().accept(*this);
+    }
+}
+
+void ConstantFolder::visit(WhileNode &p_while) {
+    fold(p_while.getConditionPtr());
+    p_while.getBody().accept(*this);
+}
+
+// The bounds are constants already, and the loop variable is never one.
+void ConstantFolder::visit(ForNode &p_for) { p_for.getBody().accept(*this); }
+
+void ConstantFolder::visit(ReturnNode &p_return) {
+    fold(p_return.getReturnValuePtr());
+}
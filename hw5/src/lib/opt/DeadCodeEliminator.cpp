@@ -0,0 +1,347 @@
+#include "opt/DeadCodeEliminator.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include "sema/SymbolTable.hpp"
+#include "visitor/AstNodeInclude.hpp"
+
+namespace {
+/// @return Whether `p_condition` is the constant `p_value`.
+bool getConstantCondition(const ExpressionNode &p_condition, bool &p_value) {
+    const auto *constant =
+        dynamic_cast<const ConstantValueNode *>(&p_condition);
+    if (!constant || !constant->getInferredType()->isBool()) {
+        return false;
+    }
+    p_value = constant->getConstantPtr()->boolean();
+    return true;
+}
+
+bool containsCall(const ExpressionNode &p_expr) {
+    if (dynamic_cast<const FunctionInvocationNode *>(&p_expr)) {
+        return true;
+    }
+    if (const auto *bin_op =
+            dynamic_cast<const BinaryOperatorNode *>(&p_expr)) {
+        return containsCall(bin_op->getLeftOperand()) ||
+               containsCall(bin_op->getRightOperand());
+    }
+    if (const auto *un_op = dynamic_cast<const UnaryOperatorNode *>(&p_expr)) {
+        return containsCall(un_op->getOperand());
+    }
+    if (const auto *ref =
+            dynamic_cast<const VariableReferenceNode *>(&p_expr)) {
+        const auto &indices = ref->getIndices();
+        return std::any_of(indices.begin(), indices.end(),
+                           [](const auto &index) {
+                               return containsCall(*index);
+                           });
+    }
+    return false;
+}
+}  // namespace
+
+void DeadCodeEliminator::run(AstNode &p_root) { p_root.accept(*this); }
+
+bool DeadCodeEliminator::isTracked(const SymbolEntry *const p_entry) {
+    if (!p_entry || p_entry->getLevel() == 0) {
+        return false;
+    }
+    const auto kind = p_entry->getKind();
+    if (kind != SymbolEntry::KindEnum::kVariableKind &&
+        kind != SymbolEntry::KindEnum::kParameterKind) {
+        return false;
+    }
+    const PType *type = p_entry->getTypePtr();
+    return type->isInteger() || type->isBool();
+}
+
+bool DeadCodeEliminator::canFallThrough(const AstNode &p_statement) {
+    if (dynamic_cast<const ReturnNode *>(&p_statement)) {
+        return false;
+    }
+    if (const auto *compound =
+            dynamic_cast<const CompoundStatementNode *>(&p_statement)) {
+        const auto &statements = compound->getStmtNodes();
+        return std::all_of(statements.begin(), statements.end(),
+                           [](const auto &statement) {
+                               return canFallThrough(*statement);
+                           });
+    }
+    bool condition = false;
+    if (const auto *if_node = dynamic_cast<const IfNode *>(&p_statement)) {
+        if (getConstantCondition(if_node->getCondition(), condition)) {
+            if (condition) {
+                return canFallThrough(if_node->getBody());
+            }
+            return !if_node->hasElseBody() ||
+                   canFallThrough(if_node->getElseBody());
+        }
+        return !if_node->hasElseBody() ||
+               canFallThrough(if_node->getBody()) ||
+               canFallThrough(if_node->getElseBody());
+    }
+    // A loop that never exits only ends by returning.
+    if (const auto *while_node =
+            dynamic_cast<const WhileNode *>(&p_statement)) {
+        return !getConstantCondition(while_node->getCondition(), condition) ||
+               !condition;
+    }
+    return true;
+}
+
+void DeadCodeEliminator::visit(ProgramNode &p_program) {
+    for (const auto &function : p_program.getFuncNodes()) {
+        function->accept(*this);
+    }
+    eliminate(p_program.getBody(), "main");
+}
+
+void DeadCodeEliminator::visit(FunctionNode &p_function) {
+    CompoundStatementNode *body = p_function.getBody();
+    if (!body) {
+        m_reports.push_back(Report{p_function.getNameCString()});
+        return;
+    }
+    eliminate(*body, p_function.getNameCString());
+}
+
+void DeadCodeEliminator::eliminate(CompoundStatementNode &p_body,
+                                   const std::string &p_name) {
+    m_reports.push_back(Report{p_name});
+    m_live.clear();
+    m_referenced.clear();
+    m_scopes.clear();
+    m_live_at_loop_heads.clear();
+
+    p_body.accept(*this);
+    removeUnusedLocals(m_reports.back());
+}
+
+void DeadCodeEliminator::removeUnusedLocals(Report &p_report) {
+    for (CompoundStatementNode *scope : m_scopes) {
+        auto &decls = scope->getDeclNodes();
+        for (auto &decl : decls) {
+            auto &variables = decl->getVariables();
+            const auto unused = std::remove_if(
+                variables.begin(), variables.end(),
+                [this](const auto &variable) {
+                    return m_referenced.count(variable->getSymbolEntry()) == 0;
+                });
+            p_report.unused_locals += std::distance(unused, variables.end());
+            variables.erase(unused, variables.end());
+        }
+        decls.erase(std::remove_if(decls.begin(), decls.end(),
+                                   [](const auto &decl) {
+                                       return decl->getVariables().empty();
+                                   }),
+                    decls.end());
+    }
+}
+
+void DeadCodeEliminator::visit(CompoundStatementNode &p_compound_statement) {
+    auto &statements = p_compound_statement.getStmtNodes();
+    if (!isDryRun()) {
+        m_scopes.push_back(&p_compound_statement);
+        auto terminator = std::find_if(statements.begin(), statements.end(),
+                                       [](const auto &statement) {
+                                           return !canFallThrough(*statement);
+                                       });
+        if (terminator != statements.end()) {
+            ++terminator;
+            m_reports.back().unreachable_statements +=
+                std::distance(terminator, statements.end());
+            statements.erase(terminator, statements.end());
+        }
+    }
+
+    for (auto i = statements.size(); i-- > 0;) {
+        m_is_dead = false;
+        m_replacement.reset();
+        statements[i]->accept(*this);
+        if (isDryRun()) {
+            continue;
+        }
+        if (m_is_dead) {
+            statements.erase(statements.begin() + i);
+        } else if (m_replacement) {
+            statements[i] = std::move(m_replacement);
+        }
+    }
+    m_is_dead = false;
+    m_replacement.reset();
+}
+
+void DeadCodeEliminator::use(ExpressionNode &p_expr) { p_expr.accept(*this); }
+
+void DeadCodeEliminator::visit(PrintNode &p_print) {
+    use(*p_print.getTargetPtr());
+}
+
+void DeadCodeEliminator::visit(BinaryOperatorNode &p_bin_op) {
+    p_bin_op.visitChildNodes(*this);
+}
+
+void DeadCodeEliminator::visit(UnaryOperatorNode &p_un_op) {
+    p_un_op.visitChildNodes(*this);
+}
+
+void DeadCodeEliminator::visit(FunctionInvocationNode &p_func_invocation) {
+    p_func_invocation.visitChildNodes(*this);
+}
+
+void DeadCodeEliminator::visit(VariableReferenceNode &p_variable_ref) {
+    const SymbolEntry *entry = p_variable_ref.getSymbolEntry();
+    if (isTracked(entry)) {
+        m_live.insert(entry);
+    }
+    if (!isDryRun()) {
+        m_referenced.insert(entry);
+    }
+    p_variable_ref.visitChildNodes(*this);
+}
+
+void DeadCodeEliminator::visit(AssignmentNode &p_assignment) {
+    auto &target = p_assignment.getLvalue();
+    const SymbolEntry *entry = target.getSymbolEntry();
+    auto &value = p_assignment.getExprPtr();
+    if (isTracked(entry) && m_live.count(entry) == 0) {
+        if (!containsCall(*value)) {
+            if (!isDryRun()) {
+                m_is_dead = true;
+                ++m_reports.back().dead_stores;
+            }
+            return;
+        }
+        if (dynamic_cast<FunctionInvocationNode *>(value.get())) {
+            use(*value);
+            if (!isDryRun()) {
+                m_replacement.reset(value.release());
+                ++m_reports.back().dead_stores;
+            }
+            return;
+        }
+    }
+
+    // The target is written after the value and its indices are read.
+    if (isTracked(entry)) {
+        m_live.erase(entry);
+    }
+    if (!isDryRun()) {
+        m_referenced.insert(entry);
+    }
+    target.visitChildNodes(*this);
+    use(*value);
+}
+
+void DeadCodeEliminator::visit(ReadNode &p_read) {
+    auto &target = p_read.getTarget();
+    const SymbolEntry *entry = target.getSymbolEntry();
+    if (isTracked(entry)) {
+        m_live.erase(entry);
+    }
+    if (!isDryRun()) {
+        m_referenced.insert(entry);
+    }
+    target.visitChildNodes(*this);
+}
+
+void DeadCodeEliminator::visit(IfNode &p_if) {
+    bool condition = false;
+    if (getConstantCondition(p_if.getCondition(), condition)) {
+        auto &taken = condition ? p_if.getBodyPtr() : p_if.getElseBodyPtr();
+        auto &not_taken = condition ? p_if.getElseBodyPtr() : p_if.getBodyPtr();
+        if (taken) {
+            taken->accept(*this);
+        }
+        if (isDryRun()) {
+            return;
+        }
+        if (not_taken) {
+            m_reports.back().unreachable_statements +=
+                not_taken->getStmtNodes().size();
+        }
+        if (taken) {
+            m_replacement = std::move(taken);
+        } else {
+            m_is_dead = true;
+        }
+        return;
+    }
+
+    const Entries live_after = m_live;
+    p_if.getBody().accept(*this);
+    if (p_if.hasElseBody()) {
+        Entries live_in_body = std::move(m_live);
+        m_live = live_after;
+        p_if.getElseBody().accept(*this);
+        m_live.insert(live_in_body.begin(), live_in_body.end());
+    } else {
+        m_live.insert(live_after.begin(), live_after.end());
+    }
+    use(*p_if.getConditionPtr());
+}
+
+void DeadCodeEliminator::visit(WhileNode &p_while) {
+    bool condition = false;
+    if (getConstantCondition(p_while.getCondition(), condition) && !condition) {
+        if (!isDryRun()) {
+            m_is_dead = true;
+            m_reports.back().unreachable_statements +=
+                p_while.getBody().getStmtNodes().size();
+        }
+        return;
+    }
+
+    // The condition is read before each iteration and before the exit.
+    use(*p_while.getConditionPtr());
+    visitLoop(p_while.getBody(), m_live);
+}
+
+void DeadCodeEliminator::visit(ForNode &p_for) {
+    // The loop variable is read by the increment and the test at the head.
+    const auto &loop_var = p_for.getLoopVarDecl().getVariables().front();
+    if (!isDryRun()) {
+        m_referenced.insert(loop_var->getSymbolEntry());
+    }
+    m_live.insert(loop_var->getSymbolEntry());
+    visitLoop(p_for.getBody(), m_live);
+}
+
+void DeadCodeEliminator::visitLoop(CompoundStatementNode &p_body,
+                                   Entries p_live_at_head) {
+    // What is live after the loop only grows each time an enclosing loop is
+    // visited again, so the set found last time is still live at the head.
+    // Starting from it, a nested loop is done in a single pass once it has
+    // settled, instead of taking as many passes as each enclosing one does.
+    Entries &live_at_head = m_live_at_loop_heads[&p_body];
+    live_at_head.insert(p_live_at_head.begin(), p_live_at_head.end());
+    // The set only grows, so it is stable once its size is.
+    ++m_num_dry_runs;
+    for (;;) {
+        m_live = live_at_head;
+        p_body.accept(*this);
+        const auto num_live = live_at_head.size();
+        live_at_head.insert(m_live.begin(), m_live.end());
+        if (live_at_head.size() == num_live) {
+            break;
+        }
+    }
+    --m_num_dry_runs;
+    p_live_at_head = live_at_head;
+    if (isDryRun()) {
+        // Only the set at the head is wanted.
+        m_live = std::move(p_live_at_head);
+        return;
+    }
+
+    m_live = p_live_at_head;
+    p_body.accept(*this);
+    m_live = std::move(p_live_at_head);
+}
+
+void DeadCodeEliminator::visit(ReturnNode &p_return) {
+    m_live.clear();
+    use(*p_return.getReturnValuePtr());
+}
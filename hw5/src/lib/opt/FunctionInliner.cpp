@@ -0,0 +1,658 @@
+#include "opt/FunctionInliner.hpp"
+
+#include <utility>
+
+#include "visitor/AstNodeInclude.hpp"
+
+constexpr int FunctionInliner::kCallCost;
+constexpr int FunctionInliner::kArgumentCost;
+constexpr int FunctionInliner::kLoopThresholdFactor;
+constexpr int FunctionInliner::kMaxCallerGrowth;
+
+namespace {
+// Any level above 0 is a local, which is all that the later passes tell
+// apart.
+constexpr std::size_t kLocalLevel = 1;
+
+bool isWordType(const PType &p_type) {
+    return p_type.isInteger() || p_type.isBool();
+}
+
+VariableReferenceNode *makeReference(const SymbolEntry &p_entry,
+                                     const Location &p_location) {
+    auto *ref = new VariableReferenceNode(p_location.line, p_location.col,
+                                          p_entry.getNameCString());
+    ref->setSymbolEntry(&p_entry);
+    ref->setInferredType(p_entry.getTypePtr());
+    return ref;
+}
+
+/// @brief Measures the body of a function and finds what keeps it from
+/// being inlined.
+class CalleeSurvey final : public AstNodeVisitor {
+  public:
+    /// @brief The AST nodes of the body.
+    int size = 0;
+    /// @brief Whether every value is an integer or a boolean.
+    bool is_supported = true;
+    /// @brief Whether it returns anywhere but at the end.
+    bool has_early_return = false;
+    std::unordered_set<std::string> callees;
+
+  private:
+    const bool m_is_void;
+    /// @brief Whether nothing runs after the statement being visited.
+    bool m_is_at_end = true;
+
+  public:
+    explicit CalleeSurvey(FunctionNode &p_function)
+        : m_is_void(p_function.getTypePtr()->isVoid()) {
+        is_supported = m_is_void || isWordType(*p_function.getTypePtr());
+        for (const auto &parameter : p_function.getParameters()) {
+            for (const auto &variable : parameter->getVariables()) {
+                is_supported =
+                    is_supported && isWordType(*variable->getTypePtr());
+            }
+        }
+        if (CompoundStatementNode *body = p_function.getBody()) {
+            body->accept(*this);
+        }
+    }
+
+    void visit(DeclNode &p_decl) override { p_decl.visitChildNodes(*this); }
+    void visit(VariableNode &p_variable) override {
+        ++size;
+        is_supported = is_supported && isWordType(*p_variable.getTypePtr());
+    }
+    void visit(ConstantValueNode &p_constant_value) override {
+        visitExpression(p_constant_value);
+    }
+    void visit(CompoundStatementNode &p_compound_statement) override {
+        const bool is_at_end = m_is_at_end;
+        for (const auto &decl : p_compound_statement.getDeclNodes()) {
+            decl->accept(*this);
+        }
+        const auto &statements = p_compound_statement.getStmtNodes();
+        for (std::size_t i = 0; i < statements.size(); ++i) {
+            m_is_at_end = is_at_end && i + 1 == statements.size();
+            statements[i]->accept(*this);
+        }
+        m_is_at_end = is_at_end;
+    }
+    void visit(PrintNode &p_print) override {
+        ++size;
+        p_print.visitChildNodes(*this);
+    }
+    void visit(BinaryOperatorNode &p_bin_op) override {
+        visitExpression(p_bin_op);
+    }
+    void visit(UnaryOperatorNode &p_un_op) override {
+        visitExpression(p_un_op);
+    }
+    void visit(FunctionInvocationNode &p_func_invocation) override {
+        callees.insert(p_func_invocation.getNameCString());
+        ++size;
+        p_func_invocation.visitChildNodes(*this);
+    }
+    void visit(VariableReferenceNode &p_variable_ref) override {
+        visitExpression(p_variable_ref);
+    }
+    void visit(AssignmentNode &p_assignment) override {
+        ++size;
+        p_assignment.visitChildNodes(*this);
+    }
+    void visit(ReadNode &p_read) override {
+        ++size;
+        p_read.visitChildNodes(*this);
+    }
+    // The branches of an `if` at the end are at the end.
+    void visit(IfNode &p_if) override {
+        ++size;
+        p_if.visitChildNodes(*this);
+    }
+    void visit(WhileNode &p_while) override { visitLoop(p_while); }
+    void visit(ForNode &p_for) override { visitLoop(p_for); }
+    void visit(ReturnNode &p_return) override {
+        has_early_return = has_early_return || !m_is_at_end || m_is_void;
+        ++size;
+        p_return.visitChildNodes(*this);
+    }
+
+  private:
+    void visitExpression(ExpressionNode &p_expr) {
+        ++size;
+        is_supported = is_supported && isWordType(*p_expr.getInferredType());
+        p_expr.visitChildNodes(*this);
+    }
+    void visitLoop(AstNode &p_loop) {
+        const bool is_at_end = m_is_at_end;
+        m_is_at_end = false;
+        ++size;
+        p_loop.visitChildNodes(*this);
+        m_is_at_end = is_at_end;
+    }
+};
+
+/// @brief Copies the body of a function for an invocation of it. The locals
+/// are declared anew, and each `return` assigns the result instead.
+class BodyCloner final : public AstNodeVisitor {
+  private:
+    std::deque<SymbolEntry> &m_entries;
+    /// @brief The entries of the function and the ones that replace them.
+    std::unordered_map<const SymbolEntry *, const SymbolEntry *> m_copies;
+    const SymbolEntry *const m_result;
+    AstNode *m_clone = nullptr;
+
+  public:
+    /// @param p_entries Where the new entries are added.
+    /// @param p_result `nullptr` if the function returns nothing.
+    BodyCloner(std::deque<SymbolEntry> &p_entries,
+               const SymbolEntry *const p_result)
+        : m_entries(p_entries), m_result(p_result) {}
+
+    template <typename NodeType>
+    NodeType *clone(const NodeType &p_node) {
+        const_cast<NodeType &>(p_node).accept(*this);
+        return static_cast<NodeType *>(m_clone);
+    }
+    /// @note Only a `return` changes its type, to an assignment.
+    AstNode *cloneStatement(AstNode &p_statement) {
+        p_statement.accept(*this);
+        return m_clone;
+    }
+
+    void visit(DeclNode &p_decl) override {
+        const Location &location = p_decl.getLocation();
+        const std::vector<IdInfo> no_ids;
+        auto *decl = new DeclNode(location.line, location.col, &no_ids,
+                                  static_cast<const PType *>(nullptr));
+        for (const auto &variable : p_decl.getVariables()) {
+            decl->getVariables().emplace_back(clone(*variable));
+        }
+        m_clone = decl;
+    }
+
+    void visit(VariableNode &p_variable) override {
+        const Location &location = p_variable.getLocation();
+        ConstantValueNode *constant = nullptr;
+        if (p_variable.getConstantPtr()) {
+            constant = new ConstantValueNode(
+                location.line, location.col,
+                new Constant(*p_variable.getConstantPtr()));
+            constant->setInferredType(p_variable.getTypePtr());
+        }
+        const SymbolEntry *entry = p_variable.getSymbolEntry();
+        // A parameter is an ordinary local of the caller.
+        const auto kind =
+            entry->getKind() == SymbolEntry::KindEnum::kParameterKind
+                ? SymbolEntry::KindEnum::kVariableKind
+                : entry->getKind();
+        m_entries.emplace_back(
+            entry->getName(), kind, entry->getLevel(), entry->getTypePtr(),
+            constant ? constant->getConstantPtr()
+                     : static_cast<const Constant *>(nullptr));
+        m_copies[entry] = &m_entries.back();
+
+        auto *variable =
+            new VariableNode(location.line, location.col,
+                             p_variable.getNameCString(),
+                             p_variable.getTypePtr(), constant);
+        variable->setSymbolEntry(&m_entries.back());
+        m_clone = variable;
+    }
+
+    void visit(ConstantValueNode &p_constant_value) override {
+        const Location &location = p_constant_value.getLocation();
+        auto *constant = new ConstantValueNode(
+            location.line, location.col,
+            new Constant(*p_constant_value.getConstantPtr()));
+        constant->setInferredType(p_constant_value.getInferredType());
+        m_clone = constant;
+    }
+
+    void visit(CompoundStatementNode &p_compound_statement) override {
+        const Location &location = p_compound_statement.getLocation();
+        CompoundStatementNode::DeclNodes decls;
+        for (const auto &decl : p_compound_statement.getDeclNodes()) {
+            decls.emplace_back(clone(*decl));
+        }
+        CompoundStatementNode::StmtNodes statements;
+        for (const auto &statement : p_compound_statement.getStmtNodes()) {
+            statements.emplace_back(cloneStatement(*statement));
+        }
+        m_clone = new CompoundStatementNode(location.line, location.col, decls,
+                                            statements);
+    }
+
+    void visit(PrintNode &p_print) override {
+        const Location &location = p_print.getLocation();
+        m_clone = new PrintNode(location.line, location.col,
+                                clone(p_print.getTarget()));
+    }
+
+    void visit(BinaryOperatorNode &p_bin_op) override {
+        const Location &location = p_bin_op.getLocation();
+        auto *bin_op = new BinaryOperatorNode(
+            location.line, location.col, p_bin_op.getOp(),
+            clone(p_bin_op.getLeftOperand()),
+            clone(p_bin_op.getRightOperand()));
+        bin_op->setInferredType(p_bin_op.getInferredType());
+        m_clone = bin_op;
+    }
+
+    void visit(UnaryOperatorNode &p_un_op) override {
+        const Location &location = p_un_op.getLocation();
+        auto *un_op =
+            new UnaryOperatorNode(location.line, location.col, p_un_op.getOp(),
+                                  clone(p_un_op.getOperand()));
+        un_op->setInferredType(p_un_op.getInferredType());
+        m_clone = un_op;
+    }
+
+    void visit(FunctionInvocationNode &p_func_invocation) override {
+        const Location &location = p_func_invocation.getLocation();
+        FunctionInvocationNode::ExprNodes arguments;
+        for (const auto &argument : p_func_invocation.getArguments()) {
+            arguments.emplace_back(clone(*argument));
+        }
+        auto *call = new FunctionInvocationNode(
+            location.line, location.col, p_func_invocation.getNameCString(),
+            arguments);
+        call->setInferredType(p_func_invocation.getInferredType());
+        m_clone = call;
+    }
+
+    void visit(VariableReferenceNode &p_variable_ref) override {
+        const Location &location = p_variable_ref.getLocation();
+        VariableReferenceNode::ExprNodes indices;
+        for (const auto &index : p_variable_ref.getIndices()) {
+            indices.emplace_back(clone(*index));
+        }
+        auto *ref = new VariableReferenceNode(location.line, location.col,
+                                              p_variable_ref.getNameCString(),
+                                              indices);
+        // The globals stay as they are.
+        auto it = m_copies.find(p_variable_ref.getSymbolEntry());
+        ref->setSymbolEntry(it != m_copies.end()
+                                ? it->second
+                                : p_variable_ref.getSymbolEntry());
+        ref->setInferredType(p_variable_ref.getInferredType());
+        m_clone = ref;
+    }
+
+    void visit(AssignmentNode &p_assignment) override {
+        const Location &location = p_assignment.getLocation();
+        m_clone = new AssignmentNode(location.line, location.col,
+                                     clone(p_assignment.getLvalue()),
+                                     clone(p_assignment.getExpr()));
+    }
+
+    void visit(ReadNode &p_read) override {
+        const Location &location = p_read.getLocation();
+        m_clone = new ReadNode(location.line, location.col,
+                               clone(p_read.getTarget()));
+    }
+
+    void visit(IfNode &p_if) override {
+        const Location &location = p_if.getLocation();
+        m_clone = new IfNode(
+            location.line, location.col, clone(p_if.getCondition()),
+            clone(p_if.getBody()),
+            p_if.hasElseBody() ? clone(p_if.getElseBody()) : nullptr);
+    }
+
+    void visit(WhileNode &p_while) override {
+        const Location &location = p_while.getLocation();
+        m_clone = new WhileNode(location.line, location.col,
+                                clone(p_while.getCondition()),
+                                clone(p_while.getBody()));
+    }
+
+    void visit(ForNode &p_for) override {
+        const Location &location = p_for.getLocation();
+        // The loop variable is declared before the others refer to it.
+        auto *loop_var_decl = clone(p_for.getLoopVarDecl());
+        m_clone = new ForNode(location.line, location.col, loop_var_decl,
+                              clone(p_for.getInitStmt()),
+                              clone(p_for.getEndCondition()),
+                              clone(p_for.getBody()));
+    }
+
+    void visit(ReturnNode &p_return) override {
+        const Location &location = p_return.getLocation();
+        m_clone = new AssignmentNode(location.line, location.col,
+                                     makeReference(*m_result, location),
+                                     clone(p_return.getReturnValue()));
+    }
+};
+
+struct CallScan {
+    /// @brief The invocations in the order they are made.
+    std::vector<std::unique_ptr<ExpressionNode> *> calls;
+    /// @brief The globals read before the first invocation, besides its
+    /// arguments.
+    std::vector<const SymbolEntry *> reads_before_first;
+};
+
+// The operands are evaluated from left to right if either of them invokes a
+// function, and only reordered otherwise.
+void scanCalls(std::unique_ptr<ExpressionNode> &p_slot, CallScan &p_scan) {
+    ExpressionNode *expr = p_slot.get();
+    if (auto *bin_op = dynamic_cast<BinaryOperatorNode *>(expr)) {
+        scanCalls(bin_op->getLeftOperandPtr(), p_scan);
+        scanCalls(bin_op->getRightOperandPtr(), p_scan);
+    } else if (auto *un_op = dynamic_cast<UnaryOperatorNode *>(expr)) {
+        scanCalls(un_op->getOperandPtr(), p_scan);
+    } else if (auto *ref = dynamic_cast<VariableReferenceNode *>(expr)) {
+        for (auto &index : ref->getIndices()) {
+            scanCalls(index, p_scan);
+        }
+        if (p_scan.calls.empty() && ref->getSymbolEntry()->getLevel() == 0) {
+            p_scan.reads_before_first.push_back(ref->getSymbolEntry());
+        }
+    } else if (auto *call = dynamic_cast<FunctionInvocationNode *>(expr)) {
+        const auto num_reads = p_scan.reads_before_first.size();
+        for (auto &argument : call->getArguments()) {
+            scanCalls(argument, p_scan);
+        }
+        if (p_scan.calls.empty()) {
+            p_scan.reads_before_first.resize(num_reads);
+        }
+        p_scan.calls.push_back(&p_slot);
+    }
+}
+}  // namespace
+
+void FunctionInliner::run(AstNode &p_root) { p_root.accept(*this); }
+
+const char *FunctionInliner::getReasonText(const Reason p_reason) {
+    switch (p_reason) {
+        case Reason::kInlined:
+            return "inlined";
+        case Reason::kNoBody:
+            return "not inlined: only declared";
+        case Reason::kRecursive:
+            return "not inlined: recursive";
+        case Reason::kUnsupportedType:
+            return "not inlined: not all integers and booleans";
+        case Reason::kEarlyReturn:
+            return "not inlined: returns before the end";
+        case Reason::kLoopCondition:
+            return "not inlined: in a loop condition";
+        case Reason::kGlobalConflict:
+            return "not inlined: writes a global read before the call";
+        case Reason::kTooLarge:
+            return "not inlined: too large";
+        case Reason::kCallerBudget:
+            return "not inlined: the caller has grown too much";
+        case Reason::kAfterCall:
+            return "not inlined: after a call that is not inlined";
+    }
+    return "";
+}
+
+void FunctionInliner::visit(ProgramNode &p_program) {
+    for (const auto &function : p_program.getFuncNodes()) {
+        if (function->getBody()) {
+            m_functions[function->getNameCString()] = function.get();
+        }
+    }
+    findRecursiveFunctions();
+    // Inlining moves the writes around but keeps them all.
+    m_side_effects = SideEffectAnalyzer().analyze(p_program);
+
+    // The callees are usually defined first, so they are inlined into
+    // before they are inlined themselves.
+    for (const auto &function : p_program.getFuncNodes()) {
+        if (CompoundStatementNode *body = function->getBody()) {
+            inlineInto(*body, function->getNameCString());
+        }
+    }
+    inlineInto(p_program.getBody(), "main");
+}
+
+void FunctionInliner::findRecursiveFunctions() {
+    std::unordered_map<std::string, std::unordered_set<std::string>> callees;
+    for (const auto &function : m_functions) {
+        callees[function.first] = CalleeSurvey(*function.second).callees;
+    }
+    for (const auto &function : m_functions) {
+        const auto &direct_callees = callees[function.first];
+        std::vector<std::string> pending(direct_callees.begin(),
+                                         direct_callees.end());
+        std::unordered_set<std::string> visited;
+        while (!pending.empty()) {
+            const std::string name = std::move(pending.back());
+            pending.pop_back();
+            if (name == function.first) {
+                m_recursive_functions.insert(name);
+                break;
+            }
+            auto it = callees.find(name);
+            if (visited.insert(name).second && it != callees.end()) {
+                pending.insert(pending.end(), it->second.begin(),
+                               it->second.end());
+            }
+        }
+    }
+}
+
+void FunctionInliner::inlineInto(CompoundStatementNode &p_body,
+                                 const std::string &p_name) {
+    m_caller = p_name;
+    m_growth = 0;
+    m_loop_depth = 0;
+    p_body.accept(*this);
+}
+
+bool FunctionInliner::inlineFirstCall(
+    const Roots &p_roots, FunctionInvocationNode *const p_statement_call) {
+    CallScan scan;
+    for (auto *root : p_roots) {
+        scanCalls(*root, scan);
+    }
+    std::unique_ptr<ExpressionNode> *slot = nullptr;
+    FunctionInvocationNode *call = p_statement_call;
+    if (!scan.calls.empty()) {
+        slot = scan.calls.front();
+        call = static_cast<FunctionInvocationNode *>(slot->get());
+    }
+    if (!call) {
+        return false;
+    }
+
+    Report site{m_caller, call->getNameCString(), call->getLocation(),
+                Reason::kInlined, 0, 0};
+    site.reason = decide(*call, scan.reads_before_first, site);
+    m_reports.push_back(site);
+    if (site.reason != Reason::kInlined) {
+        // The rest cannot be moved before it.
+        for (std::size_t i = 1; i < scan.calls.size(); ++i) {
+            report(static_cast<FunctionInvocationNode &>(**scan.calls[i]),
+                   Reason::kAfterCall);
+        }
+        if (p_statement_call && call != p_statement_call) {
+            report(*p_statement_call, Reason::kAfterCall);
+        }
+        return false;
+    }
+
+    m_growth += site.size;
+    std::unique_ptr<AstNode> *const statement = m_statement;
+    substitute(*call, slot);
+    (*statement)->accept(*this);
+    return true;
+}
+
+FunctionInliner::Reason FunctionInliner::decide(
+    const FunctionInvocationNode &p_call,
+    const std::vector<const SymbolEntry *> &p_reads_before,
+    Report &p_report) const {
+    const std::string name = p_call.getNameCString();
+    auto it = m_functions.find(name);
+    if (it == m_functions.end()) {
+        return Reason::kNoBody;
+    }
+    if (m_recursive_functions.count(name) != 0) {
+        return Reason::kRecursive;
+    }
+    const CalleeSurvey survey(*it->second);
+    p_report.size = survey.size;
+    p_report.call_cost =
+        kCallCost +
+        kArgumentCost * static_cast<int>(p_call.getArguments().size());
+    if (!survey.is_supported) {
+        return Reason::kUnsupportedType;
+    }
+    if (survey.has_early_return) {
+        return Reason::kEarlyReturn;
+    }
+
+    auto writes = m_side_effects.find(name);
+    if (writes != m_side_effects.end()) {
+        for (const SymbolEntry *global : p_reads_before) {
+            if (writes->second.count(global) != 0) {
+                return Reason::kGlobalConflict;
+            }
+        }
+    }
+
+    const int threshold =
+        m_loop_depth > 0 ? m_threshold * kLoopThresholdFactor : m_threshold;
+    if (p_report.size - p_report.call_cost > threshold) {
+        return Reason::kTooLarge;
+    }
+    if (m_growth + p_report.size > kMaxCallerGrowth) {
+        return Reason::kCallerBudget;
+    }
+    return Reason::kInlined;
+}
+
+void FunctionInliner::substitute(FunctionInvocationNode &p_call,
+                                 std::unique_ptr<ExpressionNode> *p_slot) {
+    // The key outlives the entry of the result, which refers to its name.
+    const auto callee_it = m_functions.find(p_call.getNameCString());
+    FunctionNode &callee = *callee_it->second;
+    const Location location = (*m_statement)->getLocation();
+    CompoundStatementNode::DeclNodes decls;
+    CompoundStatementNode::StmtNodes statements;
+
+    const SymbolEntry *result = nullptr;
+    if (!callee.getTypePtr()->isVoid()) {
+        m_entries.emplace_back(callee_it->first,
+                               SymbolEntry::KindEnum::kVariableKind,
+                               kLocalLevel, callee.getTypePtr(),
+                               static_cast<const Constant *>(nullptr));
+        result = &m_entries.back();
+        const std::vector<IdInfo> no_ids;
+        decls.emplace_back(new DeclNode(location.line, location.col, &no_ids,
+                                        callee.getTypePtr()));
+        decls.back()->getVariables().emplace_back(new VariableNode(
+            location.line, location.col, callee.getNameCString(),
+            callee.getTypePtr(), nullptr));
+        decls.back()->getVariables().back()->setSymbolEntry(result);
+    }
+
+    BodyCloner cloner(m_entries, result);
+    auto &arguments = p_call.getArguments();
+    std::size_t i = 0;
+    for (const auto &parameter : callee.getParameters()) {
+        decls.emplace_back(cloner.clone(*parameter));
+        for (const auto &variable : decls.back()->getVariables()) {
+            ExpressionNode *argument = arguments[i++].release();
+            statements.emplace_back(new AssignmentNode(
+                location.line, location.col,
+                makeReference(*variable->getSymbolEntry(),
+                              argument->getLocation()),
+                argument));
+        }
+    }
+    statements.emplace_back(cloner.clone(*callee.getBody()));
+
+    // The invocation is gone with the statement if it is the statement.
+    if (p_slot) {
+        *p_slot = std::unique_ptr<ExpressionNode>(
+            makeReference(*result, p_call.getLocation()));
+        statements.emplace_back(std::move(*m_statement));
+    }
+    m_statement->reset(new CompoundStatementNode(location.line, location.col,
+                                                 decls, statements));
+}
+
+void FunctionInliner::report(const FunctionInvocationNode &p_call,
+                             const Reason p_reason) {
+    m_reports.push_back(Report{m_caller, p_call.getNameCString(),
+                               p_call.getLocation(), p_reason, 0, 0});
+}
+
+void FunctionInliner::visit(CompoundStatementNode &p_compound_statement) {
+    // A statement may be replaced while it is visited, but none is added or
+    // removed.
+    for (auto &statement : p_compound_statement.getStmtNodes()) {
+        m_statement = &statement;
+        statement->accept(*this);
+    }
+}
+
+void FunctionInliner::visit(PrintNode &p_print) {
+    inlineFirstCall({&p_print.getTargetPtr()}, nullptr);
+}
+
+// Only visited as a statement; the invocations in expressions are found by
+// `scanCalls()`.
+void FunctionInliner::visit(FunctionInvocationNode &p_func_invocation) {
+    Roots roots;
+    for (auto &argument : p_func_invocation.getArguments()) {
+        roots.push_back(&argument);
+    }
+    inlineFirstCall(roots, &p_func_invocation);
+}
+
+void FunctionInliner::visit(AssignmentNode &p_assignment) {
+    Roots roots{&p_assignment.getExprPtr()};
+    for (auto &index : p_assignment.getLvalue().getIndices()) {
+        roots.push_back(&index);
+    }
+    inlineFirstCall(roots, nullptr);
+}
+
+void FunctionInliner::visit(ReadNode &p_read) {
+    Roots roots;
+    for (auto &index : p_read.getTarget().getIndices()) {
+        roots.push_back(&index);
+    }
+    inlineFirstCall(roots, nullptr);
+}
+
+void FunctionInliner::visit(IfNode &p_if) {
+    // The block visits the `if` again once the condition is inlined into.
+    if (inlineFirstCall({&p_if.getConditionPtr()}, nullptr)) {
+        return;
+    }
+    p_if.getBody().accept(*this);
+    if (p_if.hasElseBody()) {
+        p_if.getElseBody().accept(*this);
+    }
+}
+
+void FunctionInliner::visit(WhileNode &p_while) {
+    CallScan scan;
+    scanCalls(p_while.getConditionPtr(), scan);
+    for (auto *call : scan.calls) {
+        report(static_cast<FunctionInvocationNode &>(**call),
+               Reason::kLoopCondition);
+    }
+    ++m_loop_depth;
+    p_while.getBody().accept(*this);
+    --m_loop_depth;
+}
+
+void FunctionInliner::visit(ForNode &p_for) {
+    ++m_loop_depth;
+    p_for.getBody().accept(*this);
+    --m_loop_depth;
+}
+
+void FunctionInliner::visit(ReturnNode &p_return) {
+    inlineFirstCall({&p_return.getReturnValuePtr()}, nullptr);
+}
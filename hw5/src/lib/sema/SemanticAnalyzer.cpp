@@ -2,14 +2,19 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
 #include <memory>
 #include <set>
 #include <stack>
 #include <vector>
 
 #include "AST/PType.hpp"
+#include "AST/PTypeContext.hpp"
 #include "sema/Error.hpp"
 #include "sema/ErrorPrinter.hpp"
+#include "util/WorkStealingPool.hpp"
 #include "visitor/AstNodeInclude.hpp"
 
 //
@@ -23,8 +28,9 @@
 //    declaration (ProgramNode, VariableNode, FunctionNode).
 // 3. Traverse child nodes of this node.
 // 4. Perform semantic analyses of this node.
-// 5. Pop the symbol table pushed at the 1st step and record it for later phases
-//    to retain the information.
+// 5. Pop the symbol table pushed at the 1st step and keep it alive, since the
+//    declarations and the references record the entries they resolve to for
+//    later phases.
 //
 // If encountering an error in the child nodes of an expression, the type of the
 // parent node is set to error type to propagate the error.
@@ -36,18 +42,22 @@ void SemanticAnalyzer::visit(ProgramNode &p_program) {
     m_returned_type_stack.push(p_program.getTypePtr());
 
     auto *entry = m_symbol_manager.addSymbol(
-        p_program.getName(), SymbolEntry::KindEnum::kProgramKind,
+        p_program.getNameCString(), SymbolEntry::KindEnum::kProgramKind,
         p_program.getTypePtr(), static_cast<Constant *>(nullptr));
     if (!entry) {
         printError(SymbolRedeclarationError(p_program.getLocation(),
                                             p_program.getNameCString()));
     }
 
-    p_program.visitChildNodes(*this);
+    for (const auto &decl : p_program.getDeclNodes()) {
+        decl->accept(*this);
+    }
+    analyzeFunctions(p_program);
+    const_cast<CompoundStatementNode &>(p_program.getBody()).accept(*this);
 
     m_returned_type_stack.pop();
     m_context_stack.pop();
-    m_symbol_table_of_scoping_nodes[&p_program] = m_symbol_manager.popScope();
+    closeScope();
 }
 
 void SemanticAnalyzer::visit(DeclNode &p_decl) {
@@ -92,15 +102,16 @@ bool SemanticAnalyzer::isRedeclaringSymbol(const std::string &p_name) const {
 
 void SemanticAnalyzer::visit(VariableNode &p_variable) {
     SymbolEntry *entry = nullptr;
-    if (isShadowingLoopVar(p_variable.getName()) ||
-        isRedeclaringSymbol(p_variable.getName())) {
+    if (isShadowingLoopVar(p_variable.getNameCString()) ||
+        isRedeclaringSymbol(p_variable.getNameCString())) {
         printError(SymbolRedeclarationError(p_variable.getLocation(),
                                             p_variable.getNameCString()));
     } else {
         entry = m_symbol_manager.addSymbol(
-            p_variable.getName(), determineVarKind(p_variable),
+            p_variable.getNameCString(), determineVarKind(p_variable),
             p_variable.getTypePtr(), p_variable.getConstantPtr());
         assert(entry);
+        p_variable.setSymbolEntry(entry);
     }
 
     p_variable.visitChildNodes(*this);
@@ -120,20 +131,20 @@ void SemanticAnalyzer::visit(ConstantValueNode &p_constant_value) {
         p_constant_value.getTypePtr()->getStructElementType(0));
 }
 
-void SemanticAnalyzer::visit(FunctionNode &p_function) {
-    if (isShadowingLoopVar(p_function.getName()) ||
-        isRedeclaringSymbol(p_function.getName())) {
-        printError(SymbolRedeclarationError(p_function.getLocation(),
-                                            p_function.getNameCString()));
-    } else {
-        auto *entry = m_symbol_manager.addSymbol(
-            p_function.getName(), SymbolEntry::KindEnum::kFunctionKind,
-            p_function.getTypePtr(), &p_function.getParameters());
-        assert(entry);
+bool SemanticAnalyzer::declareFunction(const FunctionNode &p_function) {
+    if (isShadowingLoopVar(p_function.getNameCString()) ||
+        isRedeclaringSymbol(p_function.getNameCString())) {
+        return false;
     }
+    auto *entry = m_symbol_manager.addSymbol(
+        p_function.getNameCString(), SymbolEntry::KindEnum::kFunctionKind,
+        p_function.getTypePtr(), &p_function.getParameters());
+    assert(entry);
+    (void)entry;
+    return true;
+}
 
-    int saved_offset = m_symbol_manager.getGlobalOffset();
-    m_symbol_manager.setGlobalOffset(-12);
+void SemanticAnalyzer::analyzeFunctionBody(FunctionNode &p_function) {
     m_symbol_manager.pushScope();
     m_context_stack.push(SemanticContext::kFunction);
     m_returned_type_stack.push(p_function.getTypePtr());
@@ -147,10 +158,120 @@ void SemanticAnalyzer::visit(FunctionNode &p_function) {
     p_function.visitBodyChildNodes(*this);
     m_context_stack.pop();
 
-    m_symbol_manager.setGlobalOffset(saved_offset);
     m_returned_type_stack.pop();
     m_context_stack.pop();
-    m_symbol_table_of_scoping_nodes[&p_function] = m_symbol_manager.popScope();
+    closeScope();
+}
+
+void SemanticAnalyzer::visit(FunctionNode &p_function) {
+    if (!declareFunction(p_function)) {
+        printError(SymbolRedeclarationError(p_function.getLocation(),
+                                            p_function.getNameCString()));
+    }
+    analyzeFunctionBody(p_function);
+}
+
+SemanticAnalyzer::SemanticAnalyzer(const SemanticAnalyzer &p_parent,
+                                   std::FILE *const p_error_stream,
+                                   std::FILE *const p_dump_stream)
+    : m_type_context(p_parent.m_type_context),
+      m_symbol_manager(*p_parent.m_symbol_manager.getCurrentTable(),
+                       p_parent.m_symbol_manager.isDumping(), p_dump_stream),
+      m_error_entry_set(p_parent.m_error_entry_set),
+      m_error_printer(p_parent.m_error_printer.getSource(), p_error_stream),
+      m_dump_stream(p_dump_stream) {
+    m_context_stack.push(SemanticContext::kGlobal);
+    m_returned_type_stack.push(p_parent.m_returned_type_stack.top());
+}
+
+void SemanticAnalyzer::analyzeFunctions(ProgramNode &p_program) {
+    const auto &functions = p_program.getFuncNodes();
+    const std::size_t num_threads = std::min(m_num_threads, functions.size());
+    if (num_threads <= 1) {
+        for (const auto &function : functions) {
+            function->accept(*this);
+        }
+        return;
+    }
+
+    // A body sees the functions up to its own, as if the functions were
+    // analyzed one by one, so the number of the global entries in scope is
+    // taken right after each declaration.
+    std::vector<bool> is_redeclared(functions.size());
+    std::vector<std::size_t> num_visible_globals(functions.size());
+    for (std::size_t i = 0; i < functions.size(); ++i) {
+        is_redeclared[i] = !declareFunction(*functions[i]);
+        num_visible_globals[i] =
+            m_symbol_manager.getCurrentTable()->getEntries().size();
+    }
+
+    // The functions are analyzed in runs of consecutive ones, a few runs per
+    // thread, so that the cost of a run is not dominated by setting it up.
+    struct Run {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        bool has_error = false;
+        std::vector<SymbolManager::Table> closed_scopes;
+        char *errors = nullptr;
+        std::size_t errors_size = 0;
+        char *dumps = nullptr;
+        std::size_t dumps_size = 0;
+    };
+    const std::size_t run_length =
+        (functions.size() + num_threads * kNumRunsPerThread - 1) /
+        (num_threads * kNumRunsPerThread);
+    std::vector<Run> runs;
+    for (std::size_t i = 0; i < functions.size(); i += run_length) {
+        runs.emplace_back();
+        runs.back().begin = i;
+        runs.back().end = std::min(i + run_length, functions.size());
+    }
+
+    // The global table is only read from here on.
+    {
+        WorkStealingPool pool(num_threads);
+        for (auto &run : runs) {
+            pool.submit([this, &functions, &is_redeclared,
+                         &num_visible_globals, &run] {
+                std::FILE *const error_stream =
+                    open_memstream(&run.errors, &run.errors_size);
+                std::FILE *const dump_stream =
+                    open_memstream(&run.dumps, &run.dumps_size);
+                assert(error_stream && dump_stream &&
+                       "Failed to open the buffers of a function");
+                {
+                    SemanticAnalyzer analyzer(*this, error_stream,
+                                              dump_stream);
+                    for (std::size_t i = run.begin; i < run.end; ++i) {
+                        FunctionNode &function = *functions[i];
+                        analyzer.m_symbol_manager.setNumVisibleOuterEntries(
+                            num_visible_globals[i]);
+                        if (is_redeclared[i]) {
+                            analyzer.printError(SymbolRedeclarationError(
+                                function.getLocation(),
+                                function.getNameCString()));
+                        }
+                        analyzer.analyzeFunctionBody(function);
+                    }
+                    run.has_error = analyzer.m_has_error;
+                    run.closed_scopes = std::move(analyzer.m_closed_scopes);
+                }
+                std::fclose(error_stream);
+                std::fclose(dump_stream);
+            });
+        }
+        pool.wait();
+    }
+
+    for (auto &run : runs) {
+        std::fwrite(run.errors, 1, run.errors_size, m_error_printer.getFile());
+        std::fwrite(run.dumps, 1, run.dumps_size, m_dump_stream);
+        std::free(run.errors);
+        std::free(run.dumps);
+        m_has_error = m_has_error || run.has_error;
+        std::move(run.closed_scopes.begin(), run.closed_scopes.end(),
+                  std::back_inserter(m_closed_scopes));
+    }
 }
 
 void SemanticAnalyzer::visit(CompoundStatementNode &p_compound_statement) {
@@ -160,8 +281,7 @@ void SemanticAnalyzer::visit(CompoundStatementNode &p_compound_statement) {
     p_compound_statement.visitChildNodes(*this);
 
     m_context_stack.pop();
-    m_symbol_table_of_scoping_nodes[&p_compound_statement] =
-        m_symbol_manager.popScope();
+    closeScope();
 }
 
 void SemanticAnalyzer::visit(PrintNode &p_print) {
@@ -224,15 +344,16 @@ bool validateBinaryOperands(const BinaryOperatorNode &p_bin_op) {
     return false;
 }
 
-void setBinaryOpInferredType(BinaryOperatorNode &p_bin_op) {
+void setBinaryOpInferredType(BinaryOperatorNode &p_bin_op,
+                              const PTypeContext &p_type_context) {
     const auto *left_type = p_bin_op.getLeftOperand().getInferredType();
     const auto *right_type = p_bin_op.getRightOperand().getInferredType();
 
     switch (p_bin_op.getOp()) {
         case Operator::kPlusOp:
             if (left_type->isString() && right_type->isString()) {
-                p_bin_op.setInferredType(
-                    new PType(PType::PrimitiveTypeEnum::kStringType));
+                p_bin_op.setInferredType(p_type_context.getType(
+                    PType::PrimitiveTypeEnum::kStringType));
                 return;
             }
             [[fallthrough]];
@@ -240,18 +361,18 @@ void setBinaryOpInferredType(BinaryOperatorNode &p_bin_op) {
         case Operator::kMultiplyOp:
         case Operator::kDivideOp:
             if (left_type->isReal() || right_type->isReal()) {
-                p_bin_op.setInferredType(
-                    new PType(PType::PrimitiveTypeEnum::kRealType));
+                p_bin_op.setInferredType(p_type_context.getType(
+                    PType::PrimitiveTypeEnum::kRealType));
                 return;
             }
         case Operator::kModOp:
-            p_bin_op.setInferredType(
-                new PType(PType::PrimitiveTypeEnum::kIntegerType));
+            p_bin_op.setInferredType(p_type_context.getType(
+                PType::PrimitiveTypeEnum::kIntegerType));
             return;
         case Operator::kAndOp:
         case Operator::kOrOp:
-            p_bin_op.setInferredType(
-                new PType(PType::PrimitiveTypeEnum::kBoolType));
+            p_bin_op.setInferredType(p_type_context.getType(
+                PType::PrimitiveTypeEnum::kBoolType));
             return;
         case Operator::kLessOp:
         case Operator::kLessOrEqualOp:
@@ -259,8 +380,8 @@ void setBinaryOpInferredType(BinaryOperatorNode &p_bin_op) {
         case Operator::kGreaterOp:
         case Operator::kGreaterOrEqualOp:
         case Operator::kNotEqualOp:
-            p_bin_op.setInferredType(
-                new PType(PType::PrimitiveTypeEnum::kBoolType));
+            p_bin_op.setInferredType(p_type_context.getType(
+                PType::PrimitiveTypeEnum::kBoolType));
             return;
         default:
             assert(false && "unknown binary op or unary op");
@@ -277,8 +398,8 @@ void SemanticAnalyzer::visit(BinaryOperatorNode &p_bin_op) {
         // NOTE: Although for operations other than arithmetic operations that
         // has fixed result type, we can set the type to the expected one, this
         // compiler handles errors with propagation.
-        p_bin_op.setInferredType(
-            new PType(PType::PrimitiveTypeEnum::kErrorType));
+        p_bin_op.setInferredType(m_type_context.getType(
+            PType::PrimitiveTypeEnum::kErrorType));
         return;
     }
 
@@ -291,7 +412,7 @@ void SemanticAnalyzer::visit(BinaryOperatorNode &p_bin_op) {
         return;
     }
 
-    setBinaryOpInferredType(p_bin_op);
+    setBinaryOpInferredType(p_bin_op, m_type_context);
 }
 
 namespace {
@@ -315,15 +436,16 @@ bool validateUnaryOperand(const UnaryOperatorNode &p_un_op) {
     return false;
 }
 
-void setUnaryOpInferredType(UnaryOperatorNode &p_un_op) {
+void setUnaryOpInferredType(UnaryOperatorNode &p_un_op,
+                             const PTypeContext &p_type_context) {
     switch (p_un_op.getOp()) {
         case Operator::kNegOp:
-            p_un_op.setInferredType(new PType(
+            p_un_op.setInferredType(p_type_context.getType(
                 p_un_op.getOperand().getInferredType()->getPrimitiveType()));
             return;
         case Operator::kNotOp:
-            p_un_op.setInferredType(
-                new PType(PType::PrimitiveTypeEnum::kBoolType));
+            p_un_op.setInferredType(p_type_context.getType(
+                PType::PrimitiveTypeEnum::kBoolType));
             return;
         default:
             assert(false && "unknown binary op or unary op");
@@ -338,8 +460,8 @@ void SemanticAnalyzer::visit(UnaryOperatorNode &p_un_op) {
         // Propagate the error type.
         // NOTE: Although for the not operator, we can set the type to boolean,
         // this compiler handles errors with propagation.
-        p_un_op.setInferredType(
-            new PType(PType::PrimitiveTypeEnum::kErrorType));
+        p_un_op.setInferredType(m_type_context.getType(
+            PType::PrimitiveTypeEnum::kErrorType));
         return;
     }
 
@@ -351,7 +473,7 @@ void SemanticAnalyzer::visit(UnaryOperatorNode &p_un_op) {
         return;
     }
 
-    setUnaryOpInferredType(p_un_op);
+    setUnaryOpInferredType(p_un_op, m_type_context);
 }
 
 bool SemanticAnalyzer::analyzeArgumentTypes(
@@ -386,11 +508,11 @@ void SemanticAnalyzer::visit(FunctionInvocationNode &p_func_invocation) {
     p_func_invocation.visitChildNodes(*this);
 
     const SymbolEntry *entry =
-        m_symbol_manager.lookup(p_func_invocation.getName());
+        m_symbol_manager.lookup(p_func_invocation.getNameCString());
     if (entry && m_error_entry_set.find(const_cast<SymbolEntry *>(entry)) !=
                      m_error_entry_set.end()) {
-        p_func_invocation.setInferredType(
-            new PType(PType::PrimitiveTypeEnum::kErrorType));
+        p_func_invocation.setInferredType(m_type_context.getType(
+            PType::PrimitiveTypeEnum::kErrorType));
         return;
     }
     // 1. The identifier has to be in symbol tables.
@@ -428,24 +550,24 @@ void SemanticAnalyzer::visit(FunctionInvocationNode &p_func_invocation) {
     // (argument) must be the same type of the corresponding parameter after
     // appropriate type coercion.
     if (!analyzeArgumentTypes(parameters, arguments)) {
-        p_func_invocation.setInferredType(
-            new PType(PType::PrimitiveTypeEnum::kErrorType));
+        p_func_invocation.setInferredType(m_type_context.getType(
+            PType::PrimitiveTypeEnum::kErrorType));
         return;
     }
 
     p_func_invocation.setInferredType(
-        new PType(entry->getTypePtr()->getPrimitiveType()));
+        m_type_context.getType(entry->getTypePtr()->getPrimitiveType()));
 }
 
 void SemanticAnalyzer::visit(VariableReferenceNode &p_variable_ref) {
     p_variable_ref.visitChildNodes(*this);
 
     const SymbolEntry *entry =
-        m_symbol_manager.lookup(p_variable_ref.getName());
+        m_symbol_manager.lookup(p_variable_ref.getNameCString());
     if (entry && m_error_entry_set.find(const_cast<SymbolEntry *>(entry)) !=
                      m_error_entry_set.end()) {
-        p_variable_ref.setInferredType(
-            new PType(PType::PrimitiveTypeEnum::kErrorType));
+        p_variable_ref.setInferredType(m_type_context.getType(
+            PType::PrimitiveTypeEnum::kErrorType));
         return;
     }
 
@@ -469,13 +591,14 @@ void SemanticAnalyzer::visit(VariableReferenceNode &p_variable_ref) {
             p_variable_ref);
         return;
     }
+    p_variable_ref.setSymbolEntry(entry);
     // 3. Each index of an array reference must be of the integer type.
     // NOTE: It's sound even they are scalar variables since the indices are
     // simply empty and the loop is not executed.
     for (const auto &index : p_variable_ref.getIndices()) {
         if (index->getInferredType()->isError()) {
-            p_variable_ref.setInferredType(
-                new PType(PType::PrimitiveTypeEnum::kErrorType));
+            p_variable_ref.setInferredType(m_type_context.getType(
+                PType::PrimitiveTypeEnum::kErrorType));
             return;
         }
         if (!index->getInferredType()->isInteger()) {
@@ -501,7 +624,7 @@ void SemanticAnalyzer::visit(VariableReferenceNode &p_variable_ref) {
 }
 
 bool SemanticAnalyzer::analyzeAssignmentLvalue(
-    const AssignmentNode &p_assignment, const SymbolManager &p_symbol_manager) {
+    const AssignmentNode &p_assignment) {
     const auto &lvalue = p_assignment.getLvalue();
     const auto *const lvalue_type = lvalue.getInferredType();
 
@@ -512,7 +635,7 @@ bool SemanticAnalyzer::analyzeAssignmentLvalue(
         return false;
     }
 
-    const auto *const entry = p_symbol_manager.lookup(lvalue.getName());
+    const auto *const entry = lvalue.getSymbolEntry();
     // 2. The variable reference cannot be a reference to a constant variable.
     if (entry->getKind() == SymbolEntry::KindEnum::kConstantKind) {
         printError(AssignToConstantError(lvalue.getLocation(),
@@ -563,7 +686,7 @@ void SemanticAnalyzer::visit(AssignmentNode &p_assignment) {
     }
     // Skip the rest of semantic checks if there are any errors in the node of
     // the variable reference.
-    if (!analyzeAssignmentLvalue(p_assignment, m_symbol_manager)) {
+    if (!analyzeAssignmentLvalue(p_assignment)) {
         return;
     }
     // Skip the rest of semantic checks if there are any errors in the node of
@@ -588,8 +711,7 @@ void SemanticAnalyzer::visit(ReadNode &p_read) {
         return;
     }
 
-    const auto *const entry =
-        m_symbol_manager.lookup(p_read.getTarget().getName());
+    const auto *const entry = p_read.getTarget().getSymbolEntry();
     assert(entry &&
            "Shouldn't reach here. This should be caught during the"
            "visits of child nodes");
@@ -649,7 +771,7 @@ void SemanticAnalyzer::visit(ForNode &p_for) {
     }
 
     m_context_stack.pop();
-    m_symbol_table_of_scoping_nodes[&p_for] = m_symbol_manager.popScope();
+    closeScope();
 }
 
 void SemanticAnalyzer::visit(ReturnNode &p_return) {
@@ -680,6 +802,10 @@ void SemanticAnalyzer::visit(ReturnNode &p_return) {
     }
 }
 
+void SemanticAnalyzer::closeScope() {
+    m_closed_scopes.push_back(m_symbol_manager.popScope());
+}
+
 void SemanticAnalyzer::printError(const Error &p_error) {
     m_error_printer.print(p_error);
     m_has_error = true;
@@ -688,5 +814,6 @@ void SemanticAnalyzer::printError(const Error &p_error) {
 void SemanticAnalyzer::printErrorAndSetType(const Error &p_error,
                                             ExpressionNode &p_expr) {
     printError(p_error);
-    p_expr.setInferredType(new PType(PType::PrimitiveTypeEnum::kErrorType));
+    p_expr.setInferredType(
+        m_type_context.getType(PType::PrimitiveTypeEnum::kErrorType));
 }
@@ -2,9 +2,21 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstdio>
 #include <utility>
 
+namespace {
+constexpr std::size_t kMinNumSlots = 8;
+
+std::size_t hashName(const std::string *const p_name) {
+    // Fibonacci hashing; the low bits of an address are mostly alignment.
+    const auto address = reinterpret_cast<std::uintptr_t>(p_name);
+    return static_cast<std::size_t>(
+        (static_cast<uint64_t>(address) * 0x9E3779B97F4A7C15ull) >> 32);
+}
+}  // namespace
+
 // ===========================================
 // > Attribute
 // ===========================================
@@ -31,47 +43,91 @@ const FunctionNode::DeclNodes *Attribute::parameters() const {
 // ===========================================
 // > SymbolTable
 // ===========================================
+constexpr int SymbolTable::kEmptySlot;
+
 SymbolEntry *SymbolTable::addSymbol(const std::string &p_name,
                                     const SymbolEntry::KindEnum p_kind,
                                     const size_t p_level,
                                     const PType *const p_p_type,
-                                    const Constant *const p_constant,
-                                    const int p_offset) {
-    m_entries.emplace_back(new SymbolEntry(p_name, p_kind, p_level, p_p_type,
-                                           p_constant, p_offset));
-    return m_entries.back().get();
+                                    const Constant *const p_constant) {
+    m_entries.emplace_back(*m_names->intern(p_name), p_kind, p_level,
+                           p_p_type, p_constant);
+    index();
+    return &m_entries.back();
 }
 
 SymbolEntry *SymbolTable::addSymbol(
     const std::string &p_name, const SymbolEntry::KindEnum p_kind,
     const size_t p_level, const PType *const p_p_type,
-    const FunctionNode::DeclNodes *const p_parameters, const int p_offset) {
-    m_entries.emplace_back(new SymbolEntry(p_name, p_kind, p_level, p_p_type,
-                                           p_parameters, p_offset));
-    return m_entries.back().get();
+    const FunctionNode::DeclNodes *const p_parameters) {
+    m_entries.emplace_back(*m_names->intern(p_name), p_kind, p_level,
+                           p_p_type, p_parameters);
+    index();
+    return &m_entries.back();
 }
 
-const SymbolEntry *SymbolTable::lookup(const std::string &p_name) const {
-    for (const auto &entry : m_entries) {
-        if (entry->getName() == p_name) {
-            return entry.get();
+void SymbolTable::index() {
+    if (m_entries.size() * 2 > m_slots.size()) {
+        m_slots.assign(std::max(kMinNumSlots, m_slots.size() * 2), kEmptySlot);
+        for (std::size_t i = 0; i + 1 < m_entries.size(); ++i) {
+            m_slots[findSlot(&m_entries[i].getName())] = static_cast<int>(i);
         }
     }
-    return nullptr;
+    const std::size_t slot = findSlot(&m_entries.back().getName());
+    assert(m_slots[slot] == kEmptySlot && "Redeclared in the same table");
+    m_slots[slot] = static_cast<int>(m_entries.size() - 1);
+}
+
+std::size_t SymbolTable::findSlot(const std::string *const p_name) const {
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = hashName(p_name) & mask;
+    while (m_slots[slot] != kEmptySlot &&
+           &m_entries[m_slots[slot]].getName() != p_name) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+const SymbolEntry *SymbolTable::lookup(const std::string *const p_name) const {
+    if (m_slots.empty()) {
+        return nullptr;
+    }
+    const int index = m_slots[findSlot(p_name)];
+    return (index != kEmptySlot) ? &m_entries[index] : nullptr;
 }
 
-void SymbolTable::dump() const {
-    std::printf(
+const SymbolEntry *SymbolTable::lookup(const std::string *const p_name,
+                                       const std::size_t p_num_visible) const {
+    if (m_slots.empty()) {
+        return nullptr;
+    }
+    // The entries are indexed in the order of declaration.
+    const int index = m_slots[findSlot(p_name)];
+    return (index != kEmptySlot &&
+            static_cast<std::size_t>(index) < p_num_visible)
+               ? &m_entries[index]
+               : nullptr;
+}
+
+const SymbolEntry *SymbolTable::lookup(const std::string &p_name) const {
+    const std::string *const name = m_names->find(p_name);
+    return name ? lookup(name) : nullptr;
+}
+
+void SymbolTable::dump(std::FILE *const p_file) const {
+    std::fprintf(
+        p_file,
         "=========================================================="
         "====================================================\n");
-    std::printf("%-33s%-11s%-11s%-17s%-11s\n", "Name", "Kind", "Level", "Type",
-                "Attribute");
-    std::printf(
+    std::fprintf(p_file, "%-33s%-11s%-11s%-17s%-11s\n", "Name", "Kind",
+                 "Level", "Type", "Attribute");
+    std::fprintf(
+        p_file,
         "----------------------------------------------------------"
         "----------------------------------------------------\n");
 
     std::string type_string;
-    auto construct_attr_string = [&type_string](const auto &p_entry_ptr) {
+    auto construct_attr_string = [&type_string](const auto *p_entry_ptr) {
         if (p_entry_ptr->getKind() == SymbolEntry::KindEnum::kFunctionKind) {
             const FunctionNode::DeclNodes *const parameters_ptr =
                 p_entry_ptr->getAttribute().parameters();
@@ -89,23 +145,26 @@ void SymbolTable::dump() const {
         }
     };
 
-    auto dump_entry = [&construct_attr_string](const auto &p_entry_ptr) {
+    auto dump_entry = [&construct_attr_string, p_file](const auto &p_entry) {
+        const SymbolEntry *const p_entry_ptr = &p_entry;
         static const char *kKindStrings[] = {"program",   "function",
                                              "parameter", "variable",
                                              "loop_var",  "constant"};
 
-        std::printf("%-33s", p_entry_ptr->getNameCString());
-        std::printf("%-11s",
-                    kKindStrings[static_cast<size_t>(p_entry_ptr->getKind())]);
-        std::printf("%lu%-10s", p_entry_ptr->getLevel(),
-                    (p_entry_ptr->getLevel() != 0) ? "(local)" : "(global)");
-        std::printf("%-17s", p_entry_ptr->getTypePtr()->getPTypeCString());
-        std::printf("%-11s\n", construct_attr_string(p_entry_ptr));
+        std::fprintf(p_file, "%-33s", p_entry_ptr->getNameCString());
+        std::fprintf(p_file, "%-11s",
+                     kKindStrings[static_cast<size_t>(p_entry_ptr->getKind())]);
+        std::fprintf(p_file, "%lu%-10s", p_entry_ptr->getLevel(),
+                     (p_entry_ptr->getLevel() != 0) ? "(local)" : "(global)");
+        std::fprintf(p_file, "%-17s",
+                     p_entry_ptr->getTypePtr()->getPTypeCString());
+        std::fprintf(p_file, "%-11s\n", construct_attr_string(p_entry_ptr));
     };
 
     for_each(m_entries.begin(), m_entries.end(), dump_entry);
 
-    std::printf(
+    std::fprintf(
+        p_file,
         "----------------------------------------------------------"
         "----------------------------------------------------\n");
 }
@@ -114,11 +173,7 @@ void SymbolTable::dump() const {
 // > SymbolManager
 // ===========================================
 void SymbolManager::pushScope() {
-    m_tables.emplace_back(std::make_unique<SymbolTable>());
-}
-
-void SymbolManager::pushScope(SymbolManager::Table p_table) {
-    m_tables.push_back(std::move(p_table));
+    m_tables.emplace_back(std::make_unique<SymbolTable>(m_names));
 }
 
 SymbolManager::Table SymbolManager::popScope() {
@@ -126,7 +181,7 @@ SymbolManager::Table SymbolManager::popScope() {
            "Shouldn't popScope() without pushing any scope");
 
     if (m_opt_dmp) {
-        getCurrentTable()->dump();
+        getCurrentTable()->dump(m_dump_file);
     }
 
     auto table = std::move(m_tables.back());
@@ -144,11 +199,8 @@ SymbolEntry *SymbolManager::addSymbol(const std::string &p_name,
     }
 
     auto &current_table = m_tables.back();
-    auto *entry = current_table->addSymbol(
-        p_name, p_kind, getCurrentLevel(), p_p_type, p_attribute,
-        (getCurrentLevel() > 0) ? m_global_offset : 0);
-    if (getCurrentLevel() > 0) m_global_offset -= 4;
-    return entry;
+    return current_table->addSymbol(p_name, p_kind, getCurrentLevel(),
+                                    p_p_type, p_attribute);
 }
 
 // explicit instantiation
@@ -160,12 +212,22 @@ template SymbolEntry *SymbolManager::addSymbol<FunctionNode::DeclNodes>(
     const FunctionNode::DeclNodes *const);
 
 const SymbolEntry *SymbolManager::lookup(const std::string &p_name) const {
-    for (auto it = m_tables.rbegin(); it != m_tables.rend(); ++it) {
-        if (auto *entry = (*it)->lookup(p_name)) {
-            return entry;
+    // The name is looked up in the pool once; all the tables share it.
+    if (const std::string *const name = m_names->find(p_name)) {
+        for (auto it = m_tables.rbegin(); it != m_tables.rend(); ++it) {
+            if (auto *entry = (*it)->lookup(name)) {
+                return entry;
+            }
         }
     }
-    return nullptr;
+    if (!m_outer_table) {
+        return nullptr;
+    }
+    const std::string *const outer_name =
+        m_outer_table->getNamePool().find(p_name);
+    return outer_name
+               ? m_outer_table->lookup(outer_name, m_num_visible_outer_entries)
+               : nullptr;
 }
 
 const SymbolTable *SymbolManager::getCurrentTable() const {
@@ -176,5 +238,6 @@ const SymbolTable *SymbolManager::getCurrentTable() const {
 }
 
 size_t SymbolManager::getCurrentLevel() const {
-    return m_tables.size() - 1 /* global scope is at level 0 */;
+    // global scope is at level 0
+    return m_outer_table ? m_tables.size() : m_tables.size() - 1;
 }
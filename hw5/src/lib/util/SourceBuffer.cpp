@@ -0,0 +1,102 @@
+#include "util/SourceBuffer.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceBuffer::~SourceBuffer() {
+    if (m_mapped_size) {
+        munmap(m_data, m_mapped_size);
+    }
+}
+
+bool SourceBuffer::open(const char *p_path) {
+    const int fd = ::open(p_path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat status;
+    bool is_read = fstat(fd, &status) == 0;
+    if (is_read) {
+        if (S_ISREG(status.st_mode)) {
+            m_size = static_cast<std::size_t>(status.st_size);
+            is_read = map(fd);
+        } else {
+            is_read = copy(fd);
+        }
+    }
+
+    const int saved_errno = errno;
+    close(fd);
+    errno = saved_errno;
+    return is_read;
+}
+
+bool SourceBuffer::map(const int p_fd) {
+    // The file is mapped over anonymous pages, so the sentinels read as zero
+    // even if the file ends right at a page boundary.
+    const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    m_mapped_size =
+        (m_size + kNumSentinels + page_size - 1) / page_size * page_size;
+    void *const base = mmap(nullptr, m_mapped_size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        m_mapped_size = 0;
+        return false;
+    }
+    m_data = static_cast<char *>(base);
+
+    if (m_size > 0 &&
+        mmap(base, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+             p_fd, 0) == MAP_FAILED) {
+        return false;
+    }
+    return true;
+}
+
+bool SourceBuffer::copy(const int p_fd) {
+    constexpr std::size_t kReadSize = 64 * 1024;
+    for (;;) {
+        m_copy.resize(m_size + kReadSize);
+        const ssize_t num_read =
+            ::read(p_fd, m_copy.data() + m_size, kReadSize);
+        if (num_read < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (num_read == 0) {
+            break;
+        }
+        m_size += static_cast<std::size_t>(num_read);
+    }
+    m_copy.resize(m_size + kNumSentinels, '\0');
+    m_data = m_copy.data();
+    return true;
+}
+
+SourceBuffer::Slice SourceBuffer::getLine(const uint32_t p_line) const {
+    const std::size_t start = m_line_starts[p_line - 1];
+    std::size_t end;
+    if (p_line < m_line_starts.size()) {
+        end = m_line_starts[p_line] - 1;
+    } else {
+        // The newline of the last line seen may not be scanned yet.
+        const auto *const newline = static_cast<const char *>(
+            std::memchr(m_data + start, '\n', m_size - start));
+        end = newline ? static_cast<std::size_t>(newline - m_data) : m_size;
+    }
+    return {m_data + start, end - start};
+}
+
+SourceBuffer::Slice SourceBuffer::getLastLineUpTo(const char *p_end) const {
+    const char *const start = m_data + m_line_starts.back();
+    return {start, static_cast<std::size_t>(p_end - start)};
+}
@@ -0,0 +1,101 @@
+#include "util/WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_is_stopping = true;
+    }
+    m_task_queued.notify_all();
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+}
+
+WorkStealingPool::WorkStealingPool(const std::size_t p_num_threads) {
+    const std::size_t num_threads = std::max<std::size_t>(p_num_threads, 1);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        m_queues.emplace_back(std::make_unique<Queue>());
+    }
+    // The queues are all in place before any thread looks for work.
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        m_threads.emplace_back(&WorkStealingPool::run, this, i);
+    }
+}
+
+void WorkStealingPool::submit(Task p_task) {
+    Queue &queue = *m_queues[m_next_queue];
+    m_next_queue = (m_next_queue + 1) % m_queues.size();
+    // Counted before it is visible, so a worker taking it at once never
+    // decrements the counters below zero.
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ++m_num_queued;
+        ++m_num_pending;
+    }
+    {
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        queue.tasks.emplace_back(std::move(p_task));
+    }
+    m_task_queued.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_all_done.wait(lock, [this] { return m_num_pending == 0; });
+}
+
+bool WorkStealingPool::take(const std::size_t p_index, Task &p_task) {
+    {
+        Queue &own = *m_queues[p_index];
+        std::lock_guard<std::mutex> lock{own.mutex};
+        if (!own.tasks.empty()) {
+            p_task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    for (std::size_t i = 1; i < m_queues.size(); ++i) {
+        Queue &victim = *m_queues[(p_index + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock{victim.mutex};
+        if (!victim.tasks.empty()) {
+            p_task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::run(const std::size_t p_index) {
+    for (;;) {
+        Task task;
+        if (take(p_index, task)) {
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                --m_num_queued;
+            }
+            task();
+            bool is_all_done;
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                is_all_done = --m_num_pending == 0;
+            }
+            if (is_all_done) {
+                m_all_done.notify_all();
+            }
+            continue;
+        }
+
+        // A task counted as queued may be taken by another thread in between;
+        // then the next look simply comes back empty.
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_task_queued.wait(
+            lock, [this] { return m_is_stopping || m_num_queued > 0; });
+        if (m_is_stopping && m_num_queued == 0) {
+            return;
+        }
+    }
+}
@@ -1,4 +1,5 @@
 %{
+#include "AST/AstArena.hpp"
 #include "AST/BinaryOperator.hpp"
 #include "AST/CompoundStatement.hpp"
 #include "AST/ConstantValue.hpp"
@@ -19,51 +20,59 @@
 #include "AST/variable.hpp"
 #include "AST/while.hpp"
 
-#include "codegen/CodeGenerator.hpp"
-#include "sema/SemanticAnalyzer.hpp"
+#include "codegen/CodeGenOptions.hpp"
 
 #include "AST/constant.hpp"
 #include "AST/operator.hpp"
 
-#include "AST/AstDumper.hpp"
+#include "AST/PTypeContext.hpp"
 
+#include "driver/CompilationContext.hpp"
+#include "driver/Driver.hpp"
+
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
 
-#define YYLTYPE yyltype
-
-typedef struct YYLTYPE {
-    uint32_t first_line;
-    uint32_t first_column;
-    uint32_t last_line;
-    uint32_t last_column;
-} yyltype;
-
-extern int32_t line_num;    /* declared in scanner.l */
-extern char current_line[]; /* declared in scanner.l */
-extern uint32_t opt_dmp;    /* declared in scanner.l */
-extern FILE *yyin;          /* declared by lex */
-extern char *yytext;        /* declared by lex */
-
-static AstNode *root;
-
-extern "C" int yylex(void);
-static void yyerror(const char *msg);
-extern int yylex_destroy(void);
 %}
 
 // This guarantees that headers do not conflict when included together.
 %define api.token.prefix {TOK_}
 
+// Both the scanner and the parser keep their state in the compilation
+// context instead of globals, so that files can be compiled concurrently.
+%define api.pure full
+%lex-param {yyscan_t scanner}
+%parse-param {yyscan_t scanner} {CompilationContext &context}
+
 %code requires {
+    #include "AST/AstArena.hpp"
     #include "AST/utils.hpp"
     #include "AST/PType.hpp"
 
+    #include <cstdint>
     #include <vector>
     #include <memory>
 
+    #define YYLTYPE yyltype
+
+    typedef struct YYLTYPE {
+        uint32_t first_line;
+        uint32_t first_column;
+        uint32_t last_line;
+        uint32_t last_column;
+    } yyltype;
+
+    /* declared by lex */
+    typedef void *yyscan_t;
+
+    class CompilationContext;
+
     class AstNode;
     class DeclNode;
     class ConstantValueNode;
@@ -84,21 +93,30 @@ extern int yylex_destroy(void);
     int32_t sign;
 
     AstNode *node;
-    PType *type_ptr;
+    const PType *type_ptr;
     DeclNode *decl_ptr;
     CompoundStatementNode *compound_stmt_ptr;
     ConstantValueNode *constant_value_node_ptr;
     FunctionNode *func_ptr;
     ExpressionNode *expr_ptr;
 
-    std::vector<std::unique_ptr<DeclNode>> *decls_ptr;
+    AstVector<std::unique_ptr<DeclNode>> *decls_ptr;
     std::vector<IdInfo> *ids_ptr;
     std::vector<uint64_t> *dimensions_ptr;
-    std::vector<std::unique_ptr<FunctionNode>> *funcs_ptr;
-    std::vector<std::unique_ptr<AstNode>> *nodes_ptr;
-    std::vector<std::unique_ptr<ExpressionNode>> *exprs_ptr;
+    AstVector<std::unique_ptr<FunctionNode>> *funcs_ptr;
+    AstVector<std::unique_ptr<AstNode>> *nodes_ptr;
+    AstVector<std::unique_ptr<ExpressionNode>> *exprs_ptr;
 };
 
+%code {
+    /* defined by lex */
+    int yylex(YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t scanner);
+    char *yyget_text(yyscan_t scanner);
+
+    static void yyerror(YYLTYPE *yylloc, yyscan_t scanner,
+                        CompilationContext &context, const char *msg);
+}
+
 %type <identifier> ProgramName ID FunctionName
 %type <integer> INT_LITERAL
 %type <real> REAL_LITERAL
@@ -162,9 +180,9 @@ Program:
     DeclarationList FunctionList CompoundStatement
     /* End of ProgramBody */
     END {
-        root = new ProgramNode(@1.first_line, @1.first_column,
-                               $1, new PType(PType::PrimitiveTypeEnum::kVoidType),
-                               *$3, *$4, $5);
+        context.setRoot(new ProgramNode(@1.first_line, @1.first_column,
+                               $1, context.getTypeContext().getType(PType::PrimitiveTypeEnum::kVoidType),
+                               *$3, *$4, $5));
 
         free($1);
         delete $3;
@@ -178,7 +196,7 @@ ProgramName:
 
 DeclarationList:
     Epsilon {
-        $$ = new std::vector<std::unique_ptr<DeclNode>>();
+        $$ = new AstVector<std::unique_ptr<DeclNode>>();
     }
     |
     Declarations
@@ -186,7 +204,7 @@ DeclarationList:
 
 Declarations:
     Declaration {
-        $$ = new std::vector<std::unique_ptr<DeclNode>>();
+        $$ = new AstVector<std::unique_ptr<DeclNode>>();
         $$->emplace_back($1);
     }
     |
@@ -198,7 +216,7 @@ Declarations:
 
 FunctionList:
     Epsilon {
-        $$ = new std::vector<std::unique_ptr<FunctionNode>>();
+        $$ = new AstVector<std::unique_ptr<FunctionNode>>();
     }
     |
     Functions
@@ -206,7 +224,7 @@ FunctionList:
 
 Functions:
     Function {
-        $$ = new std::vector<std::unique_ptr<FunctionNode>>();
+        $$ = new AstVector<std::unique_ptr<FunctionNode>>();
         $$->emplace_back($1);
     }
     |
@@ -246,7 +264,7 @@ FunctionName:
 
 FormalArgList:
     Epsilon {
-        $$ = new std::vector<std::unique_ptr<DeclNode>>();
+        $$ = new AstVector<std::unique_ptr<DeclNode>>();
     }
     |
     FormalArgs
@@ -254,7 +272,7 @@ FormalArgList:
 
 FormalArgs:
     FormalArg {
-        $$ = new std::vector<std::unique_ptr<DeclNode>>();
+        $$ = new AstVector<std::unique_ptr<DeclNode>>();
         $$->emplace_back($1);
     }
     |
@@ -291,7 +309,7 @@ ReturnType:
     }
     |
     Epsilon {
-        $$ = new PType(PType::PrimitiveTypeEnum::kVoidType);
+        $$ = context.getTypeContext().getType(PType::PrimitiveTypeEnum::kVoidType);
     }
 ;
 
@@ -317,22 +335,21 @@ Type:
     ArrType
 ;
 
-    /* no need to release PType object since it'll be assigned to the shared_ptr */
+    /* the types are owned by the type context */
 ScalarType:
-    INTEGER { $$ = new PType(PType::PrimitiveTypeEnum::kIntegerType); }
+    INTEGER { $$ = context.getTypeContext().getType(PType::PrimitiveTypeEnum::kIntegerType); }
     |
-    REAL { $$ = new PType(PType::PrimitiveTypeEnum::kRealType); }
+    REAL { $$ = context.getTypeContext().getType(PType::PrimitiveTypeEnum::kRealType); }
     |
-    STRING { $$ = new PType(PType::PrimitiveTypeEnum::kStringType); }
+    STRING { $$ = context.getTypeContext().getType(PType::PrimitiveTypeEnum::kStringType); }
     |
-    BOOLEAN { $$ = new PType(PType::PrimitiveTypeEnum::kBoolType); }
+    BOOLEAN { $$ = context.getTypeContext().getType(PType::PrimitiveTypeEnum::kBoolType); }
 ;
 
 ArrType:
     ArrDecl ScalarType {
-        $2->setDimensions(*$1);
+        $$ = context.getTypeContext().getType($2->getPrimitiveType(), *$1);
         delete $1;
-        $$ = $2;
     }
 ;
 
@@ -352,8 +369,7 @@ LiteralConstant:
         Constant::ConstantValue value;
         value.integer = static_cast<int64_t>($1) * static_cast<int64_t>($2);
         auto * const constant = new Constant(
-            std::make_shared<PType>(
-				PType::PrimitiveTypeEnum::kIntegerType),
+            context.getTypeContext().getType(PType::PrimitiveTypeEnum::kIntegerType),
             value);
         auto * const pos = ($1 == 1) ? &@2 : &@1;
         // no need to release constant object since it'll be assigned to the unique_ptr
@@ -364,8 +380,7 @@ LiteralConstant:
         Constant::ConstantValue value;
         value.real = static_cast<double>($1) * static_cast<double>($2);
         auto * const constant = new Constant(
-            std::make_shared<PType>(
-                PType::PrimitiveTypeEnum::kRealType),
+            context.getTypeContext().getType(PType::PrimitiveTypeEnum::kRealType),
             value);
         auto * const pos = ($1 == 1) ? &@2 : &@1;
         // no need to release constant object since it'll be assigned to the unique_ptr
@@ -390,18 +405,17 @@ StringAndBoolean:
         Constant::ConstantValue value;
         value.string = $1;
         auto * const constant = new Constant(
-            std::make_shared<PType>(
-                PType::PrimitiveTypeEnum::kStringType),
+            context.getTypeContext().getType(PType::PrimitiveTypeEnum::kStringType),
             value);
         $$ = new ConstantValueNode(@1.first_line, @1.first_column, constant);
+        free($1);
     }
     |
     TRUE {
         Constant::ConstantValue value;
         value.boolean = $1;
         auto * const constant = new Constant(
-            std::make_shared<PType>(
-                PType::PrimitiveTypeEnum::kBoolType),
+            context.getTypeContext().getType(PType::PrimitiveTypeEnum::kBoolType),
             value);
         $$ = new ConstantValueNode(@1.first_line, @1.first_column, constant);
     }
@@ -410,8 +424,7 @@ StringAndBoolean:
         Constant::ConstantValue value;
         value.boolean = $1;
         auto * const constant = new Constant(
-            std::make_shared<PType>(
-                PType::PrimitiveTypeEnum::kBoolType),
+            context.getTypeContext().getType(PType::PrimitiveTypeEnum::kBoolType),
             value);
         $$ = new ConstantValueNode(@1.first_line, @1.first_column, constant);
     }
@@ -422,8 +435,7 @@ IntegerAndReal:
         Constant::ConstantValue value;
         value.integer = static_cast<int64_t>($1);
         auto * const constant = new Constant(
-            std::make_shared<PType>(
-				PType::PrimitiveTypeEnum::kIntegerType),
+            context.getTypeContext().getType(PType::PrimitiveTypeEnum::kIntegerType),
             value);
         // no need to release constant object since it'll be assigned to the unique_ptr
         $$ = new ConstantValueNode(@1.first_line, @1.first_column, constant);
@@ -433,8 +445,7 @@ IntegerAndReal:
         Constant::ConstantValue value;
         value.real = static_cast<double>($1);
         auto * const constant = new Constant(
-            std::make_shared<PType>(
-                PType::PrimitiveTypeEnum::kRealType),
+            context.getTypeContext().getType(PType::PrimitiveTypeEnum::kRealType),
             value);
         // no need to release constant object since it'll be assigned to the unique_ptr
         $$ = new ConstantValueNode(@1.first_line, @1.first_column, constant);
@@ -501,7 +512,7 @@ VariableReference:
 
 ArrRefList:
     Epsilon {
-        $$ = new std::vector<std::unique_ptr<ExpressionNode>>();
+        $$ = new AstVector<std::unique_ptr<ExpressionNode>>();
     }
     |
     ArrRefs
@@ -509,7 +520,7 @@ ArrRefList:
 
 ArrRefs:
     L_BRACKET Expression R_BRACKET {
-        $$ = new std::vector<std::unique_ptr<ExpressionNode>>();
+        $$ = new AstVector<std::unique_ptr<ExpressionNode>>();
         $$->emplace_back($2);
     }
     |
@@ -558,14 +569,14 @@ For:
         // DeclNode
         auto *ids = new std::vector<IdInfo>{IdInfo(@2.first_line, @2.first_column,
                                                    $2)};
-        auto *type = new PType(PType::PrimitiveTypeEnum::kIntegerType);
+        auto *type = context.getTypeContext().getType(PType::PrimitiveTypeEnum::kIntegerType);
         auto *var_decl = new DeclNode(@2.first_line, @2.first_column, ids, type);
 
         // AssignmentNode
         auto *var_ref = new VariableReferenceNode(@2.first_line, @2.first_column, $2);
         value.integer = static_cast<int64_t>($4);
         constant = new Constant(
-            std::make_shared<PType>(PType::PrimitiveTypeEnum::kIntegerType),
+            context.getTypeContext().getType(PType::PrimitiveTypeEnum::kIntegerType),
             value);
         constant_value_node = new ConstantValueNode(@4.first_line, @4.first_column,
                                                     constant);
@@ -575,7 +586,7 @@ For:
         // ExpressionNode
         value.integer = static_cast<int64_t>($6);
         constant = new Constant(
-            std::make_shared<PType>(PType::PrimitiveTypeEnum::kIntegerType),
+            context.getTypeContext().getType(PType::PrimitiveTypeEnum::kIntegerType),
             value);
         constant_value_node = new ConstantValueNode(@6.first_line, @6.first_column,
                                                     constant);
@@ -610,7 +621,7 @@ FunctionInvocation:
 
 ExpressionList:
     Epsilon {
-        $$ = new std::vector<std::unique_ptr<ExpressionNode>>();
+        $$ = new AstVector<std::unique_ptr<ExpressionNode>>();
     }
     |
     Expressions
@@ -618,7 +629,7 @@ ExpressionList:
 
 Expressions:
     Expression {
-        $$ = new std::vector<std::unique_ptr<ExpressionNode>>();
+        $$ = new AstVector<std::unique_ptr<ExpressionNode>>();
         $$->emplace_back($1);
     }
     |
@@ -630,7 +641,7 @@ Expressions:
 
 StatementList:
     Epsilon {
-        $$ = new std::vector<std::unique_ptr<AstNode>>();
+        $$ = new AstVector<std::unique_ptr<AstNode>>();
     }
     |
     Statements
@@ -638,7 +649,7 @@ StatementList:
 
 Statements:
     Statement {
-        $$ = new std::vector<std::unique_ptr<AstNode>>();
+        $$ = new AstVector<std::unique_ptr<AstNode>>();
         $$->emplace_back($1);
     }
     |
@@ -747,56 +758,189 @@ Epsilon:
 
 %%
 
-void yyerror(const char *msg) {
-    fprintf(stderr,
+void yyerror(YYLTYPE *yylloc, yyscan_t scanner, CompilationContext &context,
+             const char *msg) {
+    // The scanner has reported the bad character that ended the input.
+    if (context.getScannerState().has_lexical_error) {
+        return;
+    }
+    // The line up to the unmatched token, which is scanned in place.
+    const char *const yytext = yyget_text(scanner);
+    const auto line =
+        context.getSource().getLastLineUpTo(yytext + strlen(yytext));
+    fprintf(context.getDiagnosticFile(),
             "\n"
             "|-----------------------------------------------------------------"
             "---------\n"
-            "| Error found in Line #%d: %s\n"
+            "| Error found in Line #%d: %.*s\n"
             "|\n"
             "| Unmatched token: %s\n"
             "|-----------------------------------------------------------------"
             "---------\n",
-            line_num, current_line, yytext);
-    exit(-1);
+            context.getScannerState().line_num, static_cast<int>(line.length),
+            line.data, yytext);
 }
 
 int main(int argc, const char *argv[]) {
-    if (argc < 2) {
-        fprintf(stderr, "Usage: %s <filename> --save-path [save path]\n", argv[0]);
-        exit(-1);
-    }
-
-    yyin = fopen(argv[1], "r");
-    if (yyin == NULL) {
-        perror("fopen() failed");
+    std::vector<std::string> source_files;
+    std::size_t num_jobs = std::thread::hardware_concurrency();
+    Driver::Options options;
+    bool no_fold = false;
+    bool no_inline = false;
+    int inline_threshold = -1;
+    bool no_dce = false;
+    bool no_regalloc = false;
+    bool no_counted_loops = false;
+    bool no_unroll = false;
+    int unroll_full_limit = -1;
+    int unroll_factor = -1;
+    int unroll_budget = -1;
+    bool no_loop_rotation = false;
+    bool no_licm = false;
+    bool no_tail_calls = false;
+    bool no_ssa = false;
+    bool no_peephole = false;
+    bool is_usage_error = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--dump-ast") == 0) {
+            options.dump_ast = true;
+        } else if ((strcmp(argv[i], "--save-path") == 0 ||
+                    strcmp(argv[i], "--save_path") == 0) &&
+                   i + 1 < argc) {
+            options.save_path = argv[++i];
+        } else if (strcmp(argv[i], "--dump-ir") == 0) {
+            options.dump_ir = true;
+        } else if (strcmp(argv[i], "--ir-codegen") == 0) {
+            options.ir_codegen = true;
+        } else if (strcmp(argv[i], "-O0") == 0) {
+            options.codegen = CodeGenOptions::fromLevel(0);
+        } else if (strcmp(argv[i], "-O1") == 0) {
+            options.codegen = CodeGenOptions::fromLevel(1);
+        } else if (strcmp(argv[i], "--no-fold") == 0) {
+            no_fold = true;
+        } else if (strcmp(argv[i], "--no-inline") == 0) {
+            no_inline = true;
+        } else if (strcmp(argv[i], "--inline-threshold") == 0 &&
+                   i + 1 < argc && atoi(argv[i + 1]) >= 0) {
+            inline_threshold = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--no-dce") == 0) {
+            no_dce = true;
+        } else if (strcmp(argv[i], "--no-regalloc") == 0) {
+            no_regalloc = true;
+        } else if (strcmp(argv[i], "--no-counted-loops") == 0) {
+            no_counted_loops = true;
+        } else if (strcmp(argv[i], "--no-unroll") == 0) {
+            no_unroll = true;
+        } else if (strcmp(argv[i], "--unroll-full") == 0 && i + 1 < argc &&
+                   atoi(argv[i + 1]) >= 0) {
+            unroll_full_limit = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--unroll-factor") == 0 && i + 1 < argc &&
+                   atoi(argv[i + 1]) > 0) {
+            unroll_factor = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--unroll-budget") == 0 && i + 1 < argc &&
+                   atoi(argv[i + 1]) >= 0) {
+            unroll_budget = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--no-loop-rotation") == 0) {
+            no_loop_rotation = true;
+        } else if (strcmp(argv[i], "--no-licm") == 0) {
+            no_licm = true;
+        } else if (strcmp(argv[i], "--no-tail-calls") == 0) {
+            no_tail_calls = true;
+        } else if (strcmp(argv[i], "--no-ssa") == 0) {
+            no_ssa = true;
+        } else if (strcmp(argv[i], "--no-peephole") == 0) {
+            no_peephole = true;
+        } else if (strcmp(argv[i], "--ast-stats") == 0) {
+            options.ast_stats = true;
+        } else if (strcmp(argv[i], "--peephole-stats") == 0) {
+            options.peephole_stats = true;
+        } else if (strcmp(argv[i], "--dce-report") == 0) {
+            options.dce_report = true;
+        } else if (strcmp(argv[i], "--inline-report") == 0) {
+            options.inline_report = true;
+        } else if ((strcmp(argv[i], "-j") == 0 ||
+                    strcmp(argv[i], "--jobs") == 0) &&
+                   i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            num_jobs = static_cast<std::size_t>(atoi(argv[++i]));
+        } else if (argv[i][0] != '-') {
+            source_files.emplace_back(argv[i]);
+        } else {
+            is_usage_error = true;
+            break;
+        }
+    }
+    if (no_fold) {
+        options.codegen.fold_constants = false;
+    }
+    if (no_inline) {
+        options.codegen.inline_functions = false;
+    }
+    if (inline_threshold >= 0) {
+        options.codegen.inline_threshold = inline_threshold;
+    }
+    if (no_dce) {
+        options.codegen.eliminate_dead_code = false;
+    }
+    if (no_regalloc) {
+        options.codegen.allocate_registers = false;
+    }
+    if (no_counted_loops) {
+        options.codegen.count_loops = false;
+    }
+    if (no_unroll) {
+        options.codegen.unroll_loops = false;
+    }
+    if (unroll_full_limit >= 0) {
+        options.codegen.unroll_full_limit = unroll_full_limit;
+    }
+    if (unroll_factor > 0) {
+        options.codegen.unroll_factor = unroll_factor;
+    }
+    if (unroll_budget >= 0) {
+        options.codegen.unroll_budget = unroll_budget;
+    }
+    if (no_loop_rotation) {
+        options.codegen.rotate_loops = false;
+    }
+    if (no_licm) {
+        options.codegen.hoist_invariants = false;
+    }
+    if (no_tail_calls) {
+        options.codegen.eliminate_tail_calls = false;
+    }
+    if (no_ssa) {
+        options.codegen.build_ssa = false;
+    }
+    if (no_peephole) {
+        options.codegen.peephole = false;
+    }
+    // The threads go to the files of a batch, or else to the functions of
+    // the one file.
+    if (source_files.size() == 1) {
+        options.num_threads = num_jobs;
+    }
+    if (is_usage_error || source_files.empty()) {
+        fprintf(stderr,
+                "Usage: %s <filename>... [--save-path <save path>] "
+                "[-j <jobs>] [--dump-ast] [--dump-ir] [--ir-codegen] "
+                "[-O0|-O1] [--no-fold] [--no-inline] "
+                "[--inline-threshold <n>] [--no-dce] [--no-regalloc] "
+                "[--no-counted-loops] [--no-unroll] [--unroll-full <n>] "
+                "[--unroll-factor <n>] [--unroll-budget <n>] "
+                "[--no-loop-rotation] [--no-licm] [--no-tail-calls] "
+                "[--no-ssa] [--no-peephole] "
+                "[--ast-stats] [--peephole-stats] [--dce-report] "
+                "[--inline-report]\n",
+                argv[0]);
         exit(-1);
     }
 
-    yyparse();
-
-    if (argc >= 3 && strcmp(argv[2], "--dump-ast") == 0) {
-        AstDumper ast_dumper;
-        root->accept(ast_dumper);
-    }
-
-    SemanticAnalyzer sema_analyzer(opt_dmp);
-    root->accept(sema_analyzer);
-
-    CodeGenerator code_generator(
-        argv[1], (argc == 4) ? argv[3] : "",
-        std::move(sema_analyzer.acquireSymbolTableOfScopingNodes()));
-    root->accept(code_generator);
-
-    if (!sema_analyzer.hasError()) {
-        printf("\n"
-               "|---------------------------------------------------|\n"
-               "|  There is no syntactic error and semantic error!  |\n"
-               "|---------------------------------------------------|\n");
+    const Driver driver(options);
+    // A single file is compiled right on this thread, straight to the
+    // standard streams.
+    if (source_files.size() == 1) {
+        return driver.compile(source_files.front(), stdout, stderr);
     }
-
-    delete root;
-    fclose(yyin);
-    yylex_destroy();
-    return 0;
+    return driver.compileAll(source_files, num_jobs);
 }
@@ -2,9 +2,10 @@
 
 import argparse
 import colorama
+import re
 import subprocess
 import sys
-from dataclasses import dataclass
+from dataclasses import dataclass, field
 from enum import Enum, auto
 from pathlib import Path
 from typing import Dict, List
@@ -29,15 +30,30 @@ class TestCase:
     type: CaseType
     score: float
     name: str
+    # Extra flags for the compiler, patterns that lines of its output (such
+    # as the optimization reports) have to match, and patterns that the
+    # generated assembly has to contain or must not contain.
+    flags: List[str] = field(default_factory=list)
+    report: List[str] = field(default_factory=list)
+    asm: List[str] = field(default_factory=list)
+    no_asm: List[str] = field(default_factory=list)
 
 
 class Grader:
     """
-    case_id: TestCase(case_type, score, case_name)
+    case_id: TestCase(case_type, score, case_name[, flags=..., report=...,
+                                                  asm=..., no_asm=...])
         case_id     Used by the "--case_id" flag to run only one test case
         case_type   The diff of CaseType.HIDDEN is not shown
         score       The max score of the test case
         case_name   The name of the file in "test_cases" and "sample_solutions"
+        flags       Extra flags for the compiler
+        report      Regular expressions, each of which has to match a line of
+                    the compiler output
+        asm         Regular expressions, each of which has to be found in the
+                    generated assembly (in multiline mode)
+        no_asm      Regular expressions, none of which may be found in the
+                    generated assembly (in multiline mode)
     """
     CASES: Dict[str, TestCase] = {
         "1": TestCase(CaseType.OPEN, 5.0, "01_variable_constant"),
@@ -60,6 +76,52 @@ class Grader:
         "18": TestCase(CaseType.BONUS, 1.5, "18_bonus_string"),
         "19": TestCase(CaseType.BONUS, 1.5, "19_bonus_real_1"),
         "20": TestCase(CaseType.BONUS, 1.5, "20_bonus_real_2"),
+        "21": TestCase(CaseType.OPEN, 0.0, "21_expr_register"),
+        "22": TestCase(CaseType.OPEN, 0.0, "22_register_alloc"),
+        "23": TestCase(CaseType.OPEN, 0.0, "23_long_source"),
+        "24": TestCase(CaseType.OPEN, 0.0, "24_peephole",
+                       flags=["--peephole-stats"],
+                       report=[r"peephole: +[1-9][0-9]* forwarded stores"]),
+        "25": TestCase(CaseType.OPEN, 0.0, "25_frame_layout",
+                       asm=[r"^small:\n    addi sp, sp, -32$",
+                            r"^wide:\n(?:.*\n){3}    li ra, 2416\n    sub sp, sp, ra\b"],
+                       no_asm=[r"-(?:20(?:49|[5-9][0-9])|2[1-9][0-9]{2}|[3-9][0-9]{3}|[0-9]{5,})\(s0\)"]),
+        "26": TestCase(CaseType.OPEN, 0.0, "26_stack_slot_sharing",
+                       asm=[r"^depth:\n    addi sp, sp, -32$",
+                            r"^    sw t0, (-[0-9]+)\(s0\) +# a = expr\n(?:.*\n)*?    sw t0, \1\(s0\) +# b = expr$",
+                            r"^    sw t0, (-[0-9]+)\(s0\) +# z = expr\n(?:.*\n)*?    sw t0, \1\(s0\) +# w = expr$"]),
+        "27": TestCase(CaseType.OPEN, 0.0, "27_constant_folding"),
+        "28": TestCase(CaseType.OPEN, 0.0, "28_dead_code",
+                       flags=["--dce-report"],
+                       report=[r"dce: overwrite +[0-9]+ instructions, 3 unreachable statements, 4 dead stores, 3 unused locals",
+                               r"dce: search +[0-9]+ instructions, 2 unreachable statements",
+                               r"dce: loop +[0-9]+ instructions, 0 unreachable statements, 1 dead stores"]),
+        "29": TestCase(CaseType.OPEN, 0.0, "29_counted_loop",
+                       asm=[r"^    li (t[0-9]), 5000\n(\.Lmain\.[0-9]+):\n(?:    .*\n)+?    blt s[0-9]+, \1, \2$"],
+                       no_asm=[r"^    bge "]),
+        "30": TestCase(CaseType.OPEN, 0.0, "30_loop_rotation",
+                       asm=[r"^(\.Lmain\.[0-9]+):\n(?:    .*\n)+?    blt s[0-9]+, t[0-9], \1$",
+                            r"^(\.Lmain\.[0-9]+):\n(?:    .*\n)+?    beqz s[0-9]+, \1$",
+                            r"^(\.Lmain\.[0-9]+):\n(?:    .*\n)+?    bnez t[0-9], \1$"],
+                       no_asm=[r"^    j \.Lmain\.[0-9]+$"]),
+        "31": TestCase(CaseType.OPEN, 0.0, "31_loop_invariants",
+                       asm=[r"^weigh:\n(?:.*\n)*?    lw (t[0-9]), 0\(\1\) +# load the value of scale\n    mul s[0-9]+, \1, s[0-9]+ +# hoist the loop invariant$",
+                            r"^    add (t[0-9]), s[0-9]+, s[0-9]+\n    mul s[0-9]+, \1, s[0-9]+ +# hoist the loop invariant$"],
+                       no_asm=[r"^weigh:\n(?:(?!    \.size).*\n)*?.*# load the value of scale\n(?:(?!    \.size).*\n)*?.*# load the value of scale$",
+                               r"^main:\n(?:(?!    \.size).*\n)*?.*# hoist the loop invariant$"]),
+        "32": TestCase(CaseType.OPEN, 0.0, "32_loop_unrolling",
+                       asm=[r"^    li (s[0-9]+), 2\n    mv a0, \1\n    jal ra, printInt .*\n(?:    addi \1, \1, 1\n    mv a0, \1\n    jal ra, printInt .*\n){3}",
+                            r"^(\.Lmain\.[0-9]+):\n(?:(?:    (?!blt |.*# sum = expr).*\n)*    .*# sum = expr\n){2,}(?:    (?!blt |.*# sum = expr).*\n)*    blt s[0-9]+, t[0-9], \1$",
+                            r"^(\.Lmain\.[0-9]+):\n(?:(?:    (?!blt |.*# weighted = expr).*\n)*    .*# weighted = expr\n){12}(?:    (?!blt |.*# weighted = expr).*\n)*    blt s[0-9]+, t[0-9], \1$"]),
+        "33": TestCase(CaseType.OPEN, 0.0, "33_function_inlining",
+                       flags=["--inline-report"],
+                       report=[r"inline: main +74:14 +sum +inlined",
+                               r"inline: main +81:21 +bump +not inlined: writes a global read before the call",
+                               r"inline: main +85:11 +fact +not inlined: recursive"]),
+        "34": TestCase(CaseType.OPEN, 0.0, "34_tail_calls",
+                       asm=[r"^viasum:\n(?:(?!    \.size).*\n)*?    j sumto +# tail call function `sumto`$",
+                            r"^twice:\n(?:(?!    \.size).*\n)*?    jal ra, sumto$"],
+                       no_asm=[r"^(\w+):\n(?:(?!    \.size).*\n)*?    jal ra, \1$"]),
         "h1": TestCase(CaseType.HIDDEN, 5.0, "h01_variable_constant"),
         "h2": TestCase(CaseType.HIDDEN, 5.0, "h02_expr"),
         "h3": TestCase(CaseType.HIDDEN, 5.0, "h03_function"),
@@ -162,13 +224,22 @@ class Grader:
             return TestStatus.SKIP
 
         # Compile to risc-v
-        compile_command: List[str] = [str(self.executable), str(case_path), "--save-path", str(self.asm_dir)]
+        compile_command: List[str] = [str(self.executable), str(case_path), "--save-path", str(self.asm_dir)] + case.flags
         compile_stdout: bytes
         compile_stderr: bytes
         _, compile_stdout, compile_stderr = self.execute_process(compile_command)
         with compiler_output_path.open("wb") as file:
             file.write(compile_stdout)
             file.write(compile_stderr)
+        compiler_output_lines: List[str] = (compile_stdout + compile_stderr).decode("utf-8", errors="replace").splitlines()
+        missing_report: List[str] = [pattern for pattern in case.report
+                                     if not any(re.match(pattern, line) for line in compiler_output_lines)]
+        asm_text: str = asm_path.read_text(errors="replace") if asm_path.exists() else ""
+        missing_asm: List[str] = [pattern for pattern in case.asm
+                                  if not re.search(pattern, asm_text, re.MULTILINE)]
+        unexpected_asm: List[str] = [pattern for pattern in case.no_asm
+                                     if re.search(pattern, asm_text, re.MULTILINE)]
+        failed_checks: bool = bool(missing_report or missing_asm or unexpected_asm)
 
         # Assemble to executable
         assemble_command: List[str] = ["riscv32-unknown-elf-gcc", str(asm_path), str(self.io_file_path), "-o", str(executable_path)]
@@ -194,15 +265,24 @@ class Grader:
         diff_stdout: bytes
         diff_exit_code, diff_stdout, _ = self.execute_process(diff_command)
         diff_result: str = diff_stdout.decode("utf-8", errors="replace")
-        if diff_exit_code != 0:
+        if diff_exit_code != 0 or failed_checks:
             # The header part.
             self.diff_result += f"{case.name}\n"
             # The diff part.
             if case.type == CaseType.HIDDEN:
                 self.diff_result += "// Diff of hidden cases is not shown.\n"
             else:
-                self.diff_result += f"{diff_result}\n"
-        return TestStatus.PASS if diff_exit_code == 0 else TestStatus.FAIL
+                if diff_exit_code != 0:
+                    self.diff_result += f"{diff_result}\n"
+                for pattern in missing_report:
+                    self.diff_result += f"No line of the compiler output matches: {pattern}\n"
+                for pattern in missing_asm:
+                    self.diff_result += f"The generated assembly does not contain: {pattern}\n"
+                for pattern in unexpected_asm:
+                    self.diff_result += f"The generated assembly contains: {pattern}\n"
+                if failed_checks:
+                    self.diff_result += "\n"
+        return TestStatus.PASS if diff_exit_code == 0 and not failed_checks else TestStatus.FAIL
 
     def run(self) -> int:
         total_score: float = 0
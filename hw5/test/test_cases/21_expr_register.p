@@ -0,0 +1,65 @@
+//&S-
+//&T-
+//&D-
+
+exprRegister;
+
+var g: integer;
+var k: 3;
+
+inc(x: integer): integer
+begin
+	g := g + x;
+	return g;
+end
+end
+
+sum(a, b: integer): integer
+begin
+	return a + b;
+end
+end
+
+mul3(a, b, c: integer): integer
+begin
+	var r: integer;
+	r := a * b * c;
+	return r;
+end
+end
+
+sum11(a,b,c,d,e,f,gg,h,i,j,kk: integer): integer
+begin
+	return a + b * 2 + c * 3 + d * 4 + e * 5 + f * 6 + gg * 7 + h * 8 + i * 9 + j * 10 + kk * 11;
+end
+end
+
+noop(x: integer)
+begin
+	g := x;
+end
+end
+
+begin
+
+var a, b: integer;
+g := 1;
+a := 2;
+b := 3;
+
+// Operands around a call must be evaluated from left to right.
+print g + inc(5);
+print inc(1) + g;
+
+// Live values are saved across the calls.
+print (a * (b + (a * (b + sum(a, inc(2)))))) - (mul3(a, sum(b, k), inc(a)) * (b + a));
+print sum11(1, sum(a, b), 3, mul3(1, 2, 3), 5, 6, inc(1), 8, 9, sum(sum(1,2), sum(3,4)), 11);
+print sum(sum(sum(1, 2), sum(3, 4)), sum(sum(5, 6), sum(7, 8)));
+
+noop(a + b * k);
+print g;
+print -(a - b) * -k;
+print (a + b) / (b - a + 1) mod 2;
+
+end
+end
@@ -0,0 +1,86 @@
+//&S-
+//&T-
+//&D-
+
+regAlloc;
+
+var g: integer;
+
+// Returns from the middle of a loop.
+firstMultiple(n, m: integer): integer
+begin
+	var i: integer;
+	i := 1;
+	while i < 100 do
+	begin
+		if i mod m = 0 then
+		begin
+			if i > n then
+			begin
+				return i;
+			end
+			end if
+		end
+		end if
+		i := i + 1;
+	end
+	end do
+	return 0;
+end
+end
+
+// Each activation keeps its own values in the same registers.
+fib(n: integer): integer
+begin
+	var a, b: integer;
+	if n < 2 then
+	begin
+		return n;
+	end
+	end if
+	a := fib(n - 1);
+	b := fib(n - 2);
+	return a + b;
+end
+end
+
+begin
+
+var a, b, c, d, e, f, h, i, j, k, l, m, n: integer;
+var x, y, t, cnt: integer;
+var total: integer;
+
+// More variables than registers; the cold ones stay in memory.
+a := 1; b := 2; c := 3; d := 4; e := 5; f := 6; h := 7;
+i := 8; j := 9; k := 10; l := 11; m := 12; n := 13;
+total := 0;
+for r := 1 to 6 do
+begin
+	total := total + a + b + c + d + e + f + h + i + j + k + l + m + n;
+	a := a + r;
+	n := n - fib(r);
+end
+end do
+print total;
+print a + n;
+
+// The values are carried around the back edge.
+x := 0;
+y := 1;
+cnt := 0;
+while cnt < 10 do
+begin
+	t := x + y;
+	x := y;
+	y := t;
+	cnt := cnt + 1;
+end
+end do
+print x;
+
+g := firstMultiple(20, 7) + firstMultiple(3, 5);
+print g;
+print fib(12);
+
+end
+end
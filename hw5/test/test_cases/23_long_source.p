@@ -0,0 +1,619 @@
+//&S-
+//&T-
+//&D-
+
+longSource;
+
+// Longer than 200 lines, with a line longer than 512 characters.
+
+var total: integer;
+
+f0(x: integer): integer
+begin
+    return x + 0;
+end
+end
+f1(x: integer): integer
+begin
+    return x + 1;
+end
+end
+f2(x: integer): integer
+begin
+    return x + 2;
+end
+end
+f3(x: integer): integer
+begin
+    return x + 3;
+end
+end
+f4(x: integer): integer
+begin
+    return x + 4;
+end
+end
+f5(x: integer): integer
+begin
+    return x + 5;
+end
+end
+f6(x: integer): integer
+begin
+    return x + 6;
+end
+end
+f7(x: integer): integer
+begin
+    return x + 7;
+end
+end
+f8(x: integer): integer
+begin
+    return x + 8;
+end
+end
+f9(x: integer): integer
+begin
+    return x + 9;
+end
+end
+f10(x: integer): integer
+begin
+    return x + 10;
+end
+end
+f11(x: integer): integer
+begin
+    return x + 11;
+end
+end
+f12(x: integer): integer
+begin
+    return x + 12;
+end
+end
+f13(x: integer): integer
+begin
+    return x + 13;
+end
+end
+f14(x: integer): integer
+begin
+    return x + 14;
+end
+end
+f15(x: integer): integer
+begin
+    return x + 15;
+end
+end
+f16(x: integer): integer
+begin
+    return x + 16;
+end
+end
+f17(x: integer): integer
+begin
+    return x + 17;
+end
+end
+f18(x: integer): integer
+begin
+    return x + 18;
+end
+end
+f19(x: integer): integer
+begin
+    return x + 19;
+end
+end
+f20(x: integer): integer
+begin
+    return x + 20;
+end
+end
+f21(x: integer): integer
+begin
+    return x + 21;
+end
+end
+f22(x: integer): integer
+begin
+    return x + 22;
+end
+end
+f23(x: integer): integer
+begin
+    return x + 23;
+end
+end
+f24(x: integer): integer
+begin
+    return x + 24;
+end
+end
+f25(x: integer): integer
+begin
+    return x + 25;
+end
+end
+f26(x: integer): integer
+begin
+    return x + 26;
+end
+end
+f27(x: integer): integer
+begin
+    return x + 27;
+end
+end
+f28(x: integer): integer
+begin
+    return x + 28;
+end
+end
+f29(x: integer): integer
+begin
+    return x + 29;
+end
+end
+f30(x: integer): integer
+begin
+    return x + 30;
+end
+end
+f31(x: integer): integer
+begin
+    return x + 31;
+end
+end
+f32(x: integer): integer
+begin
+    return x + 32;
+end
+end
+f33(x: integer): integer
+begin
+    return x + 33;
+end
+end
+f34(x: integer): integer
+begin
+    return x + 34;
+end
+end
+f35(x: integer): integer
+begin
+    return x + 35;
+end
+end
+f36(x: integer): integer
+begin
+    return x + 36;
+end
+end
+f37(x: integer): integer
+begin
+    return x + 37;
+end
+end
+f38(x: integer): integer
+begin
+    return x + 38;
+end
+end
+f39(x: integer): integer
+begin
+    return x + 39;
+end
+end
+f40(x: integer): integer
+begin
+    return x + 40;
+end
+end
+f41(x: integer): integer
+begin
+    return x + 41;
+end
+end
+f42(x: integer): integer
+begin
+    return x + 42;
+end
+end
+f43(x: integer): integer
+begin
+    return x + 43;
+end
+end
+f44(x: integer): integer
+begin
+    return x + 44;
+end
+end
+f45(x: integer): integer
+begin
+    return x + 45;
+end
+end
+f46(x: integer): integer
+begin
+    return x + 46;
+end
+end
+f47(x: integer): integer
+begin
+    return x + 47;
+end
+end
+f48(x: integer): integer
+begin
+    return x + 48;
+end
+end
+f49(x: integer): integer
+begin
+    return x + 49;
+end
+end
+f50(x: integer): integer
+begin
+    return x + 50;
+end
+end
+f51(x: integer): integer
+begin
+    return x + 51;
+end
+end
+f52(x: integer): integer
+begin
+    return x + 52;
+end
+end
+f53(x: integer): integer
+begin
+    return x + 53;
+end
+end
+f54(x: integer): integer
+begin
+    return x + 54;
+end
+end
+f55(x: integer): integer
+begin
+    return x + 55;
+end
+end
+f56(x: integer): integer
+begin
+    return x + 56;
+end
+end
+f57(x: integer): integer
+begin
+    return x + 57;
+end
+end
+f58(x: integer): integer
+begin
+    return x + 58;
+end
+end
+f59(x: integer): integer
+begin
+    return x + 59;
+end
+end
+f60(x: integer): integer
+begin
+    return x + 60;
+end
+end
+f61(x: integer): integer
+begin
+    return x + 61;
+end
+end
+f62(x: integer): integer
+begin
+    return x + 62;
+end
+end
+f63(x: integer): integer
+begin
+    return x + 63;
+end
+end
+f64(x: integer): integer
+begin
+    return x + 64;
+end
+end
+f65(x: integer): integer
+begin
+    return x + 65;
+end
+end
+f66(x: integer): integer
+begin
+    return x + 66;
+end
+end
+f67(x: integer): integer
+begin
+    return x + 67;
+end
+end
+f68(x: integer): integer
+begin
+    return x + 68;
+end
+end
+f69(x: integer): integer
+begin
+    return x + 69;
+end
+end
+f70(x: integer): integer
+begin
+    return x + 70;
+end
+end
+f71(x: integer): integer
+begin
+    return x + 71;
+end
+end
+f72(x: integer): integer
+begin
+    return x + 72;
+end
+end
+f73(x: integer): integer
+begin
+    return x + 73;
+end
+end
+f74(x: integer): integer
+begin
+    return x + 74;
+end
+end
+f75(x: integer): integer
+begin
+    return x + 75;
+end
+end
+f76(x: integer): integer
+begin
+    return x + 76;
+end
+end
+f77(x: integer): integer
+begin
+    return x + 77;
+end
+end
+f78(x: integer): integer
+begin
+    return x + 78;
+end
+end
+f79(x: integer): integer
+begin
+    return x + 79;
+end
+end
+f80(x: integer): integer
+begin
+    return x + 80;
+end
+end
+f81(x: integer): integer
+begin
+    return x + 81;
+end
+end
+f82(x: integer): integer
+begin
+    return x + 82;
+end
+end
+f83(x: integer): integer
+begin
+    return x + 83;
+end
+end
+f84(x: integer): integer
+begin
+    return x + 84;
+end
+end
+f85(x: integer): integer
+begin
+    return x + 85;
+end
+end
+f86(x: integer): integer
+begin
+    return x + 86;
+end
+end
+f87(x: integer): integer
+begin
+    return x + 87;
+end
+end
+f88(x: integer): integer
+begin
+    return x + 88;
+end
+end
+f89(x: integer): integer
+begin
+    return x + 89;
+end
+end
+f90(x: integer): integer
+begin
+    return x + 90;
+end
+end
+f91(x: integer): integer
+begin
+    return x + 91;
+end
+end
+f92(x: integer): integer
+begin
+    return x + 92;
+end
+end
+f93(x: integer): integer
+begin
+    return x + 93;
+end
+end
+f94(x: integer): integer
+begin
+    return x + 94;
+end
+end
+f95(x: integer): integer
+begin
+    return x + 95;
+end
+end
+f96(x: integer): integer
+begin
+    return x + 96;
+end
+end
+f97(x: integer): integer
+begin
+    return x + 97;
+end
+end
+f98(x: integer): integer
+begin
+    return x + 98;
+end
+end
+f99(x: integer): integer
+begin
+    return x + 99;
+end
+end
+f100(x: integer): integer
+begin
+    return x + 100;
+end
+end
+f101(x: integer): integer
+begin
+    return x + 101;
+end
+end
+f102(x: integer): integer
+begin
+    return x + 102;
+end
+end
+f103(x: integer): integer
+begin
+    return x + 103;
+end
+end
+f104(x: integer): integer
+begin
+    return x + 104;
+end
+end
+f105(x: integer): integer
+begin
+    return x + 105;
+end
+end
+f106(x: integer): integer
+begin
+    return x + 106;
+end
+end
+f107(x: integer): integer
+begin
+    return x + 107;
+end
+end
+f108(x: integer): integer
+begin
+    return x + 108;
+end
+end
+f109(x: integer): integer
+begin
+    return x + 109;
+end
+end
+f110(x: integer): integer
+begin
+    return x + 110;
+end
+end
+f111(x: integer): integer
+begin
+    return x + 111;
+end
+end
+f112(x: integer): integer
+begin
+    return x + 112;
+end
+end
+f113(x: integer): integer
+begin
+    return x + 113;
+end
+end
+f114(x: integer): integer
+begin
+    return x + 114;
+end
+end
+f115(x: integer): integer
+begin
+    return x + 115;
+end
+end
+f116(x: integer): integer
+begin
+    return x + 116;
+end
+end
+f117(x: integer): integer
+begin
+    return x + 117;
+end
+end
+f118(x: integer): integer
+begin
+    return x + 118;
+end
+end
+f119(x: integer): integer
+begin
+    return x + 119;
+end
+end
+
+begin
+    total := 0;
+    total := f0(0) + f1(1) + f2(2) + f3(3) + f4(4) + f5(5) + f6(6) + f7(7) + f8(8) + f9(9) + f10(10) + f11(11) + f12(12) + f13(13) + f14(14) + f15(15) + f16(16) + f17(17) + f18(18) + f19(19) + f20(20) + f21(21) + f22(22) + f23(23) + f24(24) + f25(25) + f26(26) + f27(27) + f28(28) + f29(29) + f30(30) + f31(31) + f32(32) + f33(33) + f34(34) + f35(35) + f36(36) + f37(37) + f38(38) + f39(39) + f40(40) + f41(41) + f42(42) + f43(43) + f44(44) + f45(45) + f46(46) + f47(47) + f48(48) + f49(49) + f50(50) + f51(51) + f52(52) + f53(53) + f54(54) + f55(55) + f56(56) + f57(57) + f58(58) + f59(59) + f60(60) + f61(61) + f62(62) + f63(63) + f64(64) + f65(65) + f66(66) + f67(67) + f68(68) + f69(69) + f70(70) + f71(71) + f72(72) + f73(73) + f74(74) + f75(75) + f76(76) + f77(77) + f78(78) + f79(79) + f80(80) + f81(81) + f82(82) + f83(83) + f84(84) + f85(85) + f86(86) + f87(87) + f88(88) + f89(89) + f90(90) + f91(91) + f92(92) + f93(93) + f94(94) + f95(95) + f96(96) + f97(97) + f98(98) + f99(99) + f100(100) + f101(101) + f102(102) + f103(103) + f104(104) + f105(105) + f106(106) + f107(107) + f108(108) + f109(109) + f110(110) + f111(111) + f112(112) + f113(113) + f114(114) + f115(115) + f116(116) + f117(117) + f118(118) + f119(119);
+    print total;
+    total := 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8 + 9 + 10 + 11 + 12 + 13 + 14 + 15 + 16 + 17 + 18 + 19 + 20 + 21 + 22 + 23 + 24 + 25 + 26 + 27 + 28 + 29 + 30 + 31 + 32 + 33 + 34 + 35 + 36 + 37 + 38 + 39 + 40 + 41 + 42 + 43 + 44 + 45 + 46 + 47 + 48 + 49 + 50 + 51 + 52 + 53 + 54 + 55 + 56 + 57 + 58 + 59 + 60 + 61 + 62 + 63 + 64 + 65 + 66 + 67 + 68 + 69 + 70 + 71 + 72 + 73 + 74 + 75 + 76 + 77 + 78 + 79 + 80 + 81 + 82 + 83 + 84 + 85 + 86 + 87 + 88 + 89 + 90 + 91 + 92 + 93 + 94 + 95 + 96 + 97 + 98 + 99 + 100 + 101 + 102 + 103 + 104 + 105 + 106 + 107 + 108 + 109 + 110 + 111 + 112 + 113 + 114 + 115 + 116 + 117 + 118 + 119 + 120 + 121 + 122 + 123 + 124 + 125 + 126 + 127 + 128 + 129 + 130 + 131 + 132 + 133 + 134 + 135 + 136 + 137 + 138 + 139 + 140 + 141 + 142 + 143 + 144 + 145 + 146 + 147 + 148 + 149 + 150 + 151 + 152 + 153 + 154 + 155 + 156 + 157 + 158 + 159 + 160 + 161 + 162 + 163 + 164 + 165 + 166 + 167 + 168 + 169 + 170 + 171 + 172 + 173 + 174 + 175 + 176 + 177 + 178 + 179 + 180 + 181 + 182 + 183 + 184 + 185 + 186 + 187 + 188 + 189 + 190 + 191 + 192 + 193 + 194 + 195 + 196 + 197 + 198 + 199 + 200;
+    print total;
+end
+end
@@ -0,0 +1,34 @@
+//&S-
+//&T-
+//&D-
+
+peephole;
+
+var g: integer;
+
+id(x: integer): integer
+begin
+	return x;
+end
+end
+
+begin
+
+var a, b: integer;
+
+// A value is stored and read back right away.
+g := 5;
+print g;
+g := g * 2 + g;
+print g;
+a := 7;
+b := a + g;
+print b;
+
+// Fifteen live results leave too few registers for the rest of the
+// expression, so the last of them is pushed to the stack.
+print id(1) + (id(2) + (id(3) + (id(4) + (id(5) + (id(6) + (id(7) + (id(8) + (id(9) + (id(10) + (id(11) + (id(12) + (id(13) + (id(14) + (id(15) + a))))))))))))));
+print id(1) * (id(2) - (id(3) + (id(4) - (id(5) + (id(6) - (id(7) + (id(8) - (id(9) + (id(10) - (id(11) + (id(12) - (id(13) + (id(14) - (id(15) + (a * b)))))))))))))));
+
+end
+end
@@ -0,0 +1,262 @@
+//&S-
+//&T-
+//&D-
+
+frame;
+
+// buf does not fit in a 12-bit immediate, so neither does the frame (at -O0;
+// -O1 drops it, since it is never used)
+sum(n: integer): integer
+begin
+    var buf: array 1000 of integer;
+    var x: integer;
+    x := n * 2;
+    if n > 0 then
+    begin
+        return sum(n - 1) + x;
+    end
+    else
+    begin
+        return x;
+    end
+    end if
+end
+end
+
+small(a, b: integer): integer
+begin
+    var c: integer;
+    c := a - b;
+    return c * c;
+end
+end
+
+// the scalars alone reach past a 12-bit offset from the frame pointer
+wide(n: integer): integer
+begin
+    var v0, v1, v2, v3, v4, v5, v6, v7, v8, v9: integer;
+    var v10, v11, v12, v13, v14, v15, v16, v17, v18, v19: integer;
+    var v20, v21, v22, v23, v24, v25, v26, v27, v28, v29: integer;
+    var v30, v31, v32, v33, v34, v35, v36, v37, v38, v39: integer;
+    var v40, v41, v42, v43, v44, v45, v46, v47, v48, v49: integer;
+    var v50, v51, v52, v53, v54, v55, v56, v57, v58, v59: integer;
+    var v60, v61, v62, v63, v64, v65, v66, v67, v68, v69: integer;
+    var v70, v71, v72, v73, v74, v75, v76, v77, v78, v79: integer;
+    var v80, v81, v82, v83, v84, v85, v86, v87, v88, v89: integer;
+    var v90, v91, v92, v93, v94, v95, v96, v97, v98, v99: integer;
+    var v100, v101, v102, v103, v104, v105, v106, v107, v108, v109: integer;
+    var v110, v111, v112, v113, v114, v115, v116, v117, v118, v119: integer;
+    var v120, v121, v122, v123, v124, v125, v126, v127, v128, v129: integer;
+    var v130, v131, v132, v133, v134, v135, v136, v137, v138, v139: integer;
+    var v140, v141, v142, v143, v144, v145, v146, v147, v148, v149: integer;
+    var v150, v151, v152, v153, v154, v155, v156, v157, v158, v159: integer;
+    var v160, v161, v162, v163, v164, v165, v166, v167, v168, v169: integer;
+    var v170, v171, v172, v173, v174, v175, v176, v177, v178, v179: integer;
+    var v180, v181, v182, v183, v184, v185, v186, v187, v188, v189: integer;
+    var v190, v191, v192, v193, v194, v195, v196, v197, v198, v199: integer;
+    var v200, v201, v202, v203, v204, v205, v206, v207, v208, v209: integer;
+    var v210, v211, v212, v213, v214, v215, v216, v217, v218, v219: integer;
+    var v220, v221, v222, v223, v224, v225, v226, v227, v228, v229: integer;
+    var v230, v231, v232, v233, v234, v235, v236, v237, v238, v239: integer;
+    var v240, v241, v242, v243, v244, v245, v246, v247, v248, v249: integer;
+    var v250, v251, v252, v253, v254, v255, v256, v257, v258, v259: integer;
+    var v260, v261, v262, v263, v264, v265, v266, v267, v268, v269: integer;
+    var v270, v271, v272, v273, v274, v275, v276, v277, v278, v279: integer;
+    var v280, v281, v282, v283, v284, v285, v286, v287, v288, v289: integer;
+    var v290, v291, v292, v293, v294, v295, v296, v297, v298, v299: integer;
+    var v300, v301, v302, v303, v304, v305, v306, v307, v308, v309: integer;
+    var v310, v311, v312, v313, v314, v315, v316, v317, v318, v319: integer;
+    var v320, v321, v322, v323, v324, v325, v326, v327, v328, v329: integer;
+    var v330, v331, v332, v333, v334, v335, v336, v337, v338, v339: integer;
+    var v340, v341, v342, v343, v344, v345, v346, v347, v348, v349: integer;
+    var v350, v351, v352, v353, v354, v355, v356, v357, v358, v359: integer;
+    var v360, v361, v362, v363, v364, v365, v366, v367, v368, v369: integer;
+    var v370, v371, v372, v373, v374, v375, v376, v377, v378, v379: integer;
+    var v380, v381, v382, v383, v384, v385, v386, v387, v388, v389: integer;
+    var v390, v391, v392, v393, v394, v395, v396, v397, v398, v399: integer;
+    var v400, v401, v402, v403, v404, v405, v406, v407, v408, v409: integer;
+    var v410, v411, v412, v413, v414, v415, v416, v417, v418, v419: integer;
+    var v420, v421, v422, v423, v424, v425, v426, v427, v428, v429: integer;
+    var v430, v431, v432, v433, v434, v435, v436, v437, v438, v439: integer;
+    var v440, v441, v442, v443, v444, v445, v446, v447, v448, v449: integer;
+    var v450, v451, v452, v453, v454, v455, v456, v457, v458, v459: integer;
+    var v460, v461, v462, v463, v464, v465, v466, v467, v468, v469: integer;
+    var v470, v471, v472, v473, v474, v475, v476, v477, v478, v479: integer;
+    var v480, v481, v482, v483, v484, v485, v486, v487, v488, v489: integer;
+    var v490, v491, v492, v493, v494, v495, v496, v497, v498, v499: integer;
+    var v500, v501, v502, v503, v504, v505, v506, v507, v508, v509: integer;
+    var v510, v511, v512, v513, v514, v515, v516, v517, v518, v519: integer;
+    var v520, v521, v522, v523, v524, v525, v526, v527, v528, v529: integer;
+    var v530, v531, v532, v533, v534, v535, v536, v537, v538, v539: integer;
+    var v540, v541, v542, v543, v544, v545, v546, v547, v548, v549: integer;
+    var v550, v551, v552, v553, v554, v555, v556, v557, v558, v559: integer;
+    var v560, v561, v562, v563, v564, v565, v566, v567, v568, v569: integer;
+    var v570, v571, v572, v573, v574, v575, v576, v577, v578, v579: integer;
+    var v580, v581, v582, v583, v584, v585, v586, v587, v588, v589: integer;
+    var v590, v591, v592, v593, v594, v595, v596, v597, v598, v599: integer;
+    v0 := n;
+    v1 := v0 + 1; v2 := v1 + 1; v3 := v2 + 1; v4 := v3 + 1;
+    v5 := v4 + 1; v6 := v5 + 1; v7 := v6 + 1; v8 := v7 + 1;
+    v9 := v8 + 1; v10 := v9 + 1; v11 := v10 + 1; v12 := v11 + 1;
+    v13 := v12 + 1; v14 := v13 + 1; v15 := v14 + 1; v16 := v15 + 1;
+    v17 := v16 + 1; v18 := v17 + 1; v19 := v18 + 1; v20 := v19 + 1;
+    v21 := v20 + 1; v22 := v21 + 1; v23 := v22 + 1; v24 := v23 + 1;
+    v25 := v24 + 1; v26 := v25 + 1; v27 := v26 + 1; v28 := v27 + 1;
+    v29 := v28 + 1; v30 := v29 + 1; v31 := v30 + 1; v32 := v31 + 1;
+    v33 := v32 + 1; v34 := v33 + 1; v35 := v34 + 1; v36 := v35 + 1;
+    v37 := v36 + 1; v38 := v37 + 1; v39 := v38 + 1; v40 := v39 + 1;
+    v41 := v40 + 1; v42 := v41 + 1; v43 := v42 + 1; v44 := v43 + 1;
+    v45 := v44 + 1; v46 := v45 + 1; v47 := v46 + 1; v48 := v47 + 1;
+    v49 := v48 + 1; v50 := v49 + 1; v51 := v50 + 1; v52 := v51 + 1;
+    v53 := v52 + 1; v54 := v53 + 1; v55 := v54 + 1; v56 := v55 + 1;
+    v57 := v56 + 1; v58 := v57 + 1; v59 := v58 + 1; v60 := v59 + 1;
+    v61 := v60 + 1; v62 := v61 + 1; v63 := v62 + 1; v64 := v63 + 1;
+    v65 := v64 + 1; v66 := v65 + 1; v67 := v66 + 1; v68 := v67 + 1;
+    v69 := v68 + 1; v70 := v69 + 1; v71 := v70 + 1; v72 := v71 + 1;
+    v73 := v72 + 1; v74 := v73 + 1; v75 := v74 + 1; v76 := v75 + 1;
+    v77 := v76 + 1; v78 := v77 + 1; v79 := v78 + 1; v80 := v79 + 1;
+    v81 := v80 + 1; v82 := v81 + 1; v83 := v82 + 1; v84 := v83 + 1;
+    v85 := v84 + 1; v86 := v85 + 1; v87 := v86 + 1; v88 := v87 + 1;
+    v89 := v88 + 1; v90 := v89 + 1; v91 := v90 + 1; v92 := v91 + 1;
+    v93 := v92 + 1; v94 := v93 + 1; v95 := v94 + 1; v96 := v95 + 1;
+    v97 := v96 + 1; v98 := v97 + 1; v99 := v98 + 1; v100 := v99 + 1;
+    v101 := v100 + 1; v102 := v101 + 1; v103 := v102 + 1; v104 := v103 + 1;
+    v105 := v104 + 1; v106 := v105 + 1; v107 := v106 + 1; v108 := v107 + 1;
+    v109 := v108 + 1; v110 := v109 + 1; v111 := v110 + 1; v112 := v111 + 1;
+    v113 := v112 + 1; v114 := v113 + 1; v115 := v114 + 1; v116 := v115 + 1;
+    v117 := v116 + 1; v118 := v117 + 1; v119 := v118 + 1; v120 := v119 + 1;
+    v121 := v120 + 1; v122 := v121 + 1; v123 := v122 + 1; v124 := v123 + 1;
+    v125 := v124 + 1; v126 := v125 + 1; v127 := v126 + 1; v128 := v127 + 1;
+    v129 := v128 + 1; v130 := v129 + 1; v131 := v130 + 1; v132 := v131 + 1;
+    v133 := v132 + 1; v134 := v133 + 1; v135 := v134 + 1; v136 := v135 + 1;
+    v137 := v136 + 1; v138 := v137 + 1; v139 := v138 + 1; v140 := v139 + 1;
+    v141 := v140 + 1; v142 := v141 + 1; v143 := v142 + 1; v144 := v143 + 1;
+    v145 := v144 + 1; v146 := v145 + 1; v147 := v146 + 1; v148 := v147 + 1;
+    v149 := v148 + 1; v150 := v149 + 1; v151 := v150 + 1; v152 := v151 + 1;
+    v153 := v152 + 1; v154 := v153 + 1; v155 := v154 + 1; v156 := v155 + 1;
+    v157 := v156 + 1; v158 := v157 + 1; v159 := v158 + 1; v160 := v159 + 1;
+    v161 := v160 + 1; v162 := v161 + 1; v163 := v162 + 1; v164 := v163 + 1;
+    v165 := v164 + 1; v166 := v165 + 1; v167 := v166 + 1; v168 := v167 + 1;
+    v169 := v168 + 1; v170 := v169 + 1; v171 := v170 + 1; v172 := v171 + 1;
+    v173 := v172 + 1; v174 := v173 + 1; v175 := v174 + 1; v176 := v175 + 1;
+    v177 := v176 + 1; v178 := v177 + 1; v179 := v178 + 1; v180 := v179 + 1;
+    v181 := v180 + 1; v182 := v181 + 1; v183 := v182 + 1; v184 := v183 + 1;
+    v185 := v184 + 1; v186 := v185 + 1; v187 := v186 + 1; v188 := v187 + 1;
+    v189 := v188 + 1; v190 := v189 + 1; v191 := v190 + 1; v192 := v191 + 1;
+    v193 := v192 + 1; v194 := v193 + 1; v195 := v194 + 1; v196 := v195 + 1;
+    v197 := v196 + 1; v198 := v197 + 1; v199 := v198 + 1; v200 := v199 + 1;
+    v201 := v200 + 1; v202 := v201 + 1; v203 := v202 + 1; v204 := v203 + 1;
+    v205 := v204 + 1; v206 := v205 + 1; v207 := v206 + 1; v208 := v207 + 1;
+    v209 := v208 + 1; v210 := v209 + 1; v211 := v210 + 1; v212 := v211 + 1;
+    v213 := v212 + 1; v214 := v213 + 1; v215 := v214 + 1; v216 := v215 + 1;
+    v217 := v216 + 1; v218 := v217 + 1; v219 := v218 + 1; v220 := v219 + 1;
+    v221 := v220 + 1; v222 := v221 + 1; v223 := v222 + 1; v224 := v223 + 1;
+    v225 := v224 + 1; v226 := v225 + 1; v227 := v226 + 1; v228 := v227 + 1;
+    v229 := v228 + 1; v230 := v229 + 1; v231 := v230 + 1; v232 := v231 + 1;
+    v233 := v232 + 1; v234 := v233 + 1; v235 := v234 + 1; v236 := v235 + 1;
+    v237 := v236 + 1; v238 := v237 + 1; v239 := v238 + 1; v240 := v239 + 1;
+    v241 := v240 + 1; v242 := v241 + 1; v243 := v242 + 1; v244 := v243 + 1;
+    v245 := v244 + 1; v246 := v245 + 1; v247 := v246 + 1; v248 := v247 + 1;
+    v249 := v248 + 1; v250 := v249 + 1; v251 := v250 + 1; v252 := v251 + 1;
+    v253 := v252 + 1; v254 := v253 + 1; v255 := v254 + 1; v256 := v255 + 1;
+    v257 := v256 + 1; v258 := v257 + 1; v259 := v258 + 1; v260 := v259 + 1;
+    v261 := v260 + 1; v262 := v261 + 1; v263 := v262 + 1; v264 := v263 + 1;
+    v265 := v264 + 1; v266 := v265 + 1; v267 := v266 + 1; v268 := v267 + 1;
+    v269 := v268 + 1; v270 := v269 + 1; v271 := v270 + 1; v272 := v271 + 1;
+    v273 := v272 + 1; v274 := v273 + 1; v275 := v274 + 1; v276 := v275 + 1;
+    v277 := v276 + 1; v278 := v277 + 1; v279 := v278 + 1; v280 := v279 + 1;
+    v281 := v280 + 1; v282 := v281 + 1; v283 := v282 + 1; v284 := v283 + 1;
+    v285 := v284 + 1; v286 := v285 + 1; v287 := v286 + 1; v288 := v287 + 1;
+    v289 := v288 + 1; v290 := v289 + 1; v291 := v290 + 1; v292 := v291 + 1;
+    v293 := v292 + 1; v294 := v293 + 1; v295 := v294 + 1; v296 := v295 + 1;
+    v297 := v296 + 1; v298 := v297 + 1; v299 := v298 + 1; v300 := v299 + 1;
+    v301 := v300 + 1; v302 := v301 + 1; v303 := v302 + 1; v304 := v303 + 1;
+    v305 := v304 + 1; v306 := v305 + 1; v307 := v306 + 1; v308 := v307 + 1;
+    v309 := v308 + 1; v310 := v309 + 1; v311 := v310 + 1; v312 := v311 + 1;
+    v313 := v312 + 1; v314 := v313 + 1; v315 := v314 + 1; v316 := v315 + 1;
+    v317 := v316 + 1; v318 := v317 + 1; v319 := v318 + 1; v320 := v319 + 1;
+    v321 := v320 + 1; v322 := v321 + 1; v323 := v322 + 1; v324 := v323 + 1;
+    v325 := v324 + 1; v326 := v325 + 1; v327 := v326 + 1; v328 := v327 + 1;
+    v329 := v328 + 1; v330 := v329 + 1; v331 := v330 + 1; v332 := v331 + 1;
+    v333 := v332 + 1; v334 := v333 + 1; v335 := v334 + 1; v336 := v335 + 1;
+    v337 := v336 + 1; v338 := v337 + 1; v339 := v338 + 1; v340 := v339 + 1;
+    v341 := v340 + 1; v342 := v341 + 1; v343 := v342 + 1; v344 := v343 + 1;
+    v345 := v344 + 1; v346 := v345 + 1; v347 := v346 + 1; v348 := v347 + 1;
+    v349 := v348 + 1; v350 := v349 + 1; v351 := v350 + 1; v352 := v351 + 1;
+    v353 := v352 + 1; v354 := v353 + 1; v355 := v354 + 1; v356 := v355 + 1;
+    v357 := v356 + 1; v358 := v357 + 1; v359 := v358 + 1; v360 := v359 + 1;
+    v361 := v360 + 1; v362 := v361 + 1; v363 := v362 + 1; v364 := v363 + 1;
+    v365 := v364 + 1; v366 := v365 + 1; v367 := v366 + 1; v368 := v367 + 1;
+    v369 := v368 + 1; v370 := v369 + 1; v371 := v370 + 1; v372 := v371 + 1;
+    v373 := v372 + 1; v374 := v373 + 1; v375 := v374 + 1; v376 := v375 + 1;
+    v377 := v376 + 1; v378 := v377 + 1; v379 := v378 + 1; v380 := v379 + 1;
+    v381 := v380 + 1; v382 := v381 + 1; v383 := v382 + 1; v384 := v383 + 1;
+    v385 := v384 + 1; v386 := v385 + 1; v387 := v386 + 1; v388 := v387 + 1;
+    v389 := v388 + 1; v390 := v389 + 1; v391 := v390 + 1; v392 := v391 + 1;
+    v393 := v392 + 1; v394 := v393 + 1; v395 := v394 + 1; v396 := v395 + 1;
+    v397 := v396 + 1; v398 := v397 + 1; v399 := v398 + 1; v400 := v399 + 1;
+    v401 := v400 + 1; v402 := v401 + 1; v403 := v402 + 1; v404 := v403 + 1;
+    v405 := v404 + 1; v406 := v405 + 1; v407 := v406 + 1; v408 := v407 + 1;
+    v409 := v408 + 1; v410 := v409 + 1; v411 := v410 + 1; v412 := v411 + 1;
+    v413 := v412 + 1; v414 := v413 + 1; v415 := v414 + 1; v416 := v415 + 1;
+    v417 := v416 + 1; v418 := v417 + 1; v419 := v418 + 1; v420 := v419 + 1;
+    v421 := v420 + 1; v422 := v421 + 1; v423 := v422 + 1; v424 := v423 + 1;
+    v425 := v424 + 1; v426 := v425 + 1; v427 := v426 + 1; v428 := v427 + 1;
+    v429 := v428 + 1; v430 := v429 + 1; v431 := v430 + 1; v432 := v431 + 1;
+    v433 := v432 + 1; v434 := v433 + 1; v435 := v434 + 1; v436 := v435 + 1;
+    v437 := v436 + 1; v438 := v437 + 1; v439 := v438 + 1; v440 := v439 + 1;
+    v441 := v440 + 1; v442 := v441 + 1; v443 := v442 + 1; v444 := v443 + 1;
+    v445 := v444 + 1; v446 := v445 + 1; v447 := v446 + 1; v448 := v447 + 1;
+    v449 := v448 + 1; v450 := v449 + 1; v451 := v450 + 1; v452 := v451 + 1;
+    v453 := v452 + 1; v454 := v453 + 1; v455 := v454 + 1; v456 := v455 + 1;
+    v457 := v456 + 1; v458 := v457 + 1; v459 := v458 + 1; v460 := v459 + 1;
+    v461 := v460 + 1; v462 := v461 + 1; v463 := v462 + 1; v464 := v463 + 1;
+    v465 := v464 + 1; v466 := v465 + 1; v467 := v466 + 1; v468 := v467 + 1;
+    v469 := v468 + 1; v470 := v469 + 1; v471 := v470 + 1; v472 := v471 + 1;
+    v473 := v472 + 1; v474 := v473 + 1; v475 := v474 + 1; v476 := v475 + 1;
+    v477 := v476 + 1; v478 := v477 + 1; v479 := v478 + 1; v480 := v479 + 1;
+    v481 := v480 + 1; v482 := v481 + 1; v483 := v482 + 1; v484 := v483 + 1;
+    v485 := v484 + 1; v486 := v485 + 1; v487 := v486 + 1; v488 := v487 + 1;
+    v489 := v488 + 1; v490 := v489 + 1; v491 := v490 + 1; v492 := v491 + 1;
+    v493 := v492 + 1; v494 := v493 + 1; v495 := v494 + 1; v496 := v495 + 1;
+    v497 := v496 + 1; v498 := v497 + 1; v499 := v498 + 1; v500 := v499 + 1;
+    v501 := v500 + 1; v502 := v501 + 1; v503 := v502 + 1; v504 := v503 + 1;
+    v505 := v504 + 1; v506 := v505 + 1; v507 := v506 + 1; v508 := v507 + 1;
+    v509 := v508 + 1; v510 := v509 + 1; v511 := v510 + 1; v512 := v511 + 1;
+    v513 := v512 + 1; v514 := v513 + 1; v515 := v514 + 1; v516 := v515 + 1;
+    v517 := v516 + 1; v518 := v517 + 1; v519 := v518 + 1; v520 := v519 + 1;
+    v521 := v520 + 1; v522 := v521 + 1; v523 := v522 + 1; v524 := v523 + 1;
+    v525 := v524 + 1; v526 := v525 + 1; v527 := v526 + 1; v528 := v527 + 1;
+    v529 := v528 + 1; v530 := v529 + 1; v531 := v530 + 1; v532 := v531 + 1;
+    v533 := v532 + 1; v534 := v533 + 1; v535 := v534 + 1; v536 := v535 + 1;
+    v537 := v536 + 1; v538 := v537 + 1; v539 := v538 + 1; v540 := v539 + 1;
+    v541 := v540 + 1; v542 := v541 + 1; v543 := v542 + 1; v544 := v543 + 1;
+    v545 := v544 + 1; v546 := v545 + 1; v547 := v546 + 1; v548 := v547 + 1;
+    v549 := v548 + 1; v550 := v549 + 1; v551 := v550 + 1; v552 := v551 + 1;
+    v553 := v552 + 1; v554 := v553 + 1; v555 := v554 + 1; v556 := v555 + 1;
+    v557 := v556 + 1; v558 := v557 + 1; v559 := v558 + 1; v560 := v559 + 1;
+    v561 := v560 + 1; v562 := v561 + 1; v563 := v562 + 1; v564 := v563 + 1;
+    v565 := v564 + 1; v566 := v565 + 1; v567 := v566 + 1; v568 := v567 + 1;
+    v569 := v568 + 1; v570 := v569 + 1; v571 := v570 + 1; v572 := v571 + 1;
+    v573 := v572 + 1; v574 := v573 + 1; v575 := v574 + 1; v576 := v575 + 1;
+    v577 := v576 + 1; v578 := v577 + 1; v579 := v578 + 1; v580 := v579 + 1;
+    v581 := v580 + 1; v582 := v581 + 1; v583 := v582 + 1; v584 := v583 + 1;
+    v585 := v584 + 1; v586 := v585 + 1; v587 := v586 + 1; v588 := v587 + 1;
+    v589 := v588 + 1; v590 := v589 + 1; v591 := v590 + 1; v592 := v591 + 1;
+    v593 := v592 + 1; v594 := v593 + 1; v595 := v594 + 1; v596 := v595 + 1;
+    v597 := v596 + 1; v598 := v597 + 1; v599 := v598 + 1;
+    return v0 + v300 + v599;
+end
+end
+
+begin
+    var grid: array 20 of array 30 of integer;
+    var a, b: integer;
+    a := 3;
+    b := sum(a);
+    print b;
+    print small(b, a);
+    print sum(small(2, 5));
+    print wide(b);
+end
+end
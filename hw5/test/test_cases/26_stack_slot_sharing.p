@@ -0,0 +1,65 @@
+//&S-
+//&T-
+//&D-
+
+slots;
+
+// the branches and the loops share their slots, while keep outlives them
+depth(n: integer): integer
+begin
+    var keep: integer;
+    keep := n;
+    if n > 0 then
+    begin
+        var buf: array 500 of integer;
+        var a: integer;
+        a := depth(n - 1);
+        keep := keep + a;
+    end
+    else
+    begin
+        var other: array 500 of integer;
+        var b: integer;
+        b := 100;
+        keep := keep + b;
+    end
+    end if
+    for i := 1 to 4 do
+    begin
+        var c: integer;
+        c := i * 2;
+        keep := keep + c;
+    end
+    end do
+    for j := 1 to 3 do
+    begin
+        var d: integer;
+        d := j;
+        keep := keep - d;
+    end
+    end do
+    return keep;
+end
+end
+
+begin
+    var x: integer;
+    x := 7;
+    begin
+        var y: integer;
+        y := x * 3;
+        begin
+            var z: integer;
+            z := y + 1;
+            print z;
+        end
+        print y;
+    end
+    begin
+        var w: integer;
+        w := 40;
+        print w + x;
+    end
+    print depth(5);
+end
+end
@@ -0,0 +1,65 @@
+//&S-
+//&T-
+//&D-
+
+folding;
+
+var limit: 10;
+var big: 2147483647;
+var yes: true;
+var counter: integer;
+
+// prints its argument, so a call must not be folded away
+trace(n: integer): integer
+begin
+    counter := counter + 1;
+    print n;
+    return n;
+end
+end
+
+begin
+    var k: 3;
+    var x: integer;
+    counter := 0;
+    x := 5;
+
+    // constants and constant symbols
+    print limit * 4 + 1;
+    print (limit - k) * (limit + k) / 7 mod 5;
+    print big + 1;
+    print -(-limit);
+    print -2147483647 - 1 - 1;
+
+    // identities around a variable
+    print x + 0 + (0 + x) - 0;
+    print x * 1 * (1 * x) / 1;
+    print x * 0 + x mod 1;
+    print - - x;
+
+    // a call is kept even when its value is not needed
+    print trace(7) * 0;
+    print 0 * trace(8);
+    print counter;
+
+    if yes and (limit > k) then
+    begin
+        print 1;
+    end
+    else
+    begin
+        print 0;
+    end
+    end if
+    if not not (x > limit) or false then
+    begin
+        print 2;
+    end
+    end if
+    if (x < limit) and true then
+    begin
+        print 3;
+    end
+    end if
+end
+end
@@ -0,0 +1,117 @@
+//&S-
+//&T-
+//&D-
+
+deadcode;
+
+var debug: false;
+var g: integer;
+
+// prints its argument, so a call must stay even if its value is dead
+trace(n: integer): integer
+begin
+    print n;
+    return n;
+end
+end
+
+// the first stores of a and b are overwritten before they are read
+overwrite(n: integer): integer
+begin
+    var a, b, unused: integer;
+    var limit: 100;
+    a := n * 3;
+    b := trace(n);
+    a := n + 1;
+    b := 2;
+    unused := a * b;
+    if debug then
+    begin
+        print unused;
+    end
+    end if
+    return a * b;
+    print 999;
+    a := 0;
+end
+end
+
+// only returns from the loop, so nothing after it runs
+search(n: integer): integer
+begin
+    var i: integer;
+    i := 0;
+    while true do
+    begin
+        if i * i >= n then
+        begin
+            return i;
+        end
+        end if
+        i := i + 1;
+    end
+    end do
+    print 888;
+    return 0 - 1;
+end
+end
+
+// a store in a loop is live if the next iteration reads it
+loop(n: integer): integer
+begin
+    var sum, last, scratch: integer;
+    sum := 0;
+    last := 0;
+    for i := 0 to 5 do
+    begin
+        scratch := i * 7;
+        sum := sum + last;
+        last := i;
+    end
+    end do
+    return sum + n;
+end
+end
+
+// both branches return, so the statement after the if is dead
+sign(n: integer): integer
+begin
+    if n < 0 then
+    begin
+        return 0 - 1;
+    end
+    else
+    begin
+        return 1;
+    end
+    end if
+    return 0;
+end
+end
+
+begin
+    var x, y: integer;
+    x := 5;
+    y := x * 2;
+    while false do
+    begin
+        print 777;
+    end
+    end do
+    if debug or false then
+    begin
+        print 666;
+    end
+    else
+    begin
+        print overwrite(x);
+    end
+    end if
+    print search(50);
+    print loop(100);
+    print sign(0 - 4);
+    g := trace(42);
+    y := trace(7);
+    print g;
+end
+end
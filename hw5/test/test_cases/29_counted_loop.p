@@ -0,0 +1,55 @@
+//&S-
+//&T-
+//&D-
+
+counted;
+
+square(n: integer): integer
+begin
+    return n * n;
+end
+end
+
+// no calls in the bodies, so the bounds stay in registers
+products(): integer
+begin
+    var s: integer;
+    s := 0;
+    for i := 0 to 10 do
+    begin
+        for j := 0 to 10 do
+        begin
+            s := s + i * j;
+        end
+        end do
+    end
+    end do
+    return s;
+end
+end
+
+begin
+    var total: integer;
+    total := 0;
+    // a single iteration needs no branch at all
+    for k := 5 to 6 do
+    begin
+        print k;
+    end
+    end do
+    // calls in the body, so the bound is loaded on each iteration
+    for i := 1 to 4 do
+    begin
+        print square(i);
+    end
+    end do
+    // a bound too large for an immediate
+    for m := 0 to 5000 do
+    begin
+        total := total + 2;
+    end
+    end do
+    print total;
+    print products();
+end
+end
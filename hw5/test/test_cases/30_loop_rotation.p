@@ -0,0 +1,55 @@
+//&S-
+//&T-
+//&D-
+
+rotation;
+
+var calls: integer;
+
+// counts its calls, so the condition must be tested exactly once per pass
+below(n: integer; limit: integer): boolean
+begin
+    calls := calls + 1;
+    return n < limit;
+end
+end
+
+begin
+    var i: integer;
+    var done: boolean;
+    i := 0;
+    while i < 5 do
+    begin
+        i := i + 1;
+    end
+    end do
+    print i;
+
+    // never entered
+    while i < 5 do
+    begin
+        i := 100;
+    end
+    end do
+    print i;
+
+    // a condition that is not a comparison
+    done := false;
+    while not done do
+    begin
+        i := i * 2;
+        done := i > 40;
+    end
+    end do
+    print i;
+
+    calls := 0;
+    i := 0;
+    while below(i, 3) do
+    begin
+        i := i + 1;
+    end
+    end do
+    print calls;
+end
+end
@@ -0,0 +1,72 @@
+//&S-
+//&T-
+//&D-
+
+invariants;
+
+var scale: integer;
+var counter: integer;
+
+// writes no global, so the loops that call it keep their invariants
+twice(n: integer): integer
+begin
+    return n * 2;
+end
+end
+
+// writes a global, so a loop that calls it reloads it
+bump(): integer
+begin
+    counter := counter + 1;
+    return counter;
+end
+end
+
+weigh(base: integer; step: integer): integer
+begin
+    var total: integer;
+    total := 0;
+    for i := 0 to 10 do
+    begin
+        // scale * step is invariant in both loops, (base + i) * step only in
+        // the inner one
+        for j := 0 to 10 do
+        begin
+            total := total + scale * step + (base + i) * step + twice(j);
+        end
+        end do
+    end
+    end do
+    return total;
+end
+end
+
+begin
+    var k: integer;
+    var sum: integer;
+    scale := 3;
+    counter := 0;
+    print weigh(5, 2);
+
+    // counter changes on each iteration through the call
+    sum := 0;
+    k := 0;
+    while k < 4 do
+    begin
+        sum := sum + counter * 10 + bump();
+        k := k + 1;
+    end
+    end do
+    print sum;
+
+    // scale changes in the loop itself
+    k := 0;
+    while k < 3 do
+    begin
+        scale := scale + 1;
+        print scale * scale;
+        k := k + 1;
+    end
+    end do
+end
+end
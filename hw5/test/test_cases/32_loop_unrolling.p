@@ -0,0 +1,52 @@
+//&S-
+//&T-
+//&D-
+
+unrolling;
+
+var hits: integer;
+
+touch(n: integer): integer
+begin
+    hits := hits + 1;
+    return n;
+end
+end
+
+begin
+    var sum: integer;
+    var weighted: integer;
+    hits := 0;
+
+    // short enough to unroll fully
+    for i := 2 to 6 do
+    begin
+        print i;
+    end
+    end do
+
+    // unrolled by as many copies as the budget allows (three once touch is
+    // inlined), with the iterations left over run first
+    sum := 0;
+    for i := 0 to 11 do
+    begin
+        sum := sum + touch(i);
+    end
+    end do
+    print sum;
+    print hits;
+
+    // a long loop, and one nested in it
+    weighted := 0;
+    for i := 0 to 100 do
+    begin
+        for j := 0 to 3 do
+        begin
+            weighted := weighted + i * j;
+        end
+        end do
+    end
+    end do
+    print weighted;
+end
+end
@@ -0,0 +1,95 @@
+//&S-
+//&T-
+//&D-
+
+inlining;
+
+var counter: integer;
+
+sum(a, b: integer): integer
+begin
+    var total: integer;
+    total := a + b;
+    return total;
+end
+end
+
+max(a, b: integer): integer
+begin
+    if a > b then
+    begin
+        return a;
+    end
+    else
+    begin
+        return b;
+    end
+    end if
+end
+end
+
+bump(): integer
+begin
+    counter := counter + 1;
+    return counter;
+end
+end
+
+show(n: integer)
+begin
+    var scale: 10;
+    print n * scale;
+end
+end
+
+triangle(n: integer): integer
+begin
+    var total: integer;
+    total := 0;
+    for i := 1 to 5 do
+    begin
+        total := total + i * n;
+    end
+    end do
+    return total;
+end
+end
+
+fact(n: integer): integer
+begin
+    if n <= 1 then
+    begin
+        return 1;
+    end
+    end if
+    return n * fact(n - 1);
+end
+end
+
+begin
+    var x: integer;
+    counter := 0;
+
+    // an invocation in the arguments of another
+    x := sum(sum(1, 2), 3);
+    print x;
+    // a result from either branch of an `if` at the end
+    print max(x, 4) + max(2, x * 2);
+    show(x);
+
+    // the global is read before `bump` writes it, so it stays a call
+    print counter + bump();
+    print bump() + counter;
+
+    print triangle(2);
+    print fact(5);
+
+    x := 0;
+    while x < 3 do
+    begin
+        x := sum(x, 1);
+        show(x);
+    end
+    end do
+end
+end
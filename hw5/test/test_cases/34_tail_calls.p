@@ -0,0 +1,66 @@
+//&S-
+//&T-
+//&D-
+
+tailcalls;
+
+var total: integer;
+
+sumto(n, acc: integer): integer
+begin
+    if n = 0 then
+    begin
+        return acc;
+    end
+    end if
+    return sumto(n - 1, acc + n);
+end
+end
+
+gcd(a, b: integer): integer
+begin
+    if b = 0 then
+    begin
+        return a;
+    end
+    end if
+    return gcd(b, a mod b);
+end
+end
+
+twice(n: integer): integer
+begin
+    return sumto(n, 0) * 2;
+end
+end
+
+viasum(n: integer): integer
+begin
+    var k: integer;
+    k := n + 1;
+    return sumto(k, 0);
+end
+end
+
+countdown(n: integer)
+begin
+    if n > 0 then
+    begin
+        total := total + n;
+        countdown(n - 1);
+    end
+    end if
+end
+end
+
+begin
+    print sumto(10, 0);
+    print sumto(100000, 0);
+    print gcd(1071, 462);
+    print twice(4);
+    print viasum(9);
+    total := 0;
+    countdown(50000);
+    print total;
+end
+end